@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_BENCHMARKS_FIXTURES_H
+#define WALKING_CONTROLLERS_BENCHMARKS_FIXTURES_H
+
+// std
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// YARP
+#include <yarp/conf/environment.h>
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/ResourceFinder.h>
+
+// iDynTree
+#include <iDynTree/ModelLoader.h>
+
+#include <WalkingControllers/YarpUtilities/Helper.h>
+
+namespace WalkingControllers
+{
+    namespace Benchmarks
+    {
+        /**
+         * Configuration of a robot loaded from src/WalkingModule/app/robots/<robot>/dcm_walking_with_joypad.ini.
+         */
+        struct RobotFixture
+        {
+            std::string robot; /**< Name of the robot (YARP_ROBOT_NAME). */
+            yarp::os::Property config; /**< Configuration of the walking module. */
+            bool isConfigValid{false}; /**< True if the configuration file was loaded. */
+            std::vector<std::string> joints; /**< Controlled joints. */
+            iDynTree::ModelLoader loader; /**< Reduced model of the robot. */
+            bool isModelValid{false}; /**< True if the model was found and loaded. */
+
+            /**
+             * Get a group of the configuration. The GENERAL group is appended, as done by the
+             * walking module.
+             * @param name name of the group.
+             * @return the options of the group.
+             */
+            yarp::os::Property getGroup(const std::string& name) const
+            {
+                yarp::os::Property group;
+                group.fromString(config.findGroup(name).tail().toString());
+                group.fromString(config.findGroup("GENERAL").tail().toString(), false);
+                return group;
+            }
+        };
+
+        /**
+         * Load (only once) the configuration and the model of a robot. The model.urdf file is
+         * searched by the ResourceFinder as done by the walking module.
+         * @param robot name of the robot.
+         * @return the fixture.
+         */
+        inline const RobotFixture& getRobotFixture(const std::string& robot)
+        {
+            static std::map<std::string, std::unique_ptr<RobotFixture>> fixtures;
+
+            auto& fixture = fixtures[robot];
+            if (fixture != nullptr)
+                return *fixture;
+
+            fixture = std::make_unique<RobotFixture>();
+            fixture->robot = robot;
+            fixture->isConfigValid = fixture->config.fromConfigFile(std::string(WALKING_CONTROLLERS_ROBOTS_DIR)
+                                                                    + "/" + robot + "/dcm_walking_with_joypad.ini");
+            if (!fixture->isConfigValid)
+                return *fixture;
+
+            yarp::os::Property robotControl = fixture->getGroup("ROBOT_CONTROL");
+            yarp::os::Value* jointsList;
+            if (!robotControl.check("joints_list", jointsList)
+                || !YarpUtilities::yarpListToStringVector(jointsList, fixture->joints))
+            {
+                fixture->isConfigValid = false;
+                return *fixture;
+            }
+
+            yarp::conf::environment::set_string("YARP_ROBOT_NAME", robot);
+            yarp::os::ResourceFinder rf;
+            rf.setQuiet(true);
+            rf.configure(0, nullptr);
+            const std::string model = fixture->config.check("model", yarp::os::Value("model.urdf")).asString();
+            const std::string pathToModel = rf.findFileByName(model);
+            fixture->isModelValid = !pathToModel.empty()
+                && fixture->loader.loadReducedModelFromFile(pathToModel, fixture->joints);
+
+            return *fixture;
+        }
+
+        /**
+         * Get the fixture of a robot. If the configuration (or the model) is not available the
+         * benchmark is skipped.
+         * @param state state of the benchmark;
+         * @param robot name of the robot;
+         * @param requireModel true if the benchmark requires the model.
+         * @return pointer to the fixture or nullptr if the benchmark has to be skipped.
+         */
+        inline const RobotFixture* getRobotFixture(benchmark::State& state, const std::string& robot,
+                                                   const bool& requireModel)
+        {
+            const RobotFixture& fixture = getRobotFixture(robot);
+            if (!fixture.isConfigValid || (requireModel && !fixture.isModelValid))
+            {
+                state.SkipWithError(("Unable to load the configuration or the model of " + robot).c_str());
+                return nullptr;
+            }
+            return &fixture;
+        }
+    }
+}
+
+#endif
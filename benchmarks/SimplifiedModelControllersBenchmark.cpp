@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <cmath>
+#include <deque>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// iDynTree
+#include <iDynTree/EigenHelpers.h>
+#include <iDynTree/Transform.h>
+
+#include <WalkingControllers/SimplifiedModelControllers/DCMModelPredictiveController.h>
+#include <WalkingControllers/SimplifiedModelControllers/DCMReactiveController.h>
+#include <WalkingControllers/SimplifiedModelControllers/SimplifiedModelPipeline.h>
+#include <WalkingControllers/SimplifiedModelControllers/ZMPController.h>
+#include <WalkingControllers/TrajectoryPlanner/StableDCMModel.h>
+
+#include "Fixtures.h"
+
+using namespace WalkingControllers;
+
+namespace
+{
+    /**
+     * Pose of a foot on the ground.
+     * @param y lateral position of the foot.
+     */
+    iDynTree::Transform footTransform(const double& y)
+    {
+        return iDynTree::Transform(iDynTree::Rotation::Identity(), iDynTree::Position(0.0, y, 0.0));
+    }
+}
+
+/**
+ * MPCSolver::solve() (through WalkingController). The first argument is the horizon (number of
+ * samples), the second one is 1 if the convex hull contains both feet (more constraints).
+ */
+static void MPCSolve(benchmark::State& state, const std::string& robot)
+{
+    const Benchmarks::RobotFixture* fixture = Benchmarks::getRobotFixture(state, robot, false);
+    if (fixture == nullptr)
+        return;
+
+    const int horizon = static_cast<int>(state.range(0));
+    const bool isDoubleSupport = state.range(1) == 1;
+
+    yarp::os::Property config = fixture->getGroup("DCM_MPC_CONTROLLER");
+    const double dT = config.check("sampling_time", yarp::os::Value(0.01)).asFloat64();
+    config.put("controllerHorizon", horizon * dT);
+
+    WalkingController controller;
+    if (!controller.initialize(config))
+    {
+        state.SkipWithError("Unable to initialize the MPC.");
+        return;
+    }
+
+    const std::deque<iDynTree::Transform> leftFoot{footTransform(0.07)};
+    const std::deque<iDynTree::Transform> rightFoot{footTransform(-0.07)};
+    const std::deque<bool> leftInContact{true};
+    const std::deque<bool> rightInContact{isDoubleSupport};
+    if (!controller.setConvexHullConstraint(leftFoot, rightFoot, leftInContact, rightInContact))
+    {
+        state.SkipWithError("Unable to set the convex hull.");
+        return;
+    }
+
+    // the DCM moves toward the left foot
+    std::deque<iDynTree::Vector2> reference(horizon + 1);
+    for (int i = 0; i <= horizon; i++)
+    {
+        reference[i](0) = 0.0;
+        reference[i](1) = 0.05 * i / horizon;
+    }
+
+    iDynTree::Vector2 feedback;
+    feedback.zero();
+
+    bool ok = true;
+    for (auto _ : state)
+    {
+        ok = ok && controller.setFeedback(feedback);
+        ok = ok && controller.setReferenceSignal(reference, true);
+        ok = ok && controller.solve();
+        benchmark::DoNotOptimize(controller.getControllerOutput());
+    }
+
+    if (!ok)
+        state.SkipWithError("Unable to solve the MPC.");
+}
+BENCHMARK_CAPTURE(MPCSolve, iCubGazeboV3, std::string("iCubGazeboV3"))
+    ->ArgsProduct({{50, 100, 200}, {0, 1}})->ArgNames({"horizon", "double_support"})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(MPCSolve, ergoCubGazeboV1, std::string("ergoCubGazeboV1"))
+    ->ArgsProduct({{50, 100, 200}, {0, 1}})->ArgNames({"horizon", "double_support"})
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * WalkingController::setConvexHullConstraint() when the contact phase changes at every call, i.e.
+ * the convex hull and the solver are rebuilt.
+ */
+static void MPCSetConvexHullConstraint(benchmark::State& state, const std::string& robot)
+{
+    const Benchmarks::RobotFixture* fixture = Benchmarks::getRobotFixture(state, robot, false);
+    if (fixture == nullptr)
+        return;
+
+    WalkingController controller;
+    if (!controller.initialize(fixture->getGroup("DCM_MPC_CONTROLLER")))
+    {
+        state.SkipWithError("Unable to initialize the MPC.");
+        return;
+    }
+
+    const std::deque<iDynTree::Transform> leftFoot{footTransform(0.07)};
+    const std::deque<iDynTree::Transform> rightFoot{footTransform(-0.07)};
+    const std::deque<bool> leftInContact{true};
+    const std::deque<bool> doubleSupport{true};
+    const std::deque<bool> singleSupport{false};
+
+    bool ok = true;
+    bool isDoubleSupport = false;
+    for (auto _ : state)
+    {
+        isDoubleSupport = !isDoubleSupport;
+        ok = ok && controller.setConvexHullConstraint(leftFoot, rightFoot, leftInContact,
+                                                      isDoubleSupport ? doubleSupport : singleSupport);
+    }
+
+    if (!ok)
+        state.SkipWithError("Unable to set the convex hull.");
+}
+BENCHMARK_CAPTURE(MPCSetConvexHullConstraint, iCubGazeboV3, std::string("iCubGazeboV3"))
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(MPCSetConvexHullConstraint, ergoCubGazeboV1, std::string("ergoCubGazeboV1"))
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * One tick of the LIPM, of the DCM reactive controller and of the ZMP-CoM controller.
+ */
+static void ReactiveControllers(benchmark::State& state, const std::string& robot)
+{
+    const Benchmarks::RobotFixture* fixture = Benchmarks::getRobotFixture(state, robot, false);
+    if (fixture == nullptr)
+        return;
+
+    WalkingDCMReactiveController dcmController;
+    WalkingZMPController zmpController;
+    StableDCMModel lipm;
+    const yarp::os::Property general = fixture->getGroup("GENERAL");
+    if (!dcmController.initialize(fixture->getGroup("DCM_REACTIVE_CONTROLLER"))
+        || !zmpController.initialize(fixture->getGroup("ZMP_CONTROLLER"))
+        || !lipm.initialize(general))
+    {
+        state.SkipWithError("Unable to initialize the controllers.");
+        return;
+    }
+
+    iDynTree::Vector2 initialCoM;
+    initialCoM.zero();
+    zmpController.reset(initialCoM);
+    lipm.reset(initialCoM);
+
+    const double comHeight = general.check("com_height", yarp::os::Value(0.5)).asFloat64();
+    iDynTree::Vector2 dcmDesired, dcmVelocityDesired, dcmFeedback, zmpFeedback;
+    iDynTree::Vector2 comPosition, comVelocity;
+    size_t tick = 0;
+    bool ok = true;
+    for (auto _ : state)
+    {
+        const double t = (tick++ % 1000) * 0.01;
+        dcmDesired(0) = 0.05 * t;
+        dcmDesired(1) = 0.03 * std::sin(t);
+        dcmVelocityDesired(0) = 0.05;
+        dcmVelocityDesired(1) = 0.03 * std::cos(t);
+        dcmFeedback = dcmDesired;
+        zmpFeedback = dcmDesired;
+        const iDynTree::Position comFeedback(dcmDesired(0), dcmDesired(1), comHeight);
+
+        lipm.setInput(dcmDesired);
+        ok = ok && lipm.integrateModel();
+        dcmController.setFeedback(dcmFeedback);
+        dcmController.setReferenceSignal(dcmDesired, dcmVelocityDesired);
+        ok = ok && dcmController.evaluateControl();
+        zmpController.setPhase((tick / 50) % 2 == 0);
+        zmpController.setFeedback(zmpFeedback, comFeedback);
+        zmpController.setReferenceSignal(dcmController.getControllerOutput(),
+                                         lipm.getCoMPosition(), lipm.getCoMVelocity());
+        ok = ok && zmpController.evaluateControl();
+        ok = ok && zmpController.getControllerOutput(comPosition, comVelocity);
+        benchmark::DoNotOptimize(comPosition);
+    }
+
+    if (!ok)
+        state.SkipWithError("Unable to evaluate the controllers.");
+}
+BENCHMARK_CAPTURE(ReactiveControllers, iCubGazeboV3, std::string("iCubGazeboV3"));
+BENCHMARK_CAPTURE(ReactiveControllers, ergoCubGazeboV1, std::string("ergoCubGazeboV1"));
+
+/**
+ * The same tick of ReactiveControllers evaluated by the SimplifiedModelPipeline.
+ */
+static void SimplifiedModelPipelineAdvance(benchmark::State& state, const std::string& robot)
+{
+    const Benchmarks::RobotFixture* fixture = Benchmarks::getRobotFixture(state, robot, false);
+    if (fixture == nullptr)
+        return;
+
+    SimplifiedModel::SimplifiedModelPipeline<> pipeline;
+    if (!pipeline.initialize(fixture->getGroup("DCM_REACTIVE_CONTROLLER"), fixture->getGroup("ZMP_CONTROLLER")))
+    {
+        state.SkipWithError("Unable to initialize the pipeline.");
+        return;
+    }
+    pipeline.reset(Eigen::Vector2d::Zero());
+
+    const double comHeight = fixture->getGroup("GENERAL").check("com_height", yarp::os::Value(0.5)).asFloat64();
+    Eigen::Vector2d dcmDesired, dcmVelocityDesired;
+    size_t tick = 0;
+    for (auto _ : state)
+    {
+        const double t = (tick++ % 1000) * 0.01;
+        dcmDesired << 0.05 * t, 0.03 * std::sin(t);
+        dcmVelocityDesired << 0.05, 0.03 * std::cos(t);
+        const Eigen::Vector3d comFeedback(dcmDesired(0), dcmDesired(1), comHeight);
+
+        pipeline.advance(dcmDesired, dcmVelocityDesired, dcmDesired, dcmDesired, comFeedback,
+                         (tick / 50) % 2 == 0);
+        benchmark::DoNotOptimize(pipeline.getDesiredCoMPosition());
+    }
+}
+BENCHMARK_CAPTURE(SimplifiedModelPipelineAdvance, iCubGazeboV3, std::string("iCubGazeboV3"));
+BENCHMARK_CAPTURE(SimplifiedModelPipelineAdvance, ergoCubGazeboV1, std::string("ergoCubGazeboV1"));
+
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// iDynTree
+#include <iDynTree/Transform.h>
+#include <iDynTree/VectorDynSize.h>
+#include <iDynTree/VectorFixSize.h>
+
+#include <WalkingControllers/StdUtilities/Helper.h>
+#include <WalkingControllers/TrajectoryPlanner/TrajectoryGenerator.h>
+
+#include "Fixtures.h"
+
+using namespace WalkingControllers;
+
+/**
+ * Regeneration of the trajectories as done by the walking module when a new goal is received,
+ * i.e. updateTrajectories() followed by the wait for the planner thread.
+ */
+static void TrajectoryRegeneration(benchmark::State& state, const std::string& robot)
+{
+    const Benchmarks::RobotFixture* fixture = Benchmarks::getRobotFixture(state, robot, false);
+    if (fixture == nullptr)
+        return;
+
+    yarp::os::Property config = fixture->getGroup("TRAJECTORY_PLANNER");
+    config.fromString(fixture->config.findGroup("FREE_SPACE_ELLIPSE_MANAGER").tail().toString(), false);
+    const double dT = config.check("sampling_time", yarp::os::Value(0.01)).asFloat64();
+
+    TrajectoryGenerator generator;
+    if (!generator.initialize(config) || !generator.generateFirstTrajectories())
+    {
+        state.SkipWithError("Unable to initialize the planner.");
+        return;
+    }
+
+    std::vector<iDynTree::Vector2> dcmPosition, dcmVelocity;
+    std::vector<size_t> mergePoints;
+    generator.getDCMPositionTrajectory(dcmPosition);
+    generator.getDCMVelocityTrajectory(dcmVelocity);
+    generator.getMergePoints(mergePoints);
+    const size_t mergePoint = mergePoints.empty() ? 0 : mergePoints.front();
+    if (mergePoint >= dcmPosition.size())
+    {
+        state.SkipWithError("Unable to find the merge point.");
+        return;
+    }
+
+    // walk forward, the input is accepted by all the planner modes
+    iDynTree::VectorDynSize plannerInput(3);
+    plannerInput.zero();
+    plannerInput(0) = 1.0;
+
+    bool ok = true;
+    for (auto _ : state)
+    {
+        ok = ok && generator.updateTrajectories(mergePoint * dT, dcmPosition[mergePoint], dcmVelocity[mergePoint],
+                                                true, iDynTree::Transform::Identity(), plannerInput);
+        while (ok && !generator.isTrajectoryComputed())
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+
+        state.PauseTiming();
+        ok = ok && generator.getDCMPositionTrajectory(dcmPosition);
+        state.ResumeTiming();
+    }
+
+    if (!ok)
+        state.SkipWithError("Unable to regenerate the trajectories.");
+}
+BENCHMARK_CAPTURE(TrajectoryRegeneration, iCubGazeboV3, std::string("iCubGazeboV3"))
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(TrajectoryRegeneration, ergoCubGazeboV1, std::string("ergoCubGazeboV1"))
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/**
+ * Merge of a new trajectory in the one stored by the walking module. The argument is the length
+ * of the new trajectory (number of samples), the merge point is in the middle of the old one.
+ */
+template <typename T>
+static void AppendVectorToDeque(benchmark::State& state, const T& value)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    const std::vector<T> input(size, value);
+    const std::deque<T> initial(size, value);
+    std::deque<T> output;
+
+    bool ok = true;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        output = initial;
+        state.ResumeTiming();
+
+        ok = ok && StdUtilities::appendVectorToDeque(input, output, size / 2);
+        benchmark::DoNotOptimize(output.back());
+    }
+
+    if (!ok)
+        state.SkipWithError("Unable to merge the trajectories.");
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK_CAPTURE(AppendVectorToDeque, bool, true)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK_CAPTURE(AppendVectorToDeque, double, 0.0)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK_CAPTURE(AppendVectorToDeque, Vector2, iDynTree::Vector2())->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK_CAPTURE(AppendVectorToDeque, Transform, iDynTree::Transform::Identity())->RangeMultiplier(4)->Range(64, 4096);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// YARP
+#include <yarp/os/Network.h>
+
+// iDynTree
+#include <iDynTree/Rotation.h>
+#include <iDynTree/VectorDynSize.h>
+#include <iDynTree/VectorFixSize.h>
+
+// BipedalLocomotion
+#include <BipedalLocomotion/ParametersHandler/YarpImplementation.h>
+
+#include <WalkingControllers/WalkingLogger/AsyncLogger.h>
+
+#include "Fixtures.h"
+
+using namespace WalkingControllers;
+
+/**
+ * A record of the walking module, i.e. beginRecord(), the push of all the channels and
+ * endRecord(). The data are populated and sent by the background thread of the logger.
+ */
+static void LoggerRecord(benchmark::State& state, const std::string& robot)
+{
+    const Benchmarks::RobotFixture* fixture = Benchmarks::getRobotFixture(state, robot, false);
+    if (fixture == nullptr)
+        return;
+
+    auto loggerOption = std::make_shared<BipedalLocomotion::ParametersHandler::YarpImplementation>(fixture->config)
+        ->getGroup("WALKING_LOGGER").lock();
+    std::string logPort;
+    if (loggerOption == nullptr || !loggerOption->getParameter("remote", logPort))
+    {
+        state.SkipWithError("Unable to get the group WALKING_LOGGER.");
+        return;
+    }
+
+    // nothing is written on the disk and all the records are sent
+    loggerOption->setParameter("remote", "/benchmark_" + robot + logPort);
+    loggerOption->setParameter("flight_recorder_prefix", std::string());
+    loggerOption->setParameter("trigger_mode", false);
+
+    AsyncLogger logger;
+    if (!logger.initialize(loggerOption))
+    {
+        state.SkipWithError("Unable to initialize the logger.");
+        return;
+    }
+
+    const std::vector<std::string> xy{"x", "y"};
+    const std::vector<std::string> xyz{"x", "y", "z"};
+    const std::vector<std::string> rpy{"roll", "pitch", "yaw"};
+
+    // the same channels of the walking module
+    bool ok = true;
+    for (const auto& name : {"dcm::position::measured", "dcm::position::desired", "dcm::velocity::desired",
+                             "zmp::measured", "zmp::desired", "zmp::desired_planner"})
+        ok = ok && logger.addChannel(name, xy);
+    for (const auto& name : {"com::position::measured", "com::position::desired",
+                             "com::position::CoM_ZMP_controller", "com::velocity::desired"})
+        ok = ok && logger.addChannel(name, xyz);
+    for (const std::string foot : {"left_foot", "right_foot"})
+    {
+        ok = ok && logger.addChannel(foot + "::position::measured", xyz);
+        ok = ok && logger.addChannel(foot + "::position::desired", xyz);
+        ok = ok && logger.addChannel(foot + "::orientation::measured", rpy, AsyncLogger::ChannelType::Rotation);
+        ok = ok && logger.addChannel(foot + "::orientation::desired", rpy, AsyncLogger::ChannelType::Rotation);
+        for (const auto& name : {"::linear_velocity::desired", "::angular_velocity::desired",
+                                 "::linear_force::measured", "::angular_torque::measured"})
+            ok = ok && logger.addChannel(foot + name, xyz);
+    }
+    for (const auto& name : {"joints_state::positions::measured", "joints_state::positions::desired",
+                             "joints_state::positions::retargeting", "joints_state::positions::retargeting_raw",
+                             "joints_state::velocities::measured", "joints_state::velocities::retargeting"})
+        ok = ok && logger.addChannel(name, fixture->joints);
+    ok = ok && logger.addChannel("root_link::position::measured", xyz);
+    ok = ok && logger.addChannel("root_link::orientation::measured", rpy, AsyncLogger::ChannelType::Rotation);
+    ok = ok && logger.addChannel("root_link::linear_velocity::measured", xyz);
+    ok = ok && logger.addChannel("root_link::angular_velocity::measured", xyz);
+    ok = ok && logger.addChannel("stance_foot::is_left", {"scalar"});
+
+    if (!ok || !logger.start())
+    {
+        state.SkipWithError("Unable to start the logger.");
+        return;
+    }
+
+    iDynTree::Vector2 planar;
+    planar.zero();
+    iDynTree::Vector3 spatial;
+    spatial.zero();
+    const iDynTree::Rotation rotation = iDynTree::Rotation::RPY(0.01, 0.02, 0.03);
+    iDynTree::VectorDynSize joints(fixture->joints.size());
+    joints.zero();
+
+    for (auto _ : state)
+    {
+        ok = ok && logger.beginRecord();
+        for (size_t i = 0; i < 6; i++)
+            logger.push(planar);
+        for (size_t i = 0; i < 4; i++)
+            logger.push(spatial);
+        for (size_t foot = 0; foot < 2; foot++)
+        {
+            logger.push(spatial);
+            logger.push(spatial);
+            logger.push(rotation);
+            logger.push(rotation);
+            for (size_t i = 0; i < 4; i++)
+                logger.push(spatial);
+        }
+        for (size_t i = 0; i < 6; i++)
+            logger.push(joints);
+        logger.push(spatial);
+        logger.push(rotation);
+        logger.push(spatial);
+        logger.push(spatial);
+        logger.push(1.0);
+        ok = ok && logger.endRecord();
+    }
+
+    logger.close();
+
+    if (!ok)
+        state.SkipWithError("Unable to record the data.");
+}
+BENCHMARK_CAPTURE(LoggerRecord, iCubGazeboV3, std::string("iCubGazeboV3"));
+BENCHMARK_CAPTURE(LoggerRecord, ergoCubGazeboV1, std::string("ergoCubGazeboV1"));
+
+int main(int argc, char** argv)
+{
+    // the ports of the logger are local to the process, the YARP server is not required
+    yarp::os::Network yarp;
+    yarp::os::NetworkBase::setLocalMode(true);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
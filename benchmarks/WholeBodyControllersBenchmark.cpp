@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <cmath>
+#include <memory>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// iDynTree
+#include <iDynTree/Transform.h>
+#include <iDynTree/Twist.h>
+#include <iDynTree/VectorDynSize.h>
+
+// BipedalLocomotion
+#include <BipedalLocomotion/ParametersHandler/YarpImplementation.h>
+
+#include <WalkingControllers/KinDynWrapper/Wrapper.h>
+#include <WalkingControllers/WholeBodyControllers/BLFIK.h>
+#include <WalkingControllers/WholeBodyControllers/InverseKinematics.h>
+
+#include "Fixtures.h"
+
+using namespace WalkingControllers;
+
+namespace
+{
+    /**
+     * Pose of a foot on the ground.
+     * @param y lateral position of the foot.
+     */
+    iDynTree::Transform footTransform(const double& y)
+    {
+        return iDynTree::Transform(iDynTree::Rotation::Identity(), iDynTree::Position(0.0, y, 0.0));
+    }
+
+    /**
+     * Initialize the forward kinematics solver with the robot standing on the left foot.
+     * @param fixture fixture of the robot;
+     * @param solver forward kinematics solver.
+     * @return true in case of success and false otherwise.
+     */
+    bool initializeFK(const Benchmarks::RobotFixture& fixture, WalkingFK& solver)
+    {
+        return solver.initialize(fixture.getGroup("FORWARD_KINEMATICS_SOLVER"), fixture.loader.model())
+            && solver.evaluateWorldToBaseTransformation(footTransform(0.07), footTransform(-0.07), true);
+    }
+
+    /**
+     * Joint positions moving slightly around the zero configuration.
+     * @param tick current tick;
+     * @param positions joint positions [rad].
+     */
+    void jointPositions(const size_t& tick, iDynTree::VectorDynSize& positions)
+    {
+        for (size_t i = 0; i < positions.size(); i++)
+            positions(i) = 0.1 * std::sin(0.01 * tick + i);
+    }
+}
+
+/**
+ * WalkingFK::setInternalRobotState() followed by the evaluation of the DCM.
+ */
+static void FKSetStateAndDCM(benchmark::State& state, const std::string& robot)
+{
+    const Benchmarks::RobotFixture* fixture = Benchmarks::getRobotFixture(state, robot, true);
+    if (fixture == nullptr)
+        return;
+
+    WalkingFK solver;
+    if (!initializeFK(*fixture, solver))
+    {
+        state.SkipWithError("Unable to initialize the FK solver.");
+        return;
+    }
+
+    iDynTree::VectorDynSize positions(fixture->joints.size());
+    iDynTree::VectorDynSize velocities(fixture->joints.size());
+    velocities.zero();
+    size_t tick = 0;
+    bool ok = true;
+    for (auto _ : state)
+    {
+        jointPositions(tick++, positions);
+        ok = ok && solver.setInternalRobotState(positions, velocities);
+        benchmark::DoNotOptimize(solver.getDCM());
+    }
+
+    if (!ok)
+        state.SkipWithError("Unable to set the robot state.");
+}
+BENCHMARK_CAPTURE(FKSetStateAndDCM, iCubGazeboV3, std::string("iCubGazeboV3"));
+BENCHMARK_CAPTURE(FKSetStateAndDCM, ergoCubGazeboV1, std::string("ergoCubGazeboV1"));
+
+/**
+ * WalkingFK::setInternalRobotState() followed by the evaluation of the frame set, i.e. of the
+ * world transforms read in a tick.
+ */
+static void FKSetStateAndFrameSet(benchmark::State& state, const std::string& robot)
+{
+    const Benchmarks::RobotFixture* fixture = Benchmarks::getRobotFixture(state, robot, true);
+    if (fixture == nullptr)
+        return;
+
+    WalkingFK solver;
+    if (!initializeFK(*fixture, solver))
+    {
+        state.SkipWithError("Unable to initialize the FK solver.");
+        return;
+    }
+
+    iDynTree::VectorDynSize positions(fixture->joints.size());
+    iDynTree::VectorDynSize velocities(fixture->joints.size());
+    velocities.zero();
+    size_t tick = 0;
+    bool ok = true;
+    for (auto _ : state)
+    {
+        jointPositions(tick++, positions);
+        ok = ok && solver.setInternalRobotState(positions, velocities);
+        solver.evaluateFrameSet();
+        for (size_t i = 0; i < solver.getNumberOfFrames(); i++)
+            benchmark::DoNotOptimize(solver.getWorldTransform(i));
+    }
+
+    if (!ok)
+        state.SkipWithError("Unable to set the robot state.");
+}
+BENCHMARK_CAPTURE(FKSetStateAndFrameSet, iCubGazeboV3, std::string("iCubGazeboV3"));
+BENCHMARK_CAPTURE(FKSetStateAndFrameSet, ergoCubGazeboV1, std::string("ergoCubGazeboV1"));
+
+/**
+ * WalkingIK::computeIK() with the feet on the ground and the CoM moving laterally.
+ */
+static void WalkingIKComputeIK(benchmark::State& state, const std::string& robot)
+{
+    const Benchmarks::RobotFixture* fixture = Benchmarks::getRobotFixture(state, robot, true);
+    if (fixture == nullptr)
+        return;
+
+    WalkingIK solver;
+    yarp::os::Property config = fixture->getGroup("INVERSE_KINEMATICS_SOLVER");
+    iDynTree::VectorDynSize positions(fixture->joints.size());
+    positions.zero();
+    if (!solver.initialize(config, fixture->loader.model(), fixture->joints)
+        || !solver.setFullModelFeedBack(positions))
+    {
+        state.SkipWithError("Unable to initialize the IK solver.");
+        return;
+    }
+
+    const double comHeight = fixture->getGroup("GENERAL").check("com_height", yarp::os::Value(0.5)).asFloat64();
+    size_t tick = 0;
+    bool ok = true;
+    for (auto _ : state)
+    {
+        const iDynTree::Position comPosition(0.0, 0.03 * std::sin(0.01 * tick++), comHeight);
+        ok = ok && solver.computeIK(footTransform(0.07), footTransform(-0.07), comPosition, positions);
+        benchmark::DoNotOptimize(positions.data());
+    }
+
+    if (!ok)
+        state.SkipWithError("Unable to solve the IK.");
+}
+BENCHMARK_CAPTURE(WalkingIKComputeIK, iCubGazeboV3, std::string("iCubGazeboV3"))
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(WalkingIKComputeIK, ergoCubGazeboV1, std::string("ergoCubGazeboV1"))
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * BLFIK::solve() in the walking phase, the set points are the ones of the zero configuration.
+ */
+static void BLFIKSolve(benchmark::State& state, const std::string& robot)
+{
+    const Benchmarks::RobotFixture* fixture = Benchmarks::getRobotFixture(state, robot, true);
+    if (fixture == nullptr)
+        return;
+
+    WalkingFK fkSolver;
+    if (!initializeFK(*fixture, fkSolver))
+    {
+        state.SkipWithError("Unable to initialize the FK solver.");
+        return;
+    }
+
+    iDynTree::VectorDynSize positions(fixture->joints.size());
+    iDynTree::VectorDynSize velocities(fixture->joints.size());
+    positions.zero();
+    velocities.zero();
+    if (!fkSolver.setInternalRobotState(positions, velocities))
+    {
+        state.SkipWithError("Unable to set the robot state.");
+        return;
+    }
+
+    const yarp::os::Property general = fixture->getGroup("GENERAL");
+    const bool useRootLinkForHeight = general.check("height_reference_frame", yarp::os::Value("com")).asString()
+        == "root_link";
+    yarp::os::Bottle options = fixture->config.findGroup("INVERSE_KINEMATICS_QP_SOLVER");
+    options.append(fixture->config.findGroup("GENERAL"));
+    auto paramHandler = std::make_shared<BipedalLocomotion::ParametersHandler::YarpImplementation>();
+    paramHandler->set(options);
+    paramHandler->setParameter("use_root_link_for_height", useRootLinkForHeight);
+
+    BLFIK solver;
+    if (!solver.initialize(paramHandler, fkSolver.getKinDyn())
+        || !solver.setRegularizationJointSetPoint(positions))
+    {
+        state.SkipWithError("Unable to initialize the BLF IK solver.");
+        return;
+    }
+
+    const iDynTree::Transform leftFoot = fkSolver.getLeftFootToWorldTransform();
+    const iDynTree::Transform rightFoot = fkSolver.getRightFootToWorldTransform();
+    const iDynTree::Position comPosition = fkSolver.getCoMPosition();
+    const iDynTree::Rotation neckOrientation = fkSolver.getNeckOrientation();
+    const iDynTree::Twist zeroTwist = iDynTree::Twist::Zero();
+    iDynTree::Vector3 comVelocity;
+    comVelocity.zero();
+
+    bool ok = true;
+    for (auto _ : state)
+    {
+        ok = ok && solver.setPhase("walking");
+        ok = ok && solver.setTorsoSetPoint(neckOrientation);
+        ok = ok && solver.setLeftFootSetPoint(leftFoot, zeroTwist);
+        ok = ok && solver.setRightFootSetPoint(rightFoot, zeroTwist);
+        ok = ok && solver.setCoMSetPoint(comPosition, comVelocity);
+        ok = ok && solver.setRetargetingJointSetPoint(positions, velocities);
+        if (useRootLinkForHeight)
+            ok = ok && solver.setRootSetPoint(comPosition, comVelocity);
+        ok = ok && solver.solve();
+        benchmark::DoNotOptimize(solver.getDesiredJointVelocity().data());
+    }
+
+    if (!ok)
+        state.SkipWithError("Unable to solve the BLF IK.");
+}
+BENCHMARK_CAPTURE(BLFIKSolve, iCubGazeboV3, std::string("iCubGazeboV3"))
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BLFIKSolve, ergoCubGazeboV1, std::string("ergoCubGazeboV1"))
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,20 @@
+# Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT). All rights reserved.
+# This software may be modified and distributed under the terms of the
+# BSD-3-Clause license. See the accompanying LICENSE file for details.
+
+# Fetch Google Benchmark
+find_package(benchmark 1.8.3 QUIET)
+cmake_dependent_option(USE_SYSTEM_benchmark "Use system Google Benchmark" ON "benchmark_FOUND" OFF)
+if(NOT USE_SYSTEM_benchmark)
+  include(FetchContent)
+  FetchContent_Declare(benchmark
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_TAG        v1.8.3)
+  FetchContent_GetProperties(benchmark)
+  if(NOT benchmark_POPULATED)
+    message(STATUS "Fetching Google Benchmark...")
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+    FetchContent_MakeAvailable(benchmark)
+  endif()
+endif()
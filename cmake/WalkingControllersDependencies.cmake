@@ -13,3 +13,6 @@ find_package(BipedalLocomotionFramework 0.18.0
   COMPONENTS VectorsCollection IK ParametersHandlerYarpImplementation
              ContinuousDynamicalSystem ManifConversions Contacts
              ParametersHandlerYarpImplementation REQUIRED)
+
+# optional, used to convert the flight recorder files in mat files
+find_package(matioCpp QUIET)
@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_EIGEN_UTILITIES_BOUNDED_INTEGRATOR_H
+#define WALKING_CONTROLLERS_EIGEN_UTILITIES_BOUNDED_INTEGRATOR_H
+
+// std
+#include <iostream>
+#include <limits>
+
+// Eigen
+#include <Eigen/Core>
+
+namespace WalkingControllers
+{
+
+/**
+ * Helper for Eigen library.
+ */
+    namespace EigenUtilities
+    {
+        /**
+         * BoundedIntegrator integrates a velocity with the trapezoidal rule of Integrator and keeps
+         * the integral within the position limits. Optionally the input velocity is saturated and
+         * its variation between two steps is bounded (acceleration limit).
+         * The size can be Eigen::Dynamic, in that case the memory is allocated only by initialize().
+         * With the limits of the joints it is the allocation-free counterpart of
+         * iCub::ctrl::Integrator.
+         */
+        template <int Size>
+        class BoundedIntegrator
+        {
+        public:
+            using Vector = Eigen::Matrix<double, Size, 1>; /**< Type of the integrated signal. */
+
+        private:
+            double m_samplingTime{0}; /**< Sampling time. */
+            bool m_isInitialized{false}; /**< True if the integrator was initialized. */
+
+            Vector m_lowerLimits; /**< Lower limits of the integral. */
+            Vector m_upperLimits; /**< Upper limits of the integral. */
+            Vector m_velocityLimits; /**< Limits of the absolute value of the input. */
+            Vector m_velocityIncrements; /**< Maximum variation of the input in a step. */
+
+            Vector m_state; /**< Integral of the signal. */
+            Vector m_previousInput; /**< (Saturated) input at the previous step. */
+            Vector m_input; /**< (Saturated) input at the current step. */
+
+        public:
+
+            /**
+             * Initialize the integrator. The velocity and acceleration are not limited.
+             * @param samplingTime sampling time of the integrator;
+             * @param lowerLimits lower limits of the integral;
+             * @param upperLimits upper limits of the integral.
+             * @return true/false in case of success/failure
+             */
+            template <typename LowerDerived, typename UpperDerived>
+            bool initialize(const double samplingTime,
+                            const Eigen::MatrixBase<LowerDerived>& lowerLimits,
+                            const Eigen::MatrixBase<UpperDerived>& upperLimits)
+            {
+                if(samplingTime <= 0)
+                {
+                    std::cerr << "[EigenUtilities::BoundedIntegrator::initialize] The sampling time has to be a positive number."
+                              << std::endl;
+                    return false;
+                }
+
+                if((Size != Eigen::Dynamic && lowerLimits.size() != Size)
+                   || lowerLimits.size() != upperLimits.size()
+                   || (lowerLimits.array() > upperLimits.array()).any())
+                {
+                    std::cerr << "[EigenUtilities::BoundedIntegrator::initialize] The limits are not consistent."
+                              << std::endl;
+                    return false;
+                }
+
+                m_samplingTime = samplingTime;
+                m_lowerLimits = lowerLimits;
+                m_upperLimits = upperLimits;
+
+                const auto size = lowerLimits.size();
+                m_velocityLimits.setConstant(size, std::numeric_limits<double>::infinity());
+                m_velocityIncrements.setConstant(size, std::numeric_limits<double>::infinity());
+                m_previousInput.setZero(size);
+                m_input.setZero(size);
+                m_state = m_lowerLimits.cwiseMax(Vector::Zero(size)).cwiseMin(m_upperLimits);
+
+                m_isInitialized = true;
+                return true;
+            }
+
+            /**
+             * Return true if the integrator has been initialized.
+             */
+            bool isInitialized() const
+            {
+                return m_isInitialized;
+            }
+
+            /**
+             * Saturate the input.
+             * @param velocityLimits limits of the absolute value of the input.
+             * @return true/false in case of success/failure
+             */
+            template <typename Derived>
+            bool setVelocityLimits(const Eigen::MatrixBase<Derived>& velocityLimits)
+            {
+                if(!m_isInitialized || velocityLimits.size() != m_state.size()
+                   || (velocityLimits.array() < 0).any())
+                {
+                    std::cerr << "[EigenUtilities::BoundedIntegrator::setVelocityLimits] The limits are supposed to be "
+                              << "non negative and the integrator initialized." << std::endl;
+                    return false;
+                }
+
+                m_velocityLimits = velocityLimits;
+                return true;
+            }
+
+            /**
+             * Bound the variation of the input between two steps.
+             * @param accelerationLimits limits of the absolute value of the derivative of the input.
+             * @return true/false in case of success/failure
+             */
+            template <typename Derived>
+            bool setAccelerationLimits(const Eigen::MatrixBase<Derived>& accelerationLimits)
+            {
+                if(!m_isInitialized || accelerationLimits.size() != m_state.size()
+                   || (accelerationLimits.array() < 0).any())
+                {
+                    std::cerr << "[EigenUtilities::BoundedIntegrator::setAccelerationLimits] The limits are supposed to be "
+                              << "non negative and the integrator initialized." << std::endl;
+                    return false;
+                }
+
+                m_velocityIncrements = m_samplingTime * accelerationLimits;
+                return true;
+            }
+
+            /**
+             * Integrate the input signal.
+             * @param input value of the signal at the current step.
+             * @return the integral of the signal.
+             */
+            template <typename Derived>
+            const Vector& integrate(const Eigen::MatrixBase<Derived>& input)
+            {
+                // the saturations are coefficient-wise, hence they are vectorized by Eigen
+                m_input = input.cwiseMax(-m_velocityLimits).cwiseMin(m_velocityLimits);
+                m_input = m_input.cwiseMax(m_previousInput - m_velocityIncrements)
+                              .cwiseMin(m_previousInput + m_velocityIncrements);
+
+                m_state = (m_state + (m_samplingTime / 2.0) * (m_input + m_previousInput))
+                              .cwiseMax(m_lowerLimits).cwiseMin(m_upperLimits);
+                m_previousInput = m_input;
+                return m_state;
+            }
+
+            /**
+             * Reset the integrator. The input at the previous step is set to zero.
+             * @param initialState new value of the integral (it is saturated within the limits).
+             */
+            template <typename Derived>
+            void reset(const Eigen::MatrixBase<Derived>& initialState)
+            {
+                m_state = initialState.cwiseMax(m_lowerLimits).cwiseMin(m_upperLimits);
+                m_previousInput.setZero();
+            }
+
+            /**
+             * Get the current value of the integral.
+             * @return the integral of the signal.
+             */
+            const Vector& get() const
+            {
+                return m_state;
+            }
+
+            /**
+             * Get the saturated input of the last step.
+             * @return the input used in the last integration step.
+             */
+            const Vector& getInput() const
+            {
+                return m_input;
+            }
+        };
+    }
+};
+
+#endif
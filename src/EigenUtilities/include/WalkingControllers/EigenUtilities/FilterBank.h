@@ -0,0 +1,340 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_EIGEN_UTILITIES_FILTER_BANK_H
+#define WALKING_CONTROLLERS_EIGEN_UTILITIES_FILTER_BANK_H
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+// Eigen
+#include <Eigen/Core>
+
+namespace WalkingControllers
+{
+
+/**
+ * Helper for Eigen library.
+ */
+    namespace EigenUtilities
+    {
+        /**
+         * FilterBank filters a set of channels with cascades of second order sections (direct
+         * form II transposed). The channels are stored in a contiguous vector and each section is
+         * evaluated on all the channels at once, hence the filter is vectorized by Eigen.
+         * The channels are added in groups sharing the same filter (first order low pass, biquad
+         * or Butterworth low pass). The groups with fewer sections are completed with identity
+         * sections. The memory is allocated only when the groups are added.
+         */
+        class FilterBank
+        {
+            double m_samplingTime{0}; /**< Sampling time of the filters. */
+
+            // coefficients of the sections (a row for each channel, a column for each section)
+            Eigen::ArrayXXd m_b0, m_b1, m_b2, m_a1, m_a2;
+            Eigen::ArrayXXd m_gain; /**< Static gain of each section. */
+            Eigen::ArrayXXd m_z1, m_z2; /**< States of the sections. */
+
+            Eigen::VectorXd m_input; /**< Input of the channels. */
+            Eigen::VectorXd m_output; /**< Output of the channels. */
+            Eigen::ArrayXd m_signal; /**< Signal entering a section. */
+            Eigen::ArrayXd m_sectionOutput; /**< Signal leaving a section. */
+
+            /**
+             * Add a group of channels.
+             * @param channels number of channels;
+             * @param sections number of sections of the filter of the group.
+             * @return the index of the first channel of the group.
+             */
+            std::size_t addChannels(const std::size_t channels, const Eigen::Index sections)
+            {
+                const Eigen::Index offset = m_input.size();
+                const Eigen::Index rows = offset + static_cast<Eigen::Index>(channels);
+                const Eigen::Index columns = std::max(m_b0.cols(), sections);
+
+                // the new coefficients are the ones of the identity section
+                for (Eigen::ArrayXXd* coefficients : {&m_b0, &m_gain})
+                {
+                    Eigen::ArrayXXd resized = Eigen::ArrayXXd::Ones(rows, columns);
+                    resized.topLeftCorner(offset, coefficients->cols()) = *coefficients;
+                    coefficients->swap(resized);
+                }
+                for (Eigen::ArrayXXd* coefficients : {&m_b1, &m_b2, &m_a1, &m_a2, &m_z1, &m_z2})
+                {
+                    Eigen::ArrayXXd resized = Eigen::ArrayXXd::Zero(rows, columns);
+                    resized.topLeftCorner(offset, coefficients->cols()) = *coefficients;
+                    coefficients->swap(resized);
+                }
+
+                m_input.conservativeResize(rows);
+                m_input.tail(channels).setZero();
+                m_output.conservativeResize(rows);
+                m_output.tail(channels).setZero();
+                m_signal.resize(rows);
+                m_sectionOutput.resize(rows);
+
+                return static_cast<std::size_t>(offset);
+            }
+
+            /**
+             * Set a section of a group of channels.
+             * @param offset index of the first channel of the group;
+             * @param channels number of channels of the group;
+             * @param section index of the section;
+             * @param numerator coefficients of the numerator (b0, b1, b2);
+             * @param denominator coefficients of the denominator (1, a1, a2).
+             */
+            void setSection(const std::size_t offset, const std::size_t channels, const Eigen::Index section,
+                            const Eigen::Vector3d& numerator, const Eigen::Vector3d& denominator)
+            {
+                const Eigen::Index first = static_cast<Eigen::Index>(offset);
+                const Eigen::Index size = static_cast<Eigen::Index>(channels);
+                m_b0.col(section).segment(first, size) = numerator(0);
+                m_b1.col(section).segment(first, size) = numerator(1);
+                m_b2.col(section).segment(first, size) = numerator(2);
+                m_a1.col(section).segment(first, size) = denominator(1);
+                m_a2.col(section).segment(first, size) = denominator(2);
+
+                // the filters are low pass, hence the static gain is defined
+                m_gain.col(section).segment(first, size) = numerator.sum() / denominator.sum();
+            }
+
+            /**
+             * Check the cut frequency of a filter.
+             */
+            bool checkCutFrequency(const double cutFrequency, const char* method) const
+            {
+                if(m_samplingTime <= 0 || cutFrequency <= 0 || cutFrequency >= 0.5 / m_samplingTime)
+                {
+                    std::cerr << "[EigenUtilities::FilterBank::" << method << "] The bank has to be initialized "
+                              << "and the cut frequency has to be positive and lower than the Nyquist frequency."
+                              << std::endl;
+                    return false;
+                }
+                return true;
+            }
+
+        public:
+
+            /**
+             * Initialize the bank. All the channels are removed.
+             * @param samplingTime sampling time of the filters.
+             * @return true/false in case of success/failure
+             */
+            bool initialize(const double samplingTime)
+            {
+                if(samplingTime <= 0)
+                {
+                    std::cerr << "[EigenUtilities::FilterBank::initialize] The sampling time has to be a positive number."
+                              << std::endl;
+                    return false;
+                }
+
+                m_samplingTime = samplingTime;
+                for (Eigen::ArrayXXd* coefficients : {&m_b0, &m_b1, &m_b2, &m_a1, &m_a2, &m_gain, &m_z1, &m_z2})
+                    coefficients->resize(0, 0);
+                m_input.resize(0);
+                m_output.resize(0);
+                m_signal.resize(0);
+                m_sectionOutput.resize(0);
+                return true;
+            }
+
+            /**
+             * Add a group of channels filtered by the first order low pass filter 1 / (1 + tau s),
+             * discretized with the Tustin method (as iCub::ctrl::FirstOrderLowPassFilter).
+             * @param channels number of channels;
+             * @param cutFrequency cut frequency [Hz];
+             * @param offset index of the first channel of the group.
+             * @return true/false in case of success/failure
+             */
+            bool addFirstOrderLowPass(const std::size_t channels, const double cutFrequency, std::size_t& offset)
+            {
+                if(!checkCutFrequency(cutFrequency, "addFirstOrderLowPass"))
+                    return false;
+
+                const double tau = 1 / (2 * M_PI * cutFrequency);
+                const double den = 2 * tau + m_samplingTime;
+                offset = addChannels(channels, 1);
+                setSection(offset, channels, 0,
+                           Eigen::Vector3d(m_samplingTime / den, m_samplingTime / den, 0),
+                           Eigen::Vector3d(1, (m_samplingTime - 2 * tau) / den, 0));
+                return true;
+            }
+
+            /**
+             * Add a group of channels filtered by a Butterworth low pass filter, discretized with
+             * the Tustin method with frequency prewarping.
+             * @param channels number of channels;
+             * @param cutFrequency cut frequency [Hz];
+             * @param order order of the filter;
+             * @param offset index of the first channel of the group.
+             * @return true/false in case of success/failure
+             */
+            bool addButterworthLowPass(const std::size_t channels, const double cutFrequency, const int order,
+                                       std::size_t& offset)
+            {
+                if(!checkCutFrequency(cutFrequency, "addButterworthLowPass"))
+                    return false;
+
+                if(order < 1)
+                {
+                    std::cerr << "[EigenUtilities::FilterBank::addButterworthLowPass] The order has to be positive."
+                              << std::endl;
+                    return false;
+                }
+
+                const double k = std::tan(M_PI * cutFrequency * m_samplingTime);
+                const Eigen::Index sections = (order + 1) / 2;
+                offset = addChannels(channels, sections);
+
+                // a section for each pair of complex conjugate poles -sin(theta) +- j cos(theta),
+                // i.e. s^2 + 2 sin(theta) s + 1
+                for (Eigen::Index i = 0; i < order / 2; i++)
+                {
+                    const double theta = M_PI * (2 * i + 1) / (2 * order);
+                    const double kOverQ = 2 * std::sin(theta) * k;
+                    const double den = 1 + kOverQ + k * k;
+                    setSection(offset, channels, i,
+                               Eigen::Vector3d(k * k / den, 2 * k * k / den, k * k / den),
+                               Eigen::Vector3d(1, 2 * (k * k - 1) / den, (1 - kOverQ + k * k) / den));
+                }
+
+                // the real pole of the odd orders
+                if(order % 2 == 1)
+                {
+                    setSection(offset, channels, sections - 1,
+                               Eigen::Vector3d(k / (1 + k), k / (1 + k), 0),
+                               Eigen::Vector3d(1, (k - 1) / (1 + k), 0));
+                }
+                return true;
+            }
+
+            /**
+             * Add a group of channels filtered by a low pass filter. The first order filter is the
+             * one of addFirstOrderLowPass(), the higher orders are Butterworth filters.
+             * @param channels number of channels;
+             * @param cutFrequency cut frequency [Hz];
+             * @param order order of the filter;
+             * @param offset index of the first channel of the group.
+             * @return true/false in case of success/failure
+             */
+            bool addLowPass(const std::size_t channels, const double cutFrequency, const int order,
+                            std::size_t& offset)
+            {
+                if(order == 1)
+                    return addFirstOrderLowPass(channels, cutFrequency, offset);
+
+                return addButterworthLowPass(channels, cutFrequency, order, offset);
+            }
+
+            /**
+             * Add a group of channels filtered by a second order section
+             * (b0 + b1 z^-1 + b2 z^-2) / (a0 + a1 z^-1 + a2 z^-2).
+             * @param channels number of channels;
+             * @param numerator coefficients of the numerator (b0, b1, b2);
+             * @param denominator coefficients of the denominator (a0, a1, a2). The static gain
+             * (sum(b) / sum(a)) has to be defined;
+             * @param offset index of the first channel of the group.
+             * @return true/false in case of success/failure
+             */
+            bool addBiquad(const std::size_t channels, const Eigen::Vector3d& numerator,
+                           const Eigen::Vector3d& denominator, std::size_t& offset)
+            {
+                if(m_samplingTime <= 0 || denominator(0) == 0 || denominator.sum() == 0)
+                {
+                    std::cerr << "[EigenUtilities::FilterBank::addBiquad] The bank has to be initialized and "
+                              << "a0 and the static gain have to be defined." << std::endl;
+                    return false;
+                }
+
+                offset = addChannels(channels, 1);
+                setSection(offset, channels, 0, numerator / denominator(0), denominator / denominator(0));
+                return true;
+            }
+
+            /**
+             * Get the number of channels of the bank.
+             */
+            std::size_t getNumberOfChannels() const
+            {
+                return static_cast<std::size_t>(m_input.size());
+            }
+
+            /**
+             * Get the group delay of a channel at low frequency.
+             * @param channel index of the channel.
+             * @return the delay of the channel [s].
+             */
+            double getGroupDelay(const std::size_t channel) const
+            {
+                // the delay of B(z) / A(z) at z = 1 is sum(k b_k) / sum(b_k) - sum(k a_k) / sum(a_k)
+                const Eigen::Index i = static_cast<Eigen::Index>(channel);
+                const auto numerator = m_b0.row(i) + m_b1.row(i) + m_b2.row(i);
+                const auto denominator = 1 + m_a1.row(i) + m_a2.row(i);
+                return m_samplingTime * ((m_b1.row(i) + 2 * m_b2.row(i)) / numerator
+                                         - (m_a1.row(i) + 2 * m_a2.row(i)) / denominator).sum();
+            }
+
+            /**
+             * Get the input of a group of channels.
+             * @param offset index of the first channel;
+             * @param channels number of channels.
+             * @return the input of the channels, to be set before filter() or reset().
+             */
+            Eigen::VectorBlock<Eigen::VectorXd> input(const std::size_t offset, const std::size_t channels)
+            {
+                return m_input.segment(static_cast<Eigen::Index>(offset), static_cast<Eigen::Index>(channels));
+            }
+
+            /**
+             * Get the output of a group of channels.
+             * @param offset index of the first channel;
+             * @param channels number of channels.
+             * @return the output of the channels.
+             */
+            Eigen::VectorBlock<const Eigen::VectorXd> output(const std::size_t offset, const std::size_t channels) const
+            {
+                return m_output.segment(static_cast<Eigen::Index>(offset), static_cast<Eigen::Index>(channels));
+            }
+
+            /**
+             * Filter all the channels.
+             */
+            void filter()
+            {
+                m_signal = m_input.array();
+                for (Eigen::Index i = 0; i < m_b0.cols(); i++)
+                {
+                    m_sectionOutput = m_b0.col(i) * m_signal + m_z1.col(i);
+                    m_z1.col(i) = m_b1.col(i) * m_signal - m_a1.col(i) * m_sectionOutput + m_z2.col(i);
+                    m_z2.col(i) = m_b2.col(i) * m_signal - m_a2.col(i) * m_sectionOutput;
+                    m_signal.swap(m_sectionOutput);
+                }
+                m_output = m_signal.matrix();
+            }
+
+            /**
+             * Reset the states of the filters so that the output is the steady state one for the
+             * current input.
+             */
+            void reset()
+            {
+                m_signal = m_input.array();
+                for (Eigen::Index i = 0; i < m_b0.cols(); i++)
+                {
+                    m_sectionOutput = m_gain.col(i) * m_signal;
+                    m_z1.col(i) = m_sectionOutput - m_b0.col(i) * m_signal;
+                    m_z2.col(i) = m_b2.col(i) * m_signal - m_a2.col(i) * m_sectionOutput;
+                    m_signal.swap(m_sectionOutput);
+                }
+                m_output = m_signal.matrix();
+            }
+        };
+    }
+};
+
+#endif
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_EIGEN_UTILITIES_INTEGRATOR_H
+#define WALKING_CONTROLLERS_EIGEN_UTILITIES_INTEGRATOR_H
+
+// std
+#include <iostream>
+
+// Eigen
+#include <Eigen/Core>
+
+namespace WalkingControllers
+{
+
+/**
+ * Helper for Eigen library.
+ */
+    namespace EigenUtilities
+    {
+        /**
+         * Integrator implements the trapezoidal integration rule
+         * y(k) = y(k-1) + dT / 2 * (x(k) + x(k-1))
+         * on a fixed size vector. It is the allocation-free counterpart of iCub::ctrl::Integrator.
+         */
+        template <int Size>
+        class Integrator
+        {
+        public:
+            using Vector = Eigen::Matrix<double, Size, 1>; /**< Type of the integrated signal. */
+
+        private:
+            double m_halfSamplingTime{0}; /**< Half of the sampling time. */
+            bool m_isInitialized{false}; /**< True if the integrator was initialized. */
+
+            Vector m_state{Vector::Zero()}; /**< Integral of the signal. */
+            Vector m_previousInput{Vector::Zero()}; /**< Input at the previous step. */
+
+        public:
+
+            /**
+             * Initialize the integrator.
+             * @param samplingTime sampling time of the integrator;
+             * @param initialState initial value of the integral.
+             * @return true/false in case of success/failure
+             */
+            bool initialize(const double samplingTime,
+                            const Vector& initialState = Vector::Zero())
+            {
+                if(samplingTime <= 0)
+                {
+                    std::cerr << "[EigenUtilities::Integrator::initialize] The sampling time has to be a positive number."
+                              << std::endl;
+                    return false;
+                }
+
+                m_halfSamplingTime = samplingTime / 2.0;
+                m_isInitialized = true;
+                reset(initialState);
+
+                return true;
+            }
+
+            /**
+             * Return true if the integrator has been initialized.
+             */
+            bool isInitialized() const
+            {
+                return m_isInitialized;
+            }
+
+            /**
+             * Integrate the input signal.
+             * @param input value of the signal at the current step.
+             * @return the integral of the signal.
+             */
+            template <typename Derived>
+            const Vector& integrate(const Eigen::MatrixBase<Derived>& input)
+            {
+                m_state.noalias() += m_halfSamplingTime * (input + m_previousInput);
+                m_previousInput = input;
+                return m_state;
+            }
+
+            /**
+             * Reset the integrator.
+             * @param initialState new value of the integral.
+             */
+            template <typename Derived>
+            void reset(const Eigen::MatrixBase<Derived>& initialState)
+            {
+                m_state = initialState;
+                m_previousInput.setZero();
+            }
+
+            /**
+             * Get the current value of the integral.
+             * @return the integral of the signal.
+             */
+            const Vector& get() const
+            {
+                return m_state;
+            }
+        };
+    }
+};
+
+#endif
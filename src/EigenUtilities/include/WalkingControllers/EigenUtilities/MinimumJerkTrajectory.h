@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_EIGEN_UTILITIES_MINIMUM_JERK_TRAJECTORY_H
+#define WALKING_CONTROLLERS_EIGEN_UTILITIES_MINIMUM_JERK_TRAJECTORY_H
+
+// std
+#include <iostream>
+
+// Eigen
+#include <Eigen/Core>
+
+namespace WalkingControllers
+{
+    namespace EigenUtilities
+    {
+        /**
+         * MinimumJerkTrajectory generates a minimum jerk like trajectory towards a (possibly
+         * varying) target. As iCub::ctrl::minJerkTrajGen, the minimum jerk profile is approximated
+         * with the third order linear system
+         * \f[
+         * \dddot{x} = a (x - x_{target}) + b \dot{x} + c \ddot{x}
+         * \f]
+         * with \f$ a = -150 / T^3 \f$, \f$ b = -60 / T^2 \f$, \f$ c = -9 / T \f$ and T the
+         * smoothing time. The system is discretized exactly at initialization time, hence each step
+         * requires only a fixed size matrix product.
+         */
+        template <int Size>
+        class MinimumJerkTrajectory
+        {
+        public:
+            using Vector = Eigen::Matrix<double, Size, 1>; /**< Type of the smoothed signal. */
+
+        private:
+            using StateMatrix = Eigen::Matrix<double, 3, 3>;
+            using AugmentedMatrix = Eigen::Matrix<double, 4, 4>;
+
+            StateMatrix m_stateMatrix; /**< Discrete state matrix. */
+            Eigen::Vector3d m_inputMatrix; /**< Discrete input matrix. */
+
+            /**
+             * State of the system. Each column contains position, velocity and acceleration of
+             * one element of the signal.
+             */
+            Eigen::Matrix<double, 3, Size> m_state{Eigen::Matrix<double, 3, Size>::Zero()};
+
+            bool m_isInitialized{false}; /**< True if the trajectory was initialized. */
+
+            /**
+             * Evaluate the exponential of a matrix using the scaling and squaring method.
+             * @param matrix the input matrix.
+             * @return the exponential of the matrix.
+             */
+            static AugmentedMatrix exponential(const AugmentedMatrix& matrix)
+            {
+                // scale the matrix so that its norm is lower than 0.5
+                int squarings = 0;
+                double norm = matrix.cwiseAbs().rowwise().sum().maxCoeff();
+                while(norm > 0.5)
+                {
+                    norm /= 2.0;
+                    squarings++;
+                }
+                const AugmentedMatrix scaled = matrix / static_cast<double>(1 << squarings);
+
+                // truncated Taylor series
+                AugmentedMatrix result = AugmentedMatrix::Identity();
+                AugmentedMatrix term = AugmentedMatrix::Identity();
+                for(int k = 1; k <= 16; k++)
+                {
+                    term = term * scaled / static_cast<double>(k);
+                    result += term;
+                }
+
+                for(int i = 0; i < squarings; i++)
+                    result = result * result;
+
+                return result;
+            }
+
+        public:
+
+            /**
+             * Initialize the trajectory generator.
+             * @param samplingTime sampling time of the generator;
+             * @param smoothingTime time required to reach (approximately) the target;
+             * @param initialPosition initial position of the trajectory.
+             * @return true/false in case of success/failure
+             */
+            bool initialize(const double samplingTime, const double smoothingTime,
+                            const Vector& initialPosition = Vector::Zero())
+            {
+                if(samplingTime <= 0 || smoothingTime <= 0)
+                {
+                    std::cerr << "[EigenUtilities::MinimumJerkTrajectory::initialize] The sampling and "
+                              << "the smoothing times have to be positive numbers." << std::endl;
+                    return false;
+                }
+
+                const double a = -150.0 / (smoothingTime * smoothingTime * smoothingTime);
+                const double b = -60.0 / (smoothingTime * smoothingTime);
+                const double c = -9.0 / smoothingTime;
+
+                // continuous time system augmented with the (constant) input
+                AugmentedMatrix continuous = AugmentedMatrix::Zero();
+                continuous(0, 1) = 1.0;
+                continuous(1, 2) = 1.0;
+                continuous(2, 0) = a;
+                continuous(2, 1) = b;
+                continuous(2, 2) = c;
+                continuous(2, 3) = -a;
+
+                // zero order hold discretization
+                const AugmentedMatrix discrete = exponential(continuous * samplingTime);
+                m_stateMatrix = discrete.template topLeftCorner<3, 3>();
+                m_inputMatrix = discrete.template topRightCorner<3, 1>();
+
+                m_isInitialized = true;
+                reset(initialPosition);
+
+                return true;
+            }
+
+            /**
+             * Return true if the trajectory has been initialized.
+             */
+            bool isInitialized() const
+            {
+                return m_isInitialized;
+            }
+
+            /**
+             * Reset the trajectory. Velocity and acceleration are set to zero.
+             * @param initialPosition new position of the trajectory.
+             */
+            template <typename Derived>
+            void reset(const Eigen::MatrixBase<Derived>& initialPosition)
+            {
+                m_state.setZero();
+                m_state.row(0) = initialPosition.transpose();
+            }
+
+            /**
+             * Advance the trajectory of one sampling time.
+             * @param target the desired target.
+             */
+            template <typename Derived>
+            void computeNextValues(const Eigen::MatrixBase<Derived>& target)
+            {
+                m_state = m_stateMatrix * m_state + m_inputMatrix * target.transpose();
+            }
+
+            /**
+             * Get the position of the trajectory.
+             */
+            auto getPosition() const
+            {
+                return m_state.row(0).transpose();
+            }
+
+            /**
+             * Get the velocity of the trajectory.
+             */
+            auto getVelocity() const
+            {
+                return m_state.row(1).transpose();
+            }
+
+            /**
+             * Get the acceleration of the trajectory.
+             */
+            auto getAcceleration() const
+            {
+                return m_state.row(2).transpose();
+            }
+        };
+    }
+};
+
+#endif
@@ -0,0 +1,327 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_EIGEN_UTILITIES_VELOCITY_ESTIMATOR_H
+#define WALKING_CONTROLLERS_EIGEN_UTILITIES_VELOCITY_ESTIMATOR_H
+
+// std
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+// Eigen
+#include <Eigen/Core>
+
+namespace WalkingControllers
+{
+
+/**
+ * Helper for Eigen library.
+ */
+    namespace EigenUtilities
+    {
+        /**
+         * VelocityEstimator estimates the velocities of a set of channels from their timestamped
+         * positions. Two estimators are available:
+         * - the first order adaptive windowing (FOAW): the velocity is the slope of the least
+         * squares line fitting the longest window of samples whose distance from the line is
+         * lower than the noise bound;
+         * - a Kalman filter with a constant velocity model driven by a white acceleration noise.
+         * The timestamps can differ among the channels. A channel whose timestamp did not advance
+         * is not updated. All the channels are processed at once with coefficient-wise operations,
+         * hence they are vectorized by Eigen. The memory is allocated only by the initialization.
+         * The latency of the estimate is the delay of the estimated velocity with respect to the
+         * velocity of a signal with constant acceleration.
+         */
+        class VelocityEstimator
+        {
+        public:
+            /**
+             * Estimation method.
+             */
+            enum class Method
+            {
+                AdaptiveWindow,
+                Kalman
+            };
+
+        private:
+            using Mask = Eigen::Array<bool, Eigen::Dynamic, 1>;
+            using Counts = Eigen::Array<Eigen::Index, Eigen::Dynamic, 1>;
+
+            Method m_method{Method::AdaptiveWindow}; /**< Estimation method. */
+            bool m_isInitialized{false}; /**< True if the estimator was initialized. */
+
+            Eigen::VectorXd m_velocity; /**< Estimated velocities. */
+            Eigen::VectorXd m_latency; /**< Latency of the estimated velocities. */
+
+            // adaptive window (a column for each sample of the window, from the newest to the
+            // oldest one). The window of a channel is shifted only when its timestamp advances
+            double m_noiseBound{0}; /**< Maximum distance of the samples from the fitted line. */
+            Eigen::ArrayXXd m_positions; /**< Positions in the window. */
+            Eigen::ArrayXXd m_times; /**< Timestamps in the window. */
+            Counts m_samples; /**< Number of samples in the window of each channel. */
+            Eigen::ArrayXd m_dt, m_dy; /**< Sample relative to the newest one. */
+            Eigen::ArrayXd m_sumT, m_sumY, m_sumTT, m_sumTY; /**< Sums of the least squares problem. */
+            Eigen::ArrayXd m_determinant, m_slope, m_intercept; /**< Fitted line. */
+            Mask m_fits; /**< True if the samples of the window are close to the line. */
+            Mask m_growing; /**< True if the window of the channel can be enlarged. */
+
+            // Kalman filter
+            double m_accelerationVariance{0}; /**< Spectral density of the acceleration noise. */
+            double m_measurementVariance{0}; /**< Variance of the position noise. */
+            Eigen::ArrayXd m_position; /**< Estimated positions. */
+            Eigen::ArrayXd m_lastTimes; /**< Timestamps of the last update. */
+            Eigen::ArrayXd m_p00, m_p01, m_p11; /**< Covariance of the estimate. */
+            Eigen::ArrayXd m_k0, m_k1, m_innovation; /**< Kalman gains and innovation. */
+            Mask m_newSample; /**< True if the timestamp of the channel advanced. */
+
+            void resize(const std::size_t channels)
+            {
+                const Eigen::Index size = static_cast<Eigen::Index>(channels);
+                m_velocity.setZero(size);
+                m_latency.setZero(size);
+                for (Eigen::ArrayXd* array : {&m_dt, &m_dy, &m_sumT, &m_sumY, &m_sumTT, &m_sumTY,
+                                              &m_determinant, &m_slope, &m_intercept, &m_position,
+                                              &m_lastTimes, &m_p00, &m_p01, &m_p11, &m_k0, &m_k1,
+                                              &m_innovation})
+                    array->setZero(size);
+                m_fits.setConstant(size, false);
+                m_growing.setConstant(size, false);
+                m_newSample.setConstant(size, false);
+            }
+
+            template <typename PositionDerived, typename TimeDerived>
+            void updateAdaptiveWindow(const Eigen::MatrixBase<PositionDerived>& positions,
+                                      const Eigen::MatrixBase<TimeDerived>& timestamps)
+            {
+                // the channels whose timestamp did not advance are not updated
+                const Eigen::Index capacity = m_positions.cols();
+                m_newSample = m_samples == 0 || timestamps.array() > m_times.col(0);
+                if(!m_newSample.any())
+                    return;
+
+                for (Eigen::Index column = capacity - 1; column > 0; column--)
+                {
+                    m_positions.col(column) = m_newSample.select(m_positions.col(column - 1), m_positions.col(column));
+                    m_times.col(column) = m_newSample.select(m_times.col(column - 1), m_times.col(column));
+                }
+                m_positions.col(0) = m_newSample.select(positions.array(), m_positions.col(0));
+                m_times.col(0) = m_newSample.select(timestamps.array(), m_times.col(0));
+                m_samples = m_newSample.select((m_samples + 1).min(capacity), m_samples);
+
+                // the samples are relative to the newest one, the window grows while the line fits
+                m_sumT.setZero();
+                m_sumY.setZero();
+                m_sumTT.setZero();
+                m_sumTY.setZero();
+                m_growing = m_newSample;
+                for (Eigen::Index n = 1; n < capacity; n++)
+                {
+                    m_growing = m_growing && m_samples > n;
+                    if(!m_growing.any())
+                        break;
+
+                    m_dt = m_times.col(n) - m_times.col(0);
+                    m_dy = m_positions.col(n) - m_positions.col(0);
+                    m_sumT += m_dt;
+                    m_sumY += m_dy;
+                    m_sumTT += m_dt * m_dt;
+                    m_sumTY += m_dt * m_dy;
+
+                    const double count = static_cast<double>(n + 1);
+                    m_determinant = count * m_sumTT - m_sumT * m_sumT;
+                    m_fits = m_determinant > 1e-12;
+                    m_slope = m_fits.select((count * m_sumTY - m_sumT * m_sumY) / m_determinant, 0.0);
+                    m_intercept = (m_sumY - m_slope * m_sumT) / count;
+
+                    // the distance of the newest sample from the line is the intercept
+                    m_fits = m_fits && m_intercept.abs() <= m_noiseBound;
+                    for (Eigen::Index i = 1; i <= n; i++)
+                    {
+                        m_fits = m_fits
+                                 && ((m_positions.col(i) - m_positions.col(0)) - m_intercept
+                                     - m_slope * (m_times.col(i) - m_times.col(0)))
+                                            .abs() <= m_noiseBound;
+                    }
+
+                    // the least squares slope is the velocity at the mean time of the window
+                    m_growing = m_growing && m_fits;
+                    m_velocity = m_growing.select(m_slope, m_velocity.array()).matrix();
+                    m_latency = m_growing.select(-m_sumT / count, m_latency.array()).matrix();
+                }
+            }
+
+            template <typename PositionDerived, typename TimeDerived>
+            void updateKalman(const Eigen::MatrixBase<PositionDerived>& positions,
+                              const Eigen::MatrixBase<TimeDerived>& timestamps)
+            {
+                const double q = m_accelerationVariance;
+                m_dt = timestamps.array() - m_lastTimes;
+                m_newSample = m_dt > 0;
+                m_dt = m_newSample.select(m_dt, 0.0);
+                m_lastTimes = m_newSample.select(timestamps.array(), m_lastTimes);
+
+                // prediction
+                m_position += m_dt * m_velocity.array();
+                m_p00 += m_dt * (2 * m_p01 + m_dt * m_p11) + q * m_dt * m_dt * m_dt / 3;
+                m_p01 += m_dt * m_p11 + q * m_dt * m_dt / 2;
+                m_p11 += q * m_dt;
+
+                // correction of the channels with a new sample
+                m_k0 = m_newSample.select(m_p00 / (m_p00 + m_measurementVariance), 0.0);
+                m_k1 = m_newSample.select(m_p01 / (m_p00 + m_measurementVariance), 0.0);
+                m_innovation = positions.array() - m_position;
+                m_position += m_k0 * m_innovation;
+                m_velocity.array() += m_k1 * m_innovation;
+                m_p11 -= m_k1 * m_p01;
+                m_p01 *= 1 - m_k0;
+                m_p00 *= 1 - m_k0;
+
+                // the velocity error of the filter with a constant acceleration a is a (k0 / k1 - dt / 2)
+                m_newSample = m_newSample && m_k1 > 0;
+                m_latency = m_newSample.select(m_k0 / m_k1 - m_dt / 2, m_latency.array()).matrix();
+            }
+
+        public:
+
+            /**
+             * Initialize the first order adaptive windowing estimator.
+             * @param channels number of channels;
+             * @param maxWindow maximum number of intervals of the window;
+             * @param noiseBound maximum distance of the samples from the fitted line (it is
+             * the amplitude of the position noise).
+             * @return true/false in case of success/failure
+             */
+            bool initializeAdaptiveWindow(const std::size_t channels, const int maxWindow, const double noiseBound)
+            {
+                if(maxWindow < 1 || noiseBound <= 0)
+                {
+                    std::cerr << "[EigenUtilities::VelocityEstimator::initializeAdaptiveWindow] The window and "
+                              << "the noise bound have to be positive numbers." << std::endl;
+                    return false;
+                }
+
+                m_method = Method::AdaptiveWindow;
+                m_noiseBound = noiseBound;
+                resize(channels);
+                m_positions.setZero(static_cast<Eigen::Index>(channels), maxWindow + 1);
+                m_times.setZero(static_cast<Eigen::Index>(channels), maxWindow + 1);
+                m_samples.setZero(static_cast<Eigen::Index>(channels));
+
+                m_isInitialized = true;
+                return true;
+            }
+
+            /**
+             * Initialize the Kalman filter estimator.
+             * @param channels number of channels;
+             * @param accelerationNoise standard deviation of the acceleration noise (its spectral
+             * density is the square of it);
+             * @param measurementNoise standard deviation of the position noise.
+             * @return true/false in case of success/failure
+             */
+            bool initializeKalman(const std::size_t channels, const double accelerationNoise,
+                                  const double measurementNoise)
+            {
+                if(accelerationNoise <= 0 || measurementNoise <= 0)
+                {
+                    std::cerr << "[EigenUtilities::VelocityEstimator::initializeKalman] The standard deviations "
+                              << "of the noises have to be positive numbers." << std::endl;
+                    return false;
+                }
+
+                m_method = Method::Kalman;
+                m_accelerationVariance = accelerationNoise * accelerationNoise;
+                m_measurementVariance = measurementNoise * measurementNoise;
+                resize(channels);
+                m_positions.resize(0, 0);
+                m_times.resize(0, 0);
+                m_samples.resize(0);
+
+                m_isInitialized = true;
+                return true;
+            }
+
+            /**
+             * Return true if the estimator has been initialized.
+             */
+            bool isInitialized() const
+            {
+                return m_isInitialized;
+            }
+
+            /**
+             * Get the estimation method.
+             */
+            Method getMethod() const
+            {
+                return m_method;
+            }
+
+            /**
+             * Reset the estimator. The velocities are set to zero.
+             * @param positions current positions;
+             * @param timestamps current timestamps of the positions.
+             */
+            template <typename PositionDerived, typename TimeDerived>
+            void reset(const Eigen::MatrixBase<PositionDerived>& positions,
+                       const Eigen::MatrixBase<TimeDerived>& timestamps)
+            {
+                m_velocity.setZero();
+                m_latency.setZero();
+
+                if(m_method == Method::AdaptiveWindow)
+                {
+                    m_samples.setOnes();
+                    m_positions.col(0) = positions.array();
+                    m_times.col(0) = timestamps.array();
+                    return;
+                }
+
+                // the velocity is unknown, its variance is the one of a second of acceleration noise
+                m_position = positions.array();
+                m_lastTimes = timestamps.array();
+                m_p00.setConstant(m_measurementVariance);
+                m_p01.setZero();
+                m_p11.setConstant(m_accelerationVariance);
+            }
+
+            /**
+             * Update the estimate with a new sample.
+             * @param positions current positions;
+             * @param timestamps current timestamps of the positions.
+             * @return the estimated velocities.
+             */
+            template <typename PositionDerived, typename TimeDerived>
+            const Eigen::VectorXd& update(const Eigen::MatrixBase<PositionDerived>& positions,
+                                          const Eigen::MatrixBase<TimeDerived>& timestamps)
+            {
+                if(m_method == Method::AdaptiveWindow)
+                    updateAdaptiveWindow(positions, timestamps);
+                else
+                    updateKalman(positions, timestamps);
+
+                return m_velocity;
+            }
+
+            /**
+             * Get the estimated velocities.
+             */
+            const Eigen::VectorXd& get() const
+            {
+                return m_velocity;
+            }
+
+            /**
+             * Get the latency of the estimated velocities (in the unit of the timestamps).
+             */
+            const Eigen::VectorXd& getLatency() const
+            {
+                return m_latency;
+            }
+        };
+    }
+};
+
+#endif
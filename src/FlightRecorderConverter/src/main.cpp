@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// YARP
+#include <yarp/os/LogStream.h>
+#include <yarp/os/ResourceFinder.h>
+
+// iDynTree
+#include <iDynTree/Rotation.h>
+#include <iDynTree/VectorFixSize.h>
+
+// matioCpp
+#include <matioCpp/matioCpp.h>
+
+#include <WalkingControllers/WalkingLogger/FlightRecorder.h>
+
+using namespace WalkingControllers;
+
+namespace
+{
+    /**
+     * Node of the tree obtained splitting the names of the channels at "::".
+     */
+    struct Node
+    {
+        std::map<std::string, Node> children; /**< Children of the node. */
+        const LoggedChannel* channel{nullptr}; /**< Channel stored in the leaf. */
+    };
+
+    /**
+     * Convert a channel in the signal structure used by the YarpRobotLoggerDevice.
+     */
+    matioCpp::Struct convertChannel(const std::string& name, const std::string& fullName,
+                                    const LoggedChannel& channel, const FlightRecorderReader& reader)
+    {
+        const size_t numberOfRecords = reader.getNumberOfRecords();
+        const size_t numberOfElements = channel.metadata.size();
+
+        // the data are stored as a (elements x 1 x samples) column major matrix
+        std::vector<double> data(numberOfElements * numberOfRecords);
+        std::vector<double> timestamps(numberOfRecords);
+        for(size_t i = 0; i < numberOfRecords; i++)
+        {
+            const double* record = reader.getRecord(i);
+            timestamps[i] = record[0];
+
+            if(channel.type == LoggedChannelType::Rotation)
+            {
+                iDynTree::Rotation rotation;
+                std::memcpy(rotation.data(), record + channel.offset, 9 * sizeof(double));
+                const iDynTree::Vector3 rpy = rotation.asRPY();
+                std::memcpy(data.data() + i * numberOfElements, rpy.data(), 3 * sizeof(double));
+            }
+            else
+                std::memcpy(data.data() + i * numberOfElements, record + channel.offset,
+                            numberOfElements * sizeof(double));
+        }
+
+        std::vector<matioCpp::Variable> elementsNames;
+        for(const auto& element : channel.metadata)
+            elementsNames.emplace_back(matioCpp::String(element, element));
+
+        matioCpp::Vector<double> dimensions("dimensions", 2);
+        dimensions(0) = static_cast<double>(numberOfElements);
+        dimensions(1) = 1;
+
+        std::vector<matioCpp::Variable> fields;
+        fields.emplace_back(matioCpp::MultiDimensionalArray<double>("data", {numberOfElements, 1, numberOfRecords},
+                                                                    data.data()));
+        fields.emplace_back(dimensions);
+        fields.emplace_back(matioCpp::CellArray("elements_names", {numberOfElements, 1}, elementsNames));
+        fields.emplace_back(matioCpp::String("name", fullName));
+        fields.emplace_back(matioCpp::Vector<double>("timestamps", matioCpp::make_span(timestamps)));
+
+        return matioCpp::Struct(name, fields);
+    }
+
+    /**
+     * Convert a node of the tree in a structure.
+     */
+    matioCpp::Struct convertNode(const std::string& name, const std::string& fullName,
+                                 const Node& node, const FlightRecorderReader& reader)
+    {
+        std::vector<matioCpp::Variable> fields;
+        for(const auto& [childName, child] : node.children)
+        {
+            const std::string childFullName = fullName.empty() ? childName : fullName + "::" + childName;
+            if(child.channel != nullptr)
+                fields.emplace_back(convertChannel(childName, childFullName, *child.channel, reader));
+            else
+                fields.emplace_back(convertNode(childName, childFullName, child, reader));
+        }
+
+        return matioCpp::Struct(name, fields);
+    }
+}
+
+/**
+ * Convert a file written by the flight recorder of the walking module in a mat file having the
+ * same structure of the files written by the YarpRobotLoggerDevice, i.e.
+ * robot_logger_device.<name>.<channel>.{data, dimensions, elements_names, name, timestamps}.
+ * Usage: WalkingFlightRecorderConverter --input file.wcfr --output file.mat [--name walking]
+ */
+int main(int argc, char * argv[])
+{
+    yarp::os::ResourceFinder rf;
+    rf.configure(argc, argv);
+
+    if(!rf.check("input") || !rf.check("output"))
+    {
+        yError() << "[main] Usage: WalkingFlightRecorderConverter --input file.wcfr --output file.mat [--name walking]";
+        return EXIT_FAILURE;
+    }
+
+    const std::string input = rf.find("input").asString();
+    const std::string output = rf.find("output").asString();
+    const std::string name = rf.check("name", yarp::os::Value("walking")).asString();
+
+    FlightRecorderReader reader;
+    if(!reader.open(input))
+    {
+        yError() << "[main] Unable to open the file" << input;
+        return EXIT_FAILURE;
+    }
+
+    if(reader.getNumberOfRecords() == 0)
+    {
+        yError() << "[main] The file" << input << "does not contain any record.";
+        return EXIT_FAILURE;
+    }
+
+    // build the tree of the channels
+    Node root;
+    for(const auto& channel : reader.getChannels())
+    {
+        Node* node = &root;
+        size_t begin = 0;
+        size_t end;
+        while((end = channel.name.find("::", begin)) != std::string::npos)
+        {
+            node = &node->children[channel.name.substr(begin, end - begin)];
+            begin = end + 2;
+        }
+        node->children[channel.name.substr(begin)].channel = &channel;
+    }
+
+    matioCpp::File file = matioCpp::File::Create(output);
+    if(!file.isOpen())
+    {
+        yError() << "[main] Unable to create the file" << output;
+        return EXIT_FAILURE;
+    }
+
+    const matioCpp::Struct robotLoggerDevice("robot_logger_device",
+                                             {convertNode(name, "", root, reader)});
+    if(!file.write(robotLoggerDevice))
+    {
+        yError() << "[main] Unable to write the file" << output;
+        return EXIT_FAILURE;
+    }
+
+    yInfo() << "[main]" << reader.getNumberOfRecords() << "records converted in" << output;
+    return EXIT_SUCCESS;
+}
@@ -14,26 +14,82 @@
 #include <iDynTree/KinDynComputations.h>
 #include <iDynTree/FreeFloatingState.h>
 
-// iCub-ctrl
-#include <iCub/ctrl/filters.h>
+#include <WalkingControllers/EigenUtilities/FilterBank.h>
 
-#include <unordered_map>
+#include <array>
+#include <vector>
 
 namespace WalkingControllers
 {
 
+    /**
+     * WalkingFK evaluates the forward kinematics of the robot. It keeps two independent kinematic
+     * states: the measured one (set by setInternalRobotState()) and the desired one (set by
+     * setDesiredRobotState()). Each state has its own KinDynComputations object, hence its own
+     * cache of the forward kinematics, and the getters refer to the state selected with
+     * useKinematicState(). Switching between the states does not invalidate the caches.
+     * The world transforms of the frames used in a tick are registered in a frame set (addFrame())
+     * and they are evaluated together, at the first query after the state is set. The
+     * transforms are then read by index (getWorldTransform()).
+     */
     class WalkingFK
     {
-        std::shared_ptr<iDynTree::KinDynComputations> m_kinDyn; /**< KinDynComputations solver. */
+    public:
+
+        /**
+         * Kinematic states of the robot.
+         */
+        enum class KinematicState {Measured = 0, Desired = 1};
+
+    private:
+
+        /**
+         * Kinematics and cached quantities of a state of the robot.
+         */
+        struct StateCache
+        {
+            std::shared_ptr<iDynTree::KinDynComputations> kinDyn; /**< KinDynComputations solver. */
+            bool dcmEvaluated{false}; /**< is the DCM evaluated? */
+            bool comEvaluated{false}; /**< is the CoM evaluated? */
+            iDynTree::Position comPosition; /**< Position of the CoM. */
+            iDynTree::Vector3 comVelocity; /**< Velocity of the CoM. */
+            iDynTree::Vector2 dcm; /**< DCM position. */
+            bool framesEvaluated{false}; /**< are the transforms of the frame set evaluated? */
+            std::vector<iDynTree::Transform> worldTransforms; /**< World transforms of the frame set. */
+        };
+
+        /**
+         * Frames registered in the frame set by initialize(), in this order.
+         */
+        enum FrameSetIndex : std::size_t {LeftFootFrame = 0, RightFootFrame, LeftHandFrame,
+                                          RightHandFrame, HeadFrame, RootFrame, NeckFrame};
+
+        /**
+         * Candidates of the floating base.
+         */
+        enum BaseFrameIndex : std::size_t {LeftFootBase = 0, RightFootBase, RootBase};
+
+        /**
+         * Floating base candidate, resolved once by initialize().
+         */
+        struct BaseFrame
+        {
+            iDynTree::FrameIndex frameIndex{iDynTree::FRAME_INVALID_INDEX}; /**< Index of the frame. */
+            iDynTree::LinkIndex linkIndex{iDynTree::LINK_INVALID_INDEX}; /**< Index of the link of the frame. */
+            std::string linkName; /**< Name of the link of the frame. */
+            iDynTree::Transform frameToLink; /**< Transformation between the frame and its link. */
+        };
+
+        StateCache m_measuredState; /**< Measured state of the robot. */
+        StateCache m_desiredState; /**< Desired state of the robot. */
+        StateCache* m_activeState{&m_measuredState}; /**< State used by the getters. */
+        std::shared_ptr<iDynTree::KinDynComputations> m_kinDyn; /**< KinDynComputations solver of the active state. */
 
         bool m_useExternalRobotBase; /**< is external estimator for the base of robot used? */
         iDynTree::FreeFloatingGeneralizedTorques m_generalizedBiasForces;
 
         bool m_prevContactLeft; /**< Boolean is the previous contact foot the left one? */
-        bool m_dcmEvaluated; /**< is the DCM evaluated? */
-        bool m_comEvaluated; /**< is the CoM evaluated? */
 
-        iDynTree::FrameIndex m_frameBaseIndex;
         iDynTree::FrameIndex m_frameLeftIndex; /**< Index of the frame attached to the left foot in which all the left foot transformations are expressed. */
         iDynTree::FrameIndex m_frameRightIndex; /**< Index of the frame attached to the right foot in which all the right foot transformations are expressed. */
         iDynTree::FrameIndex m_frameRootIndex; /**< Index of the frame attached to the root_link. */
@@ -41,6 +97,7 @@ namespace WalkingControllers
         iDynTree::FrameIndex m_frameLeftHandIndex; /**< Index of the frame attached to the left hand. */
         iDynTree::FrameIndex m_frameRightHandIndex; /**< Index of the frame attached to the right hand. */
         iDynTree::FrameIndex m_frameHeadIndex; /**< Index of the frame attached to the head. */
+        std::vector<iDynTree::FrameIndex> m_frameSet; /**< Frames whose world transforms are evaluated together. */
 
         std::string m_baseFrameLeft; /**< Name of the left base frame. */
         std::string m_baseFrameRight;  /**< Name of the right base frame. */
@@ -48,16 +105,16 @@ namespace WalkingControllers
         iDynTree::Transform m_frameHlinkLeft; /**< Transformation between the l_sole and the l_foot frame (l_ankle_2?!). */
         iDynTree::Transform m_frameHlinkRight; /**< Transformation between the l_sole and the l_foot frame (l_ankle_2?!). */
         iDynTree::Transform m_worldToBaseTransform; /**< World to base transformation. */
-        std::unordered_map<std::string, std::pair<const std::string, const iDynTree::Transform>> m_baseFrames;/**< Transform related to the base frame */
+        std::array<BaseFrame, 3> m_baseFrames; /**< Floating base candidates (indexed by BaseFrameIndex). */
+        iDynTree::LinkIndex m_floatingBaseIndex{iDynTree::LINK_INVALID_INDEX}; /**< Link used as floating base. */
         iDynTree::Twist m_baseTwist;/**< twist related to base frame */
 
-        iDynTree::Position m_comPosition; /**< Position of the CoM. */
-        iDynTree::Vector3 m_comVelocity; /**< Velocity of the CoM. */
-        iDynTree::Vector2 m_dcm; /**< DCM position. */
         double m_omega; /**< Inverted time constant of the 3D-LIPM. */
 
-        std::unique_ptr<iCub::ctrl::FirstOrderLowPassFilter> m_comPositionFilter; /**< CoM position low pass filter. */
-        std::unique_ptr<iCub::ctrl::FirstOrderLowPassFilter> m_comVelocityFilter; /**< CoM velocity low pass filter. */
+        // the filters are applied only to the CoM of the measured state
+        EigenUtilities::FilterBank m_comFilters; /**< Low pass filters of the CoM position and velocity. */
+        std::size_t m_comPositionFilterOffset{0}; /**< Index of the CoM position in the filter bank. */
+        std::size_t m_comVelocityFilterOffset{0}; /**< Index of the CoM velocity in the filter bank. */
         iDynTree::Position m_comPositionFiltered; /**< Filtered position of the CoM. */
         iDynTree::Vector3 m_comVelocityFiltered; /**< Filtered velocity of the CoM. */
         bool m_useFilters; /**< If it is true the filters will be used. */
@@ -84,12 +141,36 @@ namespace WalkingControllers
         bool setBaseFrames(const std::string& lFootFrame, const std::string& rFootFrame);
 
         /**
-         * Set The base frames for enabling using Gazebo as a base estimator.
+         * Resolve a floating base candidate.
          * @param baseFrame the frame name inside model;
-         * @param name label for storing the frame information;
+         * @param index the candidate.
+         * @return true/false in case of success/failure.
+         */
+        bool setBaseFrame(const std::string& baseFrame, const BaseFrameIndex& index);
+
+        /**
+         * Set the floating base of the KinDynComputations objects of both the states. Nothing is
+         * done if the link of the candidate is already the floating base.
+         * @param index the floating base candidate.
          * @return true/false in case of success/failure.
          */
-        bool setBaseFrame(const std::string& baseFrame, const std::string& name);
+        bool setFloatingBase(const BaseFrameIndex& index);
+
+        /**
+         * Set the joint state of a kinematic state of the robot.
+         * @param state the kinematic state;
+         * @param positionInRadians joint position expressed in radians;
+         * @param velocityInRadians joint velocity expressed in radians per seconds.
+         * @return true/false in case of success/failure.
+         */
+        bool setRobotState(StateCache& state,
+                           const iDynTree::VectorDynSize& positionInRadians,
+                           const iDynTree::VectorDynSize& velocityInRadians);
+
+        /**
+         * Invalidate the CoM, the DCM and the frame set of both the states.
+         */
+        void invalidateStates();
 
         /**
          * Evaluate the Divergent component of motion.
@@ -141,13 +222,66 @@ namespace WalkingControllers
         bool setBaseOnTheFly();
 
         /**
-         * Set the internal state of the robot (joint position and velocity)
+         * Set the measured state of the robot (joint position and velocity)
          * @param positionFeedbackInRadians joint position feedback expressed in radians;
          * @param velocityFeedbackInRadians joint velocity feedback expressed in radians per seconds.
          */
         bool setInternalRobotState(const iDynTree::VectorDynSize& positionFeedbackInRadians,
                                    const iDynTree::VectorDynSize& velocityFeedbackInRadians);
 
+        /**
+         * Set the desired state of the robot (joint position and velocity). The measured state is
+         * not modified. The base of the desired state is the same of the measured one.
+         * @param positionInRadians desired joint position expressed in radians;
+         * @param velocityInRadians desired joint velocity expressed in radians per seconds.
+         */
+        bool setDesiredRobotState(const iDynTree::VectorDynSize& positionInRadians,
+                                  const iDynTree::VectorDynSize& velocityInRadians);
+
+        /**
+         * Select the state used by the getters. The cached quantities of both the states are
+         * preserved. The CoM of the desired state is never filtered.
+         * @param state the kinematic state.
+         */
+        void useKinematicState(const KinematicState& state);
+
+        /**
+         * Get the state used by the getters.
+         * @return the kinematic state.
+         */
+        KinematicState getKinematicState() const;
+
+        /**
+         * Add a frame to the frame set. The frames have to be added after initialize() and before
+         * the control loop (it allocates memory). The feet, the hands, the head, the root and the
+         * neck frames are added by initialize().
+         * @param frameName name of the frame;
+         * @param index index of the frame in the frame set.
+         * @return true/false in case of success/failure.
+         */
+        bool addFrame(const std::string& frameName, std::size_t& index);
+
+        /**
+         * Get the number of frames of the frame set.
+         */
+        std::size_t getNumberOfFrames() const;
+
+        /**
+         * Evaluate the world transforms of all the frames of the frame set of the active state.
+         * It is called by the getters, it has to be called explicitly before the transforms are
+         * read by concurrent threads.
+         */
+        void evaluateFrameSet();
+
+        /**
+         * Return the transformation between a frame of the frame set and the world reference
+         * frame. The transforms of all the frames are evaluated at the first call after the
+         * state is set.
+         * @param index index of the frame in the frame set.
+         * @return world_H_frame.
+         */
+        const iDynTree::Transform& getWorldTransform(const std::size_t& index);
+
         /**
          * Get the CoM position.
          * @return CoM position
@@ -170,37 +304,37 @@ namespace WalkingControllers
          * Return the transformation between the left foot frame (l_sole) and the world reference frame.
          * @return world_H_left_frame.
          */
-        iDynTree::Transform getLeftFootToWorldTransform();
+        const iDynTree::Transform& getLeftFootToWorldTransform();
 
         /**
          * Return the transformation between the right foot frame (r_sole) and the world reference frame.
          * @return world_H_right_frame.
          */
-        iDynTree::Transform getRightFootToWorldTransform();
+        const iDynTree::Transform& getRightFootToWorldTransform();
 
         /**
          * Return the transformation between the left hand frame and the world reference frame.
          * @return world_H_left_hand.
          */
-        iDynTree::Transform getLeftHandToWorldTransform();
+        const iDynTree::Transform& getLeftHandToWorldTransform();
 
         /**
          * Return the transformation between the right hand frame and the world reference frame.
          * @return world_H_right_hand.
          */
-        iDynTree::Transform getRightHandToWorldTransform();
+        const iDynTree::Transform& getRightHandToWorldTransform();
 
         /**
          * Return the transformation between the head frame and the world reference frame.
          * @return world_H_head.
          */
-        iDynTree::Transform getHeadToWorldTransform();
+        const iDynTree::Transform& getHeadToWorldTransform();
 
         /**
          * Return the transformation between the root frame and the world reference frame.
          * @return world_H_root_frame.
          */
-        iDynTree::Transform getRootLinkToWorldTransform();
+        const iDynTree::Transform& getRootLinkToWorldTransform();
 
         /**
          * Return the root link velocity.
@@ -212,7 +346,7 @@ namespace WalkingControllers
          * Return the neck orientation.
          * @return the rotation matrix between the neck and the reference frame.
          */
-        iDynTree::Rotation getNeckOrientation();
+        const iDynTree::Rotation& getNeckOrientation();
 
         /**
          * Get the left foot jacobian.
@@ -263,7 +397,17 @@ namespace WalkingControllers
          */
         const iDynTree::VectorDynSize& getJointPos();
 
+        /**
+         * Get the KinDynComputations object of the active state.
+         */
         std::shared_ptr<iDynTree::KinDynComputations> getKinDyn();
+
+        /**
+         * Get the KinDynComputations object of a state. The object is not modified when the
+         * other state is set.
+         * @param state the kinematic state.
+         */
+        std::shared_ptr<iDynTree::KinDynComputations> getKinDyn(const KinematicState& state);
     };
 };
 #endif
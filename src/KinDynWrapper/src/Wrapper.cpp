@@ -23,13 +23,16 @@ using namespace WalkingControllers;
 
 bool WalkingFK::setRobotModel(const iDynTree::Model& model)
 {
-    if(!m_kinDyn->loadRobotModel(model))
+    for(StateCache* state : {&m_measuredState, &m_desiredState})
     {
-        yError() << "[WalkingFK::setRobotModel] Error while loading into KinDynComputations object.";
-        return false;
-    }
+        if(!state->kinDyn->loadRobotModel(model))
+        {
+            yError() << "[WalkingFK::setRobotModel] Error while loading into KinDynComputations object.";
+            return false;
+        }
 
-    m_kinDyn->setFrameVelocityRepresentation(iDynTree::MIXED_REPRESENTATION);
+        state->kinDyn->setFrameVelocityRepresentation(iDynTree::MIXED_REPRESENTATION);
+    }
 
     // initialize some quantities needed for the first step
     m_prevContactLeft = false;
@@ -37,7 +40,7 @@ bool WalkingFK::setRobotModel(const iDynTree::Model& model)
     return true;
 }
 
-bool WalkingFK::setBaseFrame(const std::string& baseFrame, const std::string& name)
+bool WalkingFK::setBaseFrame(const std::string& baseFrame, const BaseFrameIndex& index)
 {
     if(!m_kinDyn->isValid())
     {
@@ -50,18 +53,16 @@ bool WalkingFK::setBaseFrame(const std::string& baseFrame, const std::string& na
     // - left_foot when the left foot is the stance foot;
     // - right_foot when the right foot is the stance foot.
     //.-.root when the external base supposed to be used
-    m_frameBaseIndex = m_kinDyn->model().getFrameIndex(baseFrame);
-    if(m_frameBaseIndex == iDynTree::FRAME_INVALID_INDEX)
+    BaseFrame& base = m_baseFrames[index];
+    base.frameIndex = m_kinDyn->model().getFrameIndex(baseFrame);
+    if(base.frameIndex == iDynTree::FRAME_INVALID_INDEX)
     {
         yError() << "[setBaseFrames] Unable to find the frame named: " << baseFrame;
         return false;
     }
-    iDynTree::LinkIndex linkBaseIndex = m_kinDyn->model().getFrameLink(m_frameBaseIndex);
-
-    std::string baseFrameName = m_kinDyn->model().getLinkName(linkBaseIndex);
-    m_baseFrames.insert({name, std::make_pair(baseFrameName,
-                                              m_kinDyn->getRelativeTransform(m_frameBaseIndex,
-                                                                            linkBaseIndex))});
+    base.linkIndex = m_kinDyn->model().getFrameLink(base.frameIndex);
+    base.linkName = m_kinDyn->model().getLinkName(base.linkIndex);
+    base.frameToLink = m_kinDyn->getRelativeTransform(base.frameIndex, base.linkIndex);
 
     return true;
 }
@@ -69,7 +70,9 @@ bool WalkingFK::setBaseFrame(const std::string& baseFrame, const std::string& na
 bool WalkingFK::initialize(const yarp::os::Searchable& config,
                            const iDynTree::Model& model)
 {
-    m_kinDyn = std::make_shared<iDynTree::KinDynComputations>();
+    m_measuredState.kinDyn = std::make_shared<iDynTree::KinDynComputations>();
+    m_desiredState.kinDyn = std::make_shared<iDynTree::KinDynComputations>();
+    useKinematicState(KinematicState::Measured);
 
     // check if the config is empty
     if(!setRobotModel(model))
@@ -183,17 +186,23 @@ bool WalkingFK::initialize(const yarp::os::Searchable& config,
         return false;
     }
 
+    // frames of the frame set, in the same order of the FrameSetIndex enum
+    m_frameSet = {m_frameLeftIndex, m_frameRightIndex, m_frameLeftHandIndex, m_frameRightHandIndex,
+                  m_frameHeadIndex, m_frameRootIndex, m_frameNeckIndex};
+    m_measuredState.worldTransforms.resize(m_frameSet.size());
+    m_desiredState.worldTransforms.resize(m_frameSet.size());
+
     m_useExternalRobotBase = config.check("use_external_robot_base", yarp::os::Value("False")).asBool();
 
     if(!m_useExternalRobotBase)
     {
-        if(!setBaseFrame(lFootFrame, "leftFoot"))
+        if(!setBaseFrame(lFootFrame, LeftFootBase))
         {
             yError() << "[initialize] Unable to set the leftFootFrame.";
             return false;
         }
 
-        if(!setBaseFrame(rFootFrame, "rightFoot"))
+        if(!setBaseFrame(rFootFrame, RightFootBase))
         {
             yError() << "[initialize] Unable to set the rightFootFrame.";
             return false;
@@ -205,14 +214,14 @@ bool WalkingFK::initialize(const yarp::os::Searchable& config,
     }
     else
     {
-        if(!setBaseFrame(rootFrame, "root"))
+        if(!setBaseFrame(rootFrame, RootBase))
         {
             yError() << "[initialize] Unable to set the rightFootFrame.";
             return false;
         }
 
         // in this specific case the base is always the root link
-        if(!m_kinDyn->setFloatingBase(m_baseFrames["root"].first))
+        if(!setFloatingBase(RootBase))
         {
             yError() << "[initialize] Unable to set the floating base";
             return false;
@@ -247,17 +256,18 @@ bool WalkingFK::initialize(const yarp::os::Searchable& config,
     m_comVelocityFiltered.zero();
     m_comPositionFiltered(2) = comHeight;
 
-
-    m_comPositionFilter = std::make_unique<iCub::ctrl::FirstOrderLowPassFilter>(cutFrequency, samplingTime);
-    m_comVelocityFilter = std::make_unique<iCub::ctrl::FirstOrderLowPassFilter>(cutFrequency, samplingTime);
+    if(!m_comFilters.initialize(samplingTime)
+       || !m_comFilters.addFirstOrderLowPass(3, cutFrequency, m_comPositionFilterOffset)
+       || !m_comFilters.addFirstOrderLowPass(3, cutFrequency, m_comVelocityFilterOffset))
+    {
+        yError() << "[WalkingFK::initialize] Unable to initialize the CoM filters.";
+        return false;
+    }
 
     // TODO this is wrong, we shold initialize the filter with a meaningful value;
-    yarp::sig::Vector buff(3);
-    iDynTree::toYarp(m_comPositionFiltered, buff);
-    m_comPositionFilter->init(buff);
-
-    iDynTree::toYarp(m_comVelocityFiltered, buff);
-    m_comVelocityFilter->init(buff);
+    m_comFilters.input(m_comPositionFilterOffset, 3) = iDynTree::toEigen(m_comPositionFiltered);
+    m_comFilters.input(m_comVelocityFilterOffset, 3) = iDynTree::toEigen(m_comVelocityFiltered);
+    m_comFilters.reset();
 
     m_useFilters = config.check("use_filters", yarp::os::Value(false)).asBool();
     m_firstStep = true;
@@ -275,12 +285,10 @@ void WalkingFK::evaluateWorldToBaseTransformation(const iDynTree::Transform& roo
         yWarning() << "[evaluateWorldToBaseTransformation] The base position is not retrieved from external. There is no reason to call this function.";
                        return;
     }
-    auto& base = m_baseFrames["root"];
-    m_worldToBaseTransform = rootTransform * base.second;
+    m_worldToBaseTransform = rootTransform * m_baseFrames[RootBase].frameToLink;
     m_baseTwist = rootTwist;
 
-    m_comEvaluated = false;
-    m_dcmEvaluated = false;
+    invalidateStates();
     return;
 }
 
@@ -300,12 +308,12 @@ bool WalkingFK::evaluateWorldToBaseTransformation(const iDynTree::Transform& lef
         // the right foot
         if(!m_prevContactLeft || m_firstStep)
         {
-            auto& base = m_baseFrames["leftFoot"];
-            m_worldToBaseTransform = leftFootTransform * base.second;
-            if(!m_kinDyn->setFloatingBase(base.first))
+            const BaseFrame& base = m_baseFrames[LeftFootBase];
+            m_worldToBaseTransform = leftFootTransform * base.frameToLink;
+            if(!setFloatingBase(LeftFootBase))
             {
                 yError() << "[evaluateWorldToBaseTransformation] Error while setting the floating "
-                         << "base on link " << base.first;
+                         << "base on link " << base.linkName;
                 return false;
             }
             m_prevContactLeft = true;
@@ -317,12 +325,12 @@ bool WalkingFK::evaluateWorldToBaseTransformation(const iDynTree::Transform& lef
         // the left foot
         if(m_prevContactLeft || m_firstStep)
         {
-            auto base = m_baseFrames["rightFoot"];
-            m_worldToBaseTransform = rightFootTransform * base.second;
-            if(!m_kinDyn->setFloatingBase(base.first))
+            const BaseFrame& base = m_baseFrames[RightFootBase];
+            m_worldToBaseTransform = rightFootTransform * base.frameToLink;
+            if(!setFloatingBase(RightFootBase))
             {
                 yError() << "[WalkingFK::evaluateWorldToBaseTransformation] Error while setting the floating "
-                         << "base on link " << base.first;
+                         << "base on link " << base.linkName;
                 return false;
             }
             m_prevContactLeft = false;
@@ -331,57 +339,166 @@ bool WalkingFK::evaluateWorldToBaseTransformation(const iDynTree::Transform& lef
 
     m_firstStep = false;
 
-    m_comEvaluated = false;
-    m_dcmEvaluated = false;
+    invalidateStates();
     return true;
 }
 
-bool WalkingFK::setInternalRobotState(const iDynTree::VectorDynSize& positionFeedbackInRadians,
-                                      const iDynTree::VectorDynSize& velocityFeedbackInRadians)
+bool WalkingFK::setFloatingBase(const BaseFrameIndex& index)
+{
+    const BaseFrame& base = m_baseFrames[index];
+
+    // the traversal of the model is rebuilt only if the floating base link changes (e.g. when the
+    // feet frames belong to the same link)
+    if(base.linkIndex == m_floatingBaseIndex)
+        return true;
+
+    invalidateStates();
+    if(!m_measuredState.kinDyn->setFloatingBase(base.linkName)
+       || !m_desiredState.kinDyn->setFloatingBase(base.linkName))
+    {
+        m_floatingBaseIndex = iDynTree::LINK_INVALID_INDEX;
+        return false;
+    }
+
+    m_floatingBaseIndex = base.linkIndex;
+    return true;
+}
+
+void WalkingFK::invalidateStates()
+{
+    for(StateCache* state : {&m_measuredState, &m_desiredState})
+    {
+        state->comEvaluated = false;
+        state->dcmEvaluated = false;
+        state->framesEvaluated = false;
+    }
+}
+
+bool WalkingFK::addFrame(const std::string& frameName, std::size_t& index)
+{
+    const iDynTree::FrameIndex frameIndex = m_measuredState.kinDyn->model().getFrameIndex(frameName);
+    if(frameIndex == iDynTree::FRAME_INVALID_INDEX)
+    {
+        yError() << "[WalkingFK::addFrame] Unable to find the frame named: " << frameName;
+        return false;
+    }
+
+    index = m_frameSet.size();
+    m_frameSet.push_back(frameIndex);
+    m_measuredState.worldTransforms.resize(m_frameSet.size());
+    m_desiredState.worldTransforms.resize(m_frameSet.size());
+    m_measuredState.framesEvaluated = false;
+    m_desiredState.framesEvaluated = false;
+    return true;
+}
+
+std::size_t WalkingFK::getNumberOfFrames() const
+{
+    return m_frameSet.size();
+}
+
+void WalkingFK::evaluateFrameSet()
+{
+    if(m_activeState->framesEvaluated)
+        return;
+
+    // the forward kinematics is evaluated by the first query, the others read its cache
+    for(std::size_t i = 0; i < m_frameSet.size(); i++)
+        m_activeState->worldTransforms[i] = m_kinDyn->getWorldTransform(m_frameSet[i]);
+
+    m_activeState->framesEvaluated = true;
+}
+
+const iDynTree::Transform& WalkingFK::getWorldTransform(const std::size_t& index)
+{
+    evaluateFrameSet();
+    return m_activeState->worldTransforms[index];
+}
+
+bool WalkingFK::setRobotState(StateCache& state,
+                              const iDynTree::VectorDynSize& positionInRadians,
+                              const iDynTree::VectorDynSize& velocityInRadians)
 {
     iDynTree::Vector3 gravity;
     gravity.zero();
     gravity(2) = -9.81;
 
-    if(!m_kinDyn->setRobotState(m_worldToBaseTransform, positionFeedbackInRadians,
-                               m_baseTwist, velocityFeedbackInRadians,
-                               gravity))
+    if(!state.kinDyn->setRobotState(m_worldToBaseTransform, positionInRadians,
+                                    m_baseTwist, velocityInRadians,
+                                    gravity))
+    {
+        return false;
+    }
+
+    state.comEvaluated = false;
+    state.dcmEvaluated = false;
+    state.framesEvaluated = false;
+
+    return true;
+}
+
+bool WalkingFK::setInternalRobotState(const iDynTree::VectorDynSize& positionFeedbackInRadians,
+                                      const iDynTree::VectorDynSize& velocityFeedbackInRadians)
+{
+    if(!setRobotState(m_measuredState, positionFeedbackInRadians, velocityFeedbackInRadians))
     {
         yError() << "[WalkingFK::setInternalRobotState] Error while updating the state.";
         return false;
     }
 
-    m_comEvaluated = false;
-    m_dcmEvaluated = false;
+    return true;
+}
+
+bool WalkingFK::setDesiredRobotState(const iDynTree::VectorDynSize& positionInRadians,
+                                     const iDynTree::VectorDynSize& velocityInRadians)
+{
+    if(!setRobotState(m_desiredState, positionInRadians, velocityInRadians))
+    {
+        yError() << "[WalkingFK::setDesiredRobotState] Error while updating the state.";
+        return false;
+    }
 
     return true;
 }
 
+void WalkingFK::useKinematicState(const KinematicState& state)
+{
+    m_activeState = state == KinematicState::Measured ? &m_measuredState : &m_desiredState;
+    m_kinDyn = m_activeState->kinDyn;
+}
+
+WalkingFK::KinematicState WalkingFK::getKinematicState() const
+{
+    return m_activeState == &m_measuredState ? KinematicState::Measured : KinematicState::Desired;
+}
+
 void WalkingFK::evaluateCoM()
 {
-    if(m_comEvaluated)
+    if(m_activeState->comEvaluated)
         return;
 
-    m_comPosition = m_kinDyn->getCenterOfMassPosition();
-    m_comVelocity = m_kinDyn->getCenterOfMassVelocity();
-
-    yarp::sig::Vector temp;
-    temp.resize(3);
+    m_activeState->comPosition = m_kinDyn->getCenterOfMassPosition();
+    m_activeState->comVelocity = m_kinDyn->getCenterOfMassVelocity();
 
-    iDynTree::toYarp(m_comPosition, temp);
-    iDynTree::toEigen(m_comPositionFiltered) = iDynTree::toEigen(m_comPositionFilter->filt(temp));
+    // the filters are fed only with the measured CoM
+    if(m_activeState == &m_measuredState)
+    {
+        m_comFilters.input(m_comPositionFilterOffset, 3) = iDynTree::toEigen(m_measuredState.comPosition);
+        m_comFilters.input(m_comVelocityFilterOffset, 3) = iDynTree::toEigen(m_measuredState.comVelocity);
+        m_comFilters.filter();
 
-    iDynTree::toYarp(m_comVelocity, temp);
-    iDynTree::toEigen(m_comVelocityFiltered) = iDynTree::toEigen(m_comVelocityFilter->filt(temp));
+        iDynTree::toEigen(m_comPositionFiltered) = m_comFilters.output(m_comPositionFilterOffset, 3);
+        iDynTree::toEigen(m_comVelocityFiltered) = m_comFilters.output(m_comVelocityFilterOffset, 3);
+    }
 
-    m_comEvaluated = true;
+    m_activeState->comEvaluated = true;
 
     return;
 }
 
 void WalkingFK::evaluateDCM()
 {
-    if(m_dcmEvaluated)
+    if(m_activeState->dcmEvaluated)
         return;
 
     evaluateCoM();
@@ -389,18 +506,18 @@ void WalkingFK::evaluateDCM()
     iDynTree::Vector3 dcm3D;
 
     // evaluate the 3D-DCM
-    if(m_useFilters)
+    if(m_useFilters && m_activeState == &m_measuredState)
         iDynTree::toEigen(dcm3D) = iDynTree::toEigen(m_comPositionFiltered) +
             iDynTree::toEigen(m_comVelocityFiltered) / m_omega;
     else
-        iDynTree::toEigen(dcm3D) = iDynTree::toEigen(m_comPosition) +
-            iDynTree::toEigen(m_comVelocity) / m_omega;
+        iDynTree::toEigen(dcm3D) = iDynTree::toEigen(m_activeState->comPosition) +
+            iDynTree::toEigen(m_activeState->comVelocity) / m_omega;
 
     // take only the 2D projection
-    m_dcm(0) = dcm3D(0);
-    m_dcm(1) = dcm3D(1);
+    m_activeState->dcm(0) = dcm3D(0);
+    m_activeState->dcm(1) = dcm3D(1);
 
-    m_dcmEvaluated = true;
+    m_activeState->dcmEvaluated = true;
 
     return;
 }
@@ -408,27 +525,27 @@ void WalkingFK::evaluateDCM()
 const iDynTree::Vector2& WalkingFK::getDCM()
 {
     evaluateDCM();
-    return m_dcm;
+    return m_activeState->dcm;
 }
 
 const iDynTree::Position& WalkingFK::getCoMPosition()
 {
     evaluateCoM();
 
-    if(m_useFilters)
+    if(m_useFilters && m_activeState == &m_measuredState)
         return m_comPositionFiltered;
     else
-        return m_comPosition;
+        return m_activeState->comPosition;
 }
 
 const iDynTree::Vector3& WalkingFK::getCoMVelocity()
 {
     evaluateCoM();
 
-    if(m_useFilters)
+    if(m_useFilters && m_activeState == &m_measuredState)
         return m_comVelocityFiltered;
     else
-        return m_comVelocity;
+        return m_activeState->comVelocity;
 }
 
 bool WalkingFK::setBaseOnTheFly()
@@ -439,46 +556,46 @@ bool WalkingFK::setBaseOnTheFly()
             return false;
     }
 
-    auto base = m_baseFrames["leftFoot"];
-    m_worldToBaseTransform = base.second;
-    if(!m_kinDyn->setFloatingBase(base.first))
+    const BaseFrame& base = m_baseFrames[LeftFootBase];
+    m_worldToBaseTransform = base.frameToLink;
+    if(!setFloatingBase(LeftFootBase))
     {
         yError() << "[setBaseOnTheFly] Error while setting the floating base on link "
-                 << base.first;
+                 << base.linkName;
         return false;
     }
 
     return true;
 }
 
-iDynTree::Transform WalkingFK::getLeftFootToWorldTransform()
+const iDynTree::Transform& WalkingFK::getLeftFootToWorldTransform()
 {
-    return m_kinDyn->getWorldTransform(m_frameLeftIndex);
+    return getWorldTransform(LeftFootFrame);
 }
 
-iDynTree::Transform WalkingFK::getRightFootToWorldTransform()
+const iDynTree::Transform& WalkingFK::getRightFootToWorldTransform()
 {
-    return m_kinDyn->getWorldTransform(m_frameRightIndex);
+    return getWorldTransform(RightFootFrame);
 }
 
-iDynTree::Transform WalkingFK::getLeftHandToWorldTransform()
+const iDynTree::Transform& WalkingFK::getLeftHandToWorldTransform()
 {
-    return m_kinDyn->getWorldTransform(m_frameLeftHandIndex);
+    return getWorldTransform(LeftHandFrame);
 }
 
-iDynTree::Transform WalkingFK::getRightHandToWorldTransform()
+const iDynTree::Transform& WalkingFK::getRightHandToWorldTransform()
 {
-    return m_kinDyn->getWorldTransform(m_frameRightHandIndex);
+    return getWorldTransform(RightHandFrame);
 }
 
-iDynTree::Transform WalkingFK::getHeadToWorldTransform()
+const iDynTree::Transform& WalkingFK::getHeadToWorldTransform()
 {
-    return m_kinDyn->getWorldTransform(m_frameHeadIndex);
+    return getWorldTransform(HeadFrame);
 }
 
-iDynTree::Transform WalkingFK::getRootLinkToWorldTransform()
+const iDynTree::Transform& WalkingFK::getRootLinkToWorldTransform()
 {
-    return m_kinDyn->getWorldTransform(m_frameRootIndex);
+    return getWorldTransform(RootFrame);
 }
 
 iDynTree::Twist WalkingFK::getRootLinkVelocity()
@@ -486,9 +603,9 @@ iDynTree::Twist WalkingFK::getRootLinkVelocity()
     return m_kinDyn->getFrameVel(m_frameRootIndex);
 }
 
-iDynTree::Rotation WalkingFK::getNeckOrientation()
+const iDynTree::Rotation& WalkingFK::getNeckOrientation()
 {
-    return m_kinDyn->getWorldTransform(m_frameNeckIndex).getRotation();
+    return getWorldTransform(NeckFrame).getRotation();
 }
 
 bool WalkingFK::getLeftFootJacobian(iDynTree::MatrixDynSize &jacobian)
@@ -540,3 +657,8 @@ std::shared_ptr<iDynTree::KinDynComputations> WalkingFK::getKinDyn()
 {
     return m_kinDyn;
 }
+
+std::shared_ptr<iDynTree::KinDynComputations> WalkingFK::getKinDyn(const KinematicState& state)
+{
+    return state == KinematicState::Measured ? m_measuredState.kinDyn : m_desiredState.kinDyn;
+}
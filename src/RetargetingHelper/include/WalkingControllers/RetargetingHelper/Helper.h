@@ -10,6 +10,7 @@
 
 // iDyntree
 #include <iDynTree/Rotation.h>
+#include <iDynTree/Span.h>
 #include <iDynTree/Transform.h>
 #include <iDynTree/VectorDynSize.h>
 
@@ -122,6 +123,8 @@ private:
     double m_dataArrivedTimeout{1};
     double m_timestampLastDataArrived;
 
+    bool m_useReplayedFeedback{false}; /**< True if the feedback is set by setReplayedFeedback() */
+
     void enableApproachingIfNecessary();
 
     /**
@@ -223,6 +226,26 @@ public:
      * @return true if the approaching phase is running
      */
     bool isApproachingPhase() const;
+
+    /**
+     * Replace the feedback of the server with recorded data. After the first call getFeedback()
+     * does not read the ports and the outputs of the client are the last ones set by this method.
+     * @param leftHand homogeneous transform of the left hand w.r.t. the head frame
+     * @param rightHand homogeneous transform of the right hand w.r.t. the head frame
+     * @param jointPositions position of the retargeting joints
+     * @param jointVelocities velocity of the retargeting joints
+     * @param rawJointPositions unfiltered position of the retargeting joints
+     * @param comHeight height of the CoM
+     * @param comHeightVelocity height velocity of the CoM
+     * @return true/false in case of success/failure
+     */
+    bool setReplayedFeedback(const iDynTree::Transform& leftHand,
+                             const iDynTree::Transform& rightHand,
+                             iDynTree::Span<const double> jointPositions,
+                             iDynTree::Span<const double> jointVelocities,
+                             iDynTree::Span<const double> rawJointPositions,
+                             const double& comHeight,
+                             const double& comHeightVelocity);
 };
 }; // namespace WalkingControllers
 #endif
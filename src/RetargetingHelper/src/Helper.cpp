@@ -302,6 +302,10 @@ void RetargetingClient::enableApproachingIfNecessary()
 
 bool RetargetingClient::getFeedback()
 {
+    // the outputs were already set by setReplayedFeedback()
+    if(m_useReplayedFeedback)
+        return true;
+
     if(m_useHandRetargeting)
     {
         auto getHandFeedback = [this](HandRetargeting& hand)
@@ -555,3 +559,35 @@ bool RetargetingClient::isApproachingPhase() const
 {
     return m_phase == Phase::Approaching;
 }
+
+bool RetargetingClient::setReplayedFeedback(const iDynTree::Transform& leftHand,
+                                            const iDynTree::Transform& rightHand,
+                                            iDynTree::Span<const double> jointPositions,
+                                            iDynTree::Span<const double> jointVelocities,
+                                            iDynTree::Span<const double> rawJointPositions,
+                                            const double& comHeight,
+                                            const double& comHeightVelocity)
+{
+    const size_t numberOfJoints = m_hdeRetargeting.joints.position.size();
+    if(jointPositions.size() != numberOfJoints || jointVelocities.size() != numberOfJoints
+       || rawJointPositions.size() != numberOfJoints)
+    {
+        yError() << "[RetargetingClient::setReplayedFeedback] The size of the joint vectors is"
+                 << "different from the number of the controlled joints.";
+        return false;
+    }
+
+    m_leftHand.transform = leftHand;
+    m_rightHand.transform = rightHand;
+    for(size_t i = 0; i < numberOfJoints; i++)
+    {
+        m_hdeRetargeting.joints.position(i) = jointPositions[i];
+        m_hdeRetargeting.joints.velocity(i) = jointVelocities[i];
+        m_hdeRetargeting.joints.rawPosition(i) = rawJointPositions[i];
+    }
+    m_hdeRetargeting.com.position = comHeight;
+    m_hdeRetargeting.com.velocity = comHeightVelocity;
+
+    m_useReplayedFeedback = true;
+    return true;
+}
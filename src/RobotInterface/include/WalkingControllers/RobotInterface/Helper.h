@@ -19,14 +19,18 @@
 #include <yarp/sig/Vector.h>
 #include <yarp/os/Timer.h>
 
-#include <iCub/ctrl/filters.h>
 
+#include <iDynTree/Span.h>
 #include <iDynTree/VectorDynSize.h>
 #include <iDynTree/Wrench.h>
 #include <iDynTree/Twist.h>
 #include <iDynTree/Transform.h>
+#include <iDynTree/Model.h>
 
+#include <WalkingControllers/EigenUtilities/FilterBank.h>
+#include <WalkingControllers/EigenUtilities/VelocityEstimator.h>
 #include <WalkingControllers/RobotInterface/PIDHandler.h>
+#include <WalkingControllers/RobotInterface/KinematicPlant.h>
 namespace WalkingControllers
 {
     class RobotInterface
@@ -66,19 +70,20 @@ namespace WalkingControllers
         iDynTree::VectorDynSize m_jointVelocitiesBounds; /**< Joint Velocity bounds [rad/s]. */
         iDynTree::VectorDynSize m_jointPositionsUpperBounds; /**< Joint Position upper bound [rad]. */
         iDynTree::VectorDynSize m_jointPositionsLowerBounds; /**< Joint Position lower bound [rad]. */
-        // yarp::sig::Vector m_positionFeedbackDegFiltered;
-        yarp::sig::Vector m_velocityFeedbackDegFiltered; /**< Vector containing the filtered joint velocity [deg/s]. */
-        std::unique_ptr<iCub::ctrl::FirstOrderLowPassFilter> m_positionFilter; /**< Joint position low pass filter .*/
-        std::unique_ptr<iCub::ctrl::FirstOrderLowPassFilter> m_velocityFilter; /**< Joint velocity low pass filter .*/
+        EigenUtilities::FilterBank m_filterBank; /**< Low pass filters of the joint velocities and of the wrenches. */
+        std::size_t m_velocityFilterOffset{0}; /**< Index of the joint velocities [deg/s] in the filter bank. */
         bool m_useVelocityFilter; /**< True if the joint velocity filter is used. */
+        EigenUtilities::VelocityEstimator m_velocityEstimator; /**< Estimator of the joint velocities [deg/s]. */
+        yarp::sig::Vector m_encoderTimestamps; /**< Timestamps of the joint positions. */
+        bool m_useVelocityEstimator{false}; /**< True if the joint velocities are estimated from the positions. */
 
         struct MeasuredWrench
         {
             std::unique_ptr<yarp::os::BufferedPort<yarp::sig::Vector>> port; /**< yarp port. */
             yarp::sig::Vector wrenchInput; /**< YARP vector that contains foot wrench. */
             yarp::sig::Vector wrenchInputFiltered; /**< YARP vector that contains foot filtered wrench. */
-            std::unique_ptr<iCub::ctrl::FirstOrderLowPassFilter> lowPassFilter; /**< Low pass filter.*/
-            bool useFilter;
+            std::size_t filterOffset{0}; /**< Index of the wrench in the filter bank. */
+            bool useFilter{false};
             bool isUpdated;
         };
 
@@ -99,6 +104,12 @@ namespace WalkingControllers
 
         int m_controlMode{-1}; /**< Current position control mode */
 
+        bool m_useKinematicPlant{false}; /**< True if the robot is replaced by the kinematic plant. */
+        std::unique_ptr<KinematicPlant> m_kinematicPlant; /**< Kinematic plant used to run the controller offline. */
+        double m_kinematicPlantMaxJointVelocity; /**< Joint velocity bound used with the kinematic plant [rad/s]. */
+
+        bool m_useReplayedFeedback{false}; /**< True if the feedback is set by setReplayedFeedback(). */
+
         /**
          * Get the higher position error among all joints.
          * @param desiredJointPositionsRad desired joint position in radiants;
@@ -123,10 +134,16 @@ namespace WalkingControllers
         bool configureForceTorqueSensor(const std::string& portPrefix,
                                         const std::string& portInputName,
                                         const std::string& wholeBodyDynamicsPortName,
-                                        const double& samplingTime,
                                         bool useWrenchFilter,
                                         double cutFrequency,
+                                        int filterOrder,
                                         MeasuredWrench& measuredWrench);
+
+        /**
+         * Update the kinematic plant and get its feedbacks.
+         * @return true in case of success and false otherwise.
+         */
+        bool getKinematicPlantFeedbacks();
     public:
 
         /**
@@ -205,6 +222,13 @@ namespace WalkingControllers
          */
         const iDynTree::VectorDynSize& getJointVelocity() const;
 
+        /**
+         * Get the latency of the joint velocities introduced by the estimator or by the low pass
+         * filter (mean among the joints).
+         * @return the latency in seconds
+         */
+        double getJointVelocityLatency() const;
+
         /**
          * Get the joint upper limit
          * @return the joint upper bound in radiants
@@ -261,6 +285,40 @@ namespace WalkingControllers
          */
         bool isExternalRobotBaseUsed();
 
+        /**
+         * Configure the kinematic plant that replaces the robot (it has to be called after
+         * configureRobot() and only if isKinematicPlantUsed() is true).
+         * @param model model of the robot containing only the controlled joints;
+         * @param config options of the plant (e.g. the names of the foot frames).
+         * @return true in case of success and false otherwise.
+         */
+        bool configureKinematicPlant(const iDynTree::Model& model, const yarp::os::Searchable& config);
+
+        /**
+         * Return true if the robot is replaced by the kinematic plant (use_kinematic_plant option)
+         */
+        bool isKinematicPlantUsed() const;
+
+        /**
+         * Replace the feedback of the robot with recorded data. After the first call
+         * getFeedbacks() and getFeedbacksRaw() do not read the robot (nor update the kinematic
+         * plant) and the feedback is the last one set by this method. The references are still
+         * sent to the robot (or to the kinematic plant).
+         * @param jointPositions joint positions [rad];
+         * @param jointVelocities joint velocities [rad/s];
+         * @param leftWrench left foot wrench;
+         * @param rightWrench right foot wrench;
+         * @param baseTransform base to world transform;
+         * @param baseTwist base twist (mixed representation).
+         * @return true in case of success and false otherwise.
+         */
+        bool setReplayedFeedback(iDynTree::Span<const double> jointPositions,
+                                 iDynTree::Span<const double> jointVelocities,
+                                 const iDynTree::Wrench& leftWrench,
+                                 const iDynTree::Wrench& rightWrench,
+                                 const iDynTree::Transform& baseTransform,
+                                 const iDynTree::Twist& baseTwist);
+
     };
 };
 #endif
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_ROBOT_HELPER_KINEMATIC_PLANT_H
+#define WALKING_CONTROLLERS_ROBOT_HELPER_KINEMATIC_PLANT_H
+
+// std
+#include <string>
+
+// YARP
+#include <yarp/os/Searchable.h>
+
+// iDynTree
+#include <iDynTree/KinDynComputations.h>
+#include <iDynTree/Model.h>
+#include <iDynTree/Transform.h>
+#include <iDynTree/VectorDynSize.h>
+#include <iDynTree/VectorFixSize.h>
+#include <iDynTree/Wrench.h>
+
+namespace WalkingControllers
+{
+
+/**
+ * KinematicPlant replaces the robot when the controller runs offline.
+ * The joints track the references perfectly: the position control mode follows a minimum jerk
+ * trajectory, the position direct mode reaches the reference in one step and the velocity mode
+ * integrates the reference. The foot with the lowest sole is supposed to stand still on a flat
+ * ground (when the soles are at the same height both feet are in contact) and the wrenches are
+ * computed with the linear inverted pendulum model, i.e. the total contact force sustains the
+ * center of mass acceleration and the global CoP is the ZMP of the pendulum.
+ */
+class KinematicPlant
+{
+    enum class ControlMode {Position, PositionDirect, Velocity};
+
+    iDynTree::KinDynComputations m_kinDyn; /**< Kinematics and dynamics of the (reduced) model. */
+    iDynTree::FrameIndex m_leftFootFrame; /**< Index of the left sole frame. */
+    iDynTree::FrameIndex m_rightFootFrame; /**< Index of the right sole frame. */
+    double m_contactThreshold; /**< A foot is in contact if its height w.r.t. the stance foot is lower than the threshold [m]. */
+    double m_mass; /**< Total mass of the robot [kg]. */
+    double m_gravity{9.81}; /**< Gravity acceleration [m/s^2]. */
+
+    ControlMode m_controlMode{ControlMode::Position}; /**< Current control mode. */
+    iDynTree::VectorDynSize m_jointPositions; /**< Joint positions [rad]. */
+    iDynTree::VectorDynSize m_jointVelocities; /**< Joint velocities [rad/s]. */
+    iDynTree::VectorDynSize m_previousJointPositions; /**< Joint positions at the previous update [rad]. */
+    iDynTree::VectorDynSize m_initialJointPositions; /**< Joint positions at the beginning of the position control motion [rad]. */
+    iDynTree::VectorDynSize m_desiredJointPositions; /**< Desired joint positions [rad]. */
+    iDynTree::VectorDynSize m_desiredJointVelocities; /**< Desired joint velocities [rad/s]. */
+    double m_positioningTime{0}; /**< Duration of the position control motion [s]. */
+    double m_startingPositionControlTime{0}; /**< Initial time of the position control motion [s]. */
+
+    bool m_isLeftStance{true}; /**< True if the left foot is the stance foot. */
+    bool m_isDoubleSupport{true}; /**< True if both feet are in contact. */
+    iDynTree::Transform m_worldToStance; /**< Pose of the stance foot in the world frame. */
+    iDynTree::Position m_comPosition[3]; /**< CoM positions of the last three updates. */
+    size_t m_comSamples{0}; /**< Number of valid CoM positions. */
+    iDynTree::Vector2 m_ZMP; /**< ZMP of the linear inverted pendulum. */
+
+    iDynTree::Wrench m_leftWrench; /**< Left foot wrench expressed in the left sole frame. */
+    iDynTree::Wrench m_rightWrench; /**< Right foot wrench expressed in the right sole frame. */
+
+    double m_lastUpdateTime{0}; /**< Time of the last update [s]. */
+    bool m_isFirstUpdate{true}; /**< True if the plant has never been updated. */
+
+    /**
+     * Compute the wrench applied by the ground to a foot.
+     * @param worldToFoot pose of the foot in the world frame;
+     * @param force contact force applied to the foot in the world frame;
+     * @param copInWorld position of the CoP in the world frame;
+     * @param wrench wrench expressed in the foot frame.
+     */
+    void computeFootWrench(const iDynTree::Transform& worldToFoot, const iDynTree::Vector3& force,
+                           const iDynTree::Position& copInWorld, iDynTree::Wrench& wrench) const;
+
+public:
+
+    /**
+     * Initialize the plant.
+     * @param config configuration options (left_foot_frame, right_foot_frame and, optionally,
+     * kinematic_plant_contact_threshold and kinematic_plant_initial_joint_positions in degrees);
+     * @param model model of the robot. The joints have to be ordered as the controlled joints.
+     * @return true in case of success and false otherwise.
+     */
+    bool initialize(const yarp::os::Searchable& config, const iDynTree::Model& model);
+
+    /**
+     * Move the joints toward a position with a minimum jerk trajectory.
+     * @param jointPositions desired joint positions [rad];
+     * @param positioningTime duration of the motion [s];
+     * @param now current time [s].
+     * @return true in case of success and false otherwise.
+     */
+    bool setPositionReferences(const iDynTree::VectorDynSize& jointPositions,
+                               const double& positioningTime, const double& now);
+
+    /**
+     * Check if the position control motion is ended.
+     * @param now current time [s].
+     */
+    bool isMotionDone(const double& now) const;
+
+    /**
+     * Set the joint positions reached at the next update.
+     * @param jointPositions desired joint positions [rad].
+     * @return true in case of success and false otherwise.
+     */
+    bool setDirectPositionReferences(const iDynTree::VectorDynSize& jointPositions);
+
+    /**
+     * Set the joint velocities integrated at the next updates.
+     * @param jointVelocities desired joint velocities [rad/s].
+     * @return true in case of success and false otherwise.
+     */
+    bool setVelocityReferences(const iDynTree::VectorDynSize& jointVelocities);
+
+    /**
+     * Advance the plant to the current time. The state does not change if the time did not
+     * advance since the last update.
+     * @param now current time [s].
+     * @return true in case of success and false otherwise.
+     */
+    bool update(const double& now);
+
+    /**
+     * Get the joint positions [rad].
+     */
+    const iDynTree::VectorDynSize& getJointPositions() const;
+
+    /**
+     * Get the joint velocities [rad/s].
+     */
+    const iDynTree::VectorDynSize& getJointVelocities() const;
+
+    /**
+     * Get the left foot wrench expressed in the left sole frame.
+     */
+    const iDynTree::Wrench& getLeftWrench() const;
+
+    /**
+     * Get the right foot wrench expressed in the right sole frame.
+     */
+    const iDynTree::Wrench& getRightWrench() const;
+
+    /**
+     * Get the ZMP of the linear inverted pendulum in the world frame (the initial left sole frame).
+     */
+    const iDynTree::Vector2& getZMP() const;
+};
+};
+
+#endif
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
 // SPDX-License-Identifier: BSD-3-Clause
 
+// std
+#include <cmath>
+
 #include <iDynTree/Utils.h>
 #include <iDynTree/EigenHelpers.h>
 #include <yarp/eigen/Eigen.h>
@@ -15,16 +18,30 @@ using namespace WalkingControllers;
 bool RobotInterface::getWorstError(const iDynTree::VectorDynSize& desiredJointPositionsRad,
                                    std::pair<size_t, double>& worstError)
 {
-    if(!m_encodersInterface)
+    if(m_useKinematicPlant)
     {
-        yError() << "[RobotInterface::getWorstError] The encoder I/F is not ready";
-        return false;
-    }
+        if(!m_kinematicPlant)
+        {
+            yError() << "[RobotInterface::getWorstError] The kinematic plant is not configured";
+            return false;
+        }
 
-    if(!m_encodersInterface->getEncoders(m_positionFeedbackDeg.data()))
+        for(size_t i = 0; i < m_actuatedDOFs; i++)
+            m_positionFeedbackDeg[i] = iDynTree::rad2deg(m_kinematicPlant->getJointPositions()(i));
+    }
+    else
     {
-        yError() << "[RobotInterface::getWorstError] Error reading encoders.";
-        return false;
+        if(!m_encodersInterface)
+        {
+            yError() << "[RobotInterface::getWorstError] The encoder I/F is not ready";
+            return false;
+        }
+
+        if(!m_encodersInterface->getEncoders(m_positionFeedbackDeg.data()))
+        {
+            yError() << "[RobotInterface::getWorstError] Error reading encoders.";
+            return false;
+        }
     }
 
     // clear the std::pair
@@ -50,8 +67,42 @@ bool RobotInterface::getWorstError(const iDynTree::VectorDynSize& desiredJointPo
     return true;
 }
 
+bool RobotInterface::getKinematicPlantFeedbacks()
+{
+    if(!m_kinematicPlant)
+    {
+        yError() << "[RobotInterface::getKinematicPlantFeedbacks] The kinematic plant is not configured";
+        return false;
+    }
+
+    if(!m_kinematicPlant->update(yarp::os::Time::now()))
+    {
+        yError() << "[RobotInterface::getKinematicPlantFeedbacks] Unable to update the kinematic plant";
+        return false;
+    }
+
+    m_positionFeedbackRad = m_kinematicPlant->getJointPositions();
+    m_velocityFeedbackRad = m_kinematicPlant->getJointVelocities();
+    for(unsigned j = 0 ; j < m_actuatedDOFs; j++)
+    {
+        m_positionFeedbackDeg(j) = iDynTree::rad2deg(m_positionFeedbackRad(j));
+        m_velocityFeedbackDeg(j) = iDynTree::rad2deg(m_velocityFeedbackRad(j));
+    }
+
+    m_leftWrench = m_kinematicPlant->getLeftWrench();
+    m_rightWrench = m_kinematicPlant->getRightWrench();
+    return true;
+}
+
 bool RobotInterface::getFeedbacksRaw(size_t maxAttempts, double attemptDelay)
 {
+    // the feedback was already set by setReplayedFeedback()
+    if(m_useReplayedFeedback)
+        return true;
+
+    if(m_useKinematicPlant)
+        return getKinematicPlantFeedbacks();
+
     if(!m_encodersInterface)
     {
         yError() << "[RobotInterface::getFeedbacksRaw] Encoders I/F is not ready";
@@ -76,11 +127,16 @@ bool RobotInterface::getFeedbacksRaw(size_t maxAttempts, double attemptDelay)
     unsigned int attempt = 0;
     do
     {
-        if(!okPosition)
+        // the velocity estimator needs the timestamps of the positions
+        if(!okPosition && m_useVelocityEstimator)
+            okPosition = m_encodersInterface->getEncodersTimed(m_positionFeedbackDeg.data(),
+                                                               m_encoderTimestamps.data());
+        else if(!okPosition)
             okPosition = m_encodersInterface->getEncoders(m_positionFeedbackDeg.data());
 
         if(!okVelocity)
-            okVelocity = m_encodersInterface->getEncoderSpeeds(m_velocityFeedbackDeg.data());
+            okVelocity = m_useVelocityEstimator
+                         || m_encodersInterface->getEncoderSpeeds(m_velocityFeedbackDeg.data());
 
         for(auto& wrench : m_leftFootMeasuredWrench)
         {
@@ -143,6 +199,11 @@ bool RobotInterface::getFeedbacksRaw(size_t maxAttempts, double attemptDelay)
 
         if(okPosition && okVelocity && okLeftWrenches && okRightWrenches && okBaseEstimation)
         {
+            if(m_useVelocityEstimator)
+                yarp::eigen::toEigen(m_velocityFeedbackDeg)
+                    = m_velocityEstimator.update(yarp::eigen::toEigen(m_positionFeedbackDeg),
+                                                 yarp::eigen::toEigen(m_encoderTimestamps));
+
             for(unsigned j = 0 ; j < m_actuatedDOFs; j++)
             {
                 m_positionFeedbackRad(j) = iDynTree::deg2rad(m_positionFeedbackDeg(j));
@@ -313,6 +374,41 @@ bool RobotInterface::configureRobot(const yarp::os::Searchable& config)
         }
     }
 
+    // resize the buffers
+    m_positionFeedbackDeg.resize(m_actuatedDOFs, 0.0);
+    m_velocityFeedbackDeg.resize(m_actuatedDOFs, 0.0);
+    m_positionFeedbackRad.resize(m_actuatedDOFs);
+    m_velocityFeedbackRad.resize(m_actuatedDOFs);
+    m_desiredJointPositionRad.resize(m_actuatedDOFs);
+    m_desiredJointValueDeg.resize(m_actuatedDOFs);
+    m_jointVelocitiesBounds.resize(m_actuatedDOFs);
+    m_jointPositionsUpperBounds.resize(m_actuatedDOFs);
+    m_jointPositionsLowerBounds.resize(m_actuatedDOFs);
+
+    // the joint velocities and the wrenches are filtered by the same bank
+    if(!m_filterBank.initialize(sampligTime))
+    {
+        yError() << "[RobotInterface::configureRobot] Unable to initialize the filter bank.";
+        return false;
+    }
+
+    // the robot may be replaced by the kinematic plant (see configureKinematicPlant()). In this
+    // case the device is not opened and the joint velocities are not filtered since they are
+    // not noisy
+    m_useKinematicPlant = config.check("use_kinematic_plant", yarp::os::Value(false)).asBool();
+    if(m_useKinematicPlant)
+    {
+        m_kinematicPlantMaxJointVelocity
+            = iDynTree::deg2rad(config.check("kinematic_plant_max_joint_velocity", yarp::os::Value(360.0)).asFloat64());
+        m_useVelocityFilter = false;
+        m_useExternalRobotBase = false;
+        m_heightOffset = 0;
+        m_currentJointInteractionMode.assign(m_actuatedDOFs, yarp::dev::InteractionModeEnum::VOCAB_IM_STIFF);
+
+        yInfo() << "[RobotInterface::configureRobot] The robot is replaced by the kinematic plant.";
+        return true;
+    }
+
     // open the device
     if(!m_robotDevice.open(options))
     {
@@ -363,23 +459,6 @@ bool RobotInterface::configureRobot(const yarp::os::Searchable& config)
         return false;
     }
 
-    // resize the buffers
-    m_positionFeedbackDeg.resize(m_actuatedDOFs, 0.0);
-    m_velocityFeedbackDeg.resize(m_actuatedDOFs, 0.0);
-    m_positionFeedbackRad.resize(m_actuatedDOFs);
-    m_velocityFeedbackRad.resize(m_actuatedDOFs);
-    m_desiredJointPositionRad.resize(m_actuatedDOFs);
-    m_desiredJointValueDeg.resize(m_actuatedDOFs);
-    m_jointVelocitiesBounds.resize(m_actuatedDOFs);
-    m_jointPositionsUpperBounds.resize(m_actuatedDOFs);
-    m_jointPositionsLowerBounds.resize(m_actuatedDOFs);
-
-    // m_positionFeedbackDegFiltered.resize(m_actuatedDOFs);
-    // m_positionFeedbackDegFiltered.zero();
-
-    m_velocityFeedbackDegFiltered.resize(m_actuatedDOFs);
-    m_velocityFeedbackDegFiltered.zero();
-
     // check if the robot is alive
     bool okPosition = false;
     bool okVelocity = false;
@@ -403,7 +482,50 @@ bool RobotInterface::configureRobot(const yarp::os::Searchable& config)
         return false;
     }
 
+    // the joint velocities can be estimated from the timestamped positions instead of being read
+    // from the encoders and low pass filtered
+    const std::string velocityEstimator
+        = config.check("joint_velocity_estimator", yarp::os::Value("encoders")).asString();
+    m_useVelocityEstimator = velocityEstimator != "encoders";
+    if(m_useVelocityEstimator)
+    {
+        const double noise = config.check("joint_velocity_estimator_noise", yarp::os::Value(0.02)).asFloat64();
+        bool ok = false;
+        if(velocityEstimator == "adaptive_window")
+        {
+            const int window = config.check("joint_velocity_estimator_window", yarp::os::Value(15)).asInt32();
+            ok = m_velocityEstimator.initializeAdaptiveWindow(m_actuatedDOFs, window, noise);
+        }
+        else if(velocityEstimator == "kalman")
+        {
+            const double accelerationNoise
+                = config.check("joint_velocity_estimator_acceleration_noise", yarp::os::Value(500.0)).asFloat64();
+            ok = m_velocityEstimator.initializeKalman(m_actuatedDOFs, accelerationNoise, noise);
+        }
+        else
+        {
+            yError() << "[configure] The joint velocity estimator" << velocityEstimator
+                     << "is not supported. Please use encoders, adaptive_window or kalman.";
+            return false;
+        }
+
+        m_encoderTimestamps.resize(m_actuatedDOFs, 0.0);
+        if(!ok || !m_encodersInterface->getEncodersTimed(m_positionFeedbackDeg.data(), m_encoderTimestamps.data()))
+        {
+            yError() << "[configure] Unable to initialize the joint velocity estimator.";
+            return false;
+        }
+        m_velocityEstimator.reset(yarp::eigen::toEigen(m_positionFeedbackDeg),
+                                  yarp::eigen::toEigen(m_encoderTimestamps));
+    }
+
     m_useVelocityFilter = config.check("use_joint_velocity_filter", yarp::os::Value("False")).asBool();
+    if(m_useVelocityFilter && m_useVelocityEstimator)
+    {
+        yWarning() << "[configure] The estimated joint velocities are not filtered.";
+        m_useVelocityFilter = false;
+    }
+
     if(m_useVelocityFilter)
     {
         double cutFrequency;
@@ -413,13 +535,16 @@ bool RobotInterface::configureRobot(const yarp::os::Searchable& config)
             return false;
         }
 
-        // set filters
-        // m_positionFilter = std::make_unique<iCub::ctrl::FirstOrderLowPassFilter>(10, m_dT);
-        m_velocityFilter = std::make_unique<iCub::ctrl::FirstOrderLowPassFilter>(cutFrequency,
-                                                                                 sampligTime);
+        // the first order is the default filter, higher orders are Butterworth filters
+        const int filterOrder = config.check("joint_velocity_filter_order", yarp::os::Value(1)).asInt32();
+        if(!m_filterBank.addLowPass(m_actuatedDOFs, cutFrequency, filterOrder, m_velocityFilterOffset))
+        {
+            yError() << "[configure] Unable to set the joint velocity filter.";
+            return false;
+        }
 
-        // m_positionFilter->init(m_positionFeedbackDeg);
-        m_velocityFilter->init(m_velocityFeedbackDeg);
+        m_filterBank.input(m_velocityFilterOffset, m_actuatedDOFs) = yarp::eigen::toEigen(m_velocityFeedbackDeg);
+        m_filterBank.reset();
     }
 
     // get the limits
@@ -488,9 +613,9 @@ bool RobotInterface::configureRobot(const yarp::os::Searchable& config)
 bool RobotInterface::configureForceTorqueSensor(const std::string& portPrefix,
                                                 const std::string& portInputName,
                                                 const std::string& wholeBodyDynamicsPortName,
-                                                const double& samplingTime,
                                                 bool useWrenchFilter,
                                                 double cutFrequency,
+                                                int filterOrder,
                                                 MeasuredWrench& measuredWrench)
 {
 
@@ -504,10 +629,15 @@ bool RobotInterface::configureForceTorqueSensor(const std::string& portPrefix,
         return false;
     }
 
+    measuredWrench.useFilter = useWrenchFilter;
     if(useWrenchFilter)
     {
-        measuredWrench.lowPassFilter = std::make_unique<iCub::ctrl::FirstOrderLowPassFilter>(cutFrequency,
-                                                                                             samplingTime);
+        measuredWrench.wrenchInputFiltered.resize(6, 0.0);
+        if(!m_filterBank.addLowPass(6, cutFrequency, filterOrder, measuredWrench.filterOffset))
+        {
+            yError() << "[RobotInterface::configureForceTorqueSensors] Unable to set the wrench filter.";
+            return false;
+        }
     }
     return true;
 }
@@ -516,6 +646,10 @@ bool RobotInterface::configureForceTorqueSensors(const yarp::os::Searchable& con
 {
     std::string portInput, portOutput;
 
+    // the wrenches are computed by the kinematic plant
+    if(m_useKinematicPlant)
+        return true;
+
     // check if the config file is empty
     if(config.isNull())
     {
@@ -530,8 +664,6 @@ bool RobotInterface::configureForceTorqueSensors(const yarp::os::Searchable& con
         return false;
     }
 
-    double samplingTime = config.check("sampling_time", yarp::os::Value(0.016)).asFloat64();
-
     // collect the information for the ports of the left foot wrenches
     // from now on we assume that the wrenches are expressed in the same frame (e.g l_sole)
     yarp::os::Value* listLeftFootWrenchInputPorts;
@@ -635,6 +767,7 @@ bool RobotInterface::configureForceTorqueSensors(const yarp::os::Searchable& con
             return false;
         }
     }
+    const int filterOrder = config.check("wrench_filter_order", yarp::os::Value(1)).asInt32();
 
     // initialize the measured wrenches
     bool ok = true;
@@ -643,8 +776,7 @@ bool RobotInterface::configureForceTorqueSensors(const yarp::os::Searchable& con
         ok = ok && this->configureForceTorqueSensor(portPrefix,
                                                     leftFootWrenchInputPorts[i],
                                                     leftFootWrenchOutputPorts[i],
-                                                    samplingTime,
-                                                    useWrenchFilter, cutFrequency,
+                                                    useWrenchFilter, cutFrequency, filterOrder,
                                                     m_leftFootMeasuredWrench[i]);
     }
 
@@ -653,8 +785,7 @@ bool RobotInterface::configureForceTorqueSensors(const yarp::os::Searchable& con
         ok = ok && this->configureForceTorqueSensor(portPrefix,
                                                     rightFootWrenchInputPorts[i],
                                                     rightFootWrenchOutputPorts[i],
-                                                    samplingTime,
-                                                    useWrenchFilter, cutFrequency,
+                                                    useWrenchFilter, cutFrequency, filterOrder,
                                                     m_rightFootMeasuredWrench[i]);
     }
 
@@ -664,6 +795,11 @@ bool RobotInterface::configureForceTorqueSensors(const yarp::os::Searchable& con
 bool RobotInterface::configurePIDHandler(const yarp::os::Bottle& config)
 {
     m_PIDHandler = std::make_unique<WalkingPIDHandler>();
+
+    // the kinematic plant does not have PIDs
+    if(m_useKinematicPlant)
+        return m_PIDHandler->initialize(yarp::os::Bottle::getNullBottle(), m_robotDevice, m_remoteControlBoards);
+
     return m_PIDHandler->initialize(config, m_robotDevice, m_remoteControlBoards);
 }
 
@@ -677,7 +813,7 @@ bool RobotInterface::resetFilters(size_t maxAttempts, double attemptDelay)
     }
 
     if(m_useVelocityFilter)
-        m_velocityFilter->init(m_velocityFeedbackDeg);
+        m_filterBank.input(m_velocityFilterOffset, m_actuatedDOFs) = yarp::eigen::toEigen(m_velocityFeedbackDeg);
 
     for(auto& wrench : m_leftFootMeasuredWrench)
     {
@@ -689,8 +825,7 @@ bool RobotInterface::resetFilters(size_t maxAttempts, double attemptDelay)
                 return false;
             }
 
-            // reset the filter
-            wrench.lowPassFilter->init(wrench.wrenchInput);
+            m_filterBank.input(wrench.filterOffset, 6) = yarp::eigen::toEigen(wrench.wrenchInput);
         }
     }
 
@@ -704,11 +839,12 @@ bool RobotInterface::resetFilters(size_t maxAttempts, double attemptDelay)
                 return false;
             }
 
-            // reset the filter
-            wrench.lowPassFilter->init(wrench.wrenchInput);
+            m_filterBank.input(wrench.filterOffset, 6) = yarp::eigen::toEigen(wrench.wrenchInput);
         }
     }
 
+    // reset all the filters at once
+    m_filterBank.reset();
 
     return true;
 }
@@ -721,15 +857,14 @@ bool RobotInterface::getFeedbacks(size_t maxAttempts, double attemptDelay)
         return false;
     }
 
+    // the feedbacks of the kinematic plant and the replayed ones are not filtered
+    if(m_useKinematicPlant || m_useReplayedFeedback)
+        return true;
+
+    // copy the joint velocities and the wrenches in the filter bank
     if(m_useVelocityFilter)
-    {
-        // filter the joint position and the velocity
-        m_velocityFeedbackDegFiltered = m_velocityFilter->filt(m_velocityFeedbackDeg);
-        for(unsigned j = 0; j < m_actuatedDOFs; ++j)
-            m_velocityFeedbackRad(j) = iDynTree::deg2rad(m_velocityFeedbackDegFiltered(j));
-    }
+        m_filterBank.input(m_velocityFilterOffset, m_actuatedDOFs) = yarp::eigen::toEigen(m_velocityFeedbackDeg);
 
-    // filt all the wrenches
     for(auto& wrench : m_leftFootMeasuredWrench)
     {
         if(wrench.useFilter)
@@ -740,8 +875,7 @@ bool RobotInterface::getFeedbacks(size_t maxAttempts, double attemptDelay)
                 return false;
             }
 
-            // apply the filter
-            wrench.wrenchInputFiltered =  wrench.lowPassFilter->filt(wrench.wrenchInput);
+            m_filterBank.input(wrench.filterOffset, 6) = yarp::eigen::toEigen(wrench.wrenchInput);
         }
     }
 
@@ -755,8 +889,23 @@ bool RobotInterface::getFeedbacks(size_t maxAttempts, double attemptDelay)
                 return false;
             }
 
-            // apply the filter
-            wrench.wrenchInputFiltered =  wrench.lowPassFilter->filt(wrench.wrenchInput);
+            m_filterBank.input(wrench.filterOffset, 6) = yarp::eigen::toEigen(wrench.wrenchInput);
+        }
+    }
+
+    // filter all the signals at once
+    m_filterBank.filter();
+
+    if(m_useVelocityFilter)
+        iDynTree::toEigen(m_velocityFeedbackRad)
+            = iDynTree::deg2rad(1.0) * m_filterBank.output(m_velocityFilterOffset, m_actuatedDOFs);
+
+    for(auto* wrenches : {&m_leftFootMeasuredWrench, &m_rightFootMeasuredWrench})
+    {
+        for(auto& wrench : *wrenches)
+        {
+            if(wrench.useFilter)
+                yarp::eigen::toEigen(wrench.wrenchInputFiltered) = m_filterBank.output(wrench.filterOffset, 6);
         }
     }
 
@@ -826,6 +975,10 @@ bool RobotInterface::getFeedbacks(size_t maxAttempts, double attemptDelay)
 
 bool RobotInterface::switchToControlMode(const int& controlMode)
 {
+    // the control mode of the kinematic plant is set together with the references
+    if(m_useKinematicPlant)
+        return true;
+
     // check if the control interface is ready
     if(!m_controlModeInterface)
     {
@@ -860,6 +1013,12 @@ bool RobotInterface::setInteractionMode(yarp::dev::InteractionModeEnum interacti
 
 bool RobotInterface::setInteractionMode(std::vector<yarp::dev::InteractionModeEnum>& interactionModes)
 {
+    if(m_useKinematicPlant)
+    {
+        m_currentJointInteractionMode = interactionModes;
+        return true;
+    }
+
     if(m_currentJointInteractionMode != interactionModes)
     {
         bool ok = m_interactionInterface->setInteractionModes(interactionModes.data());
@@ -887,6 +1046,15 @@ bool RobotInterface::setPositionReferences(const iDynTree::VectorDynSize& desire
 
     m_positioningTime = positioningTimeSec;
     m_positionMoveSkipped = false;
+
+    if(m_useKinematicPlant)
+    {
+        m_desiredJointPositionRad = desiredJointPositionsRad;
+        m_startingPositionControlTime = yarp::os::Time::now();
+        return m_kinematicPlant->setPositionReferences(desiredJointPositionsRad, positioningTimeSec,
+                                                       m_startingPositionControlTime);
+    }
+
     if(m_positionInterface == nullptr)
     {
         yError() << "[RobotInterface::setPositionReferences] Position I/F is not ready.";
@@ -969,7 +1137,10 @@ bool RobotInterface::checkMotionDone(bool& motionDone)
     }
 
     bool checkMotionDone = false;
-    m_positionInterface->checkMotionDone(&checkMotionDone);
+    if(m_useKinematicPlant)
+        checkMotionDone = m_kinematicPlant->isMotionDone(yarp::os::Time::now());
+    else
+        m_positionInterface->checkMotionDone(&checkMotionDone);
 
     std::pair<size_t, double> worstError;
     if (!getWorstError(m_desiredJointPositionRad, worstError))
@@ -994,13 +1165,13 @@ bool RobotInterface::checkMotionDone(bool& motionDone)
 
 bool RobotInterface::setDirectPositionReferences(const iDynTree::VectorDynSize& desiredPositionRad)
 {
-    if(m_positionDirectInterface == nullptr)
+    if(!m_useKinematicPlant && m_positionDirectInterface == nullptr)
     {
         yError() << "[RobotInterface::setDirectPositionReferences] PositionDirect I/F not ready.";
         return false;
     }
 
-    if(m_encodersInterface == nullptr)
+    if(!m_useKinematicPlant && m_encodersInterface == nullptr)
     {
         yError() << "[RobotInterface::setDirectPositionReferences] Encoders I/F not ready.";
         return false;
@@ -1039,6 +1210,9 @@ bool RobotInterface::setDirectPositionReferences(const iDynTree::VectorDynSize&
         return false;
     }
 
+    if(m_useKinematicPlant)
+        return m_kinematicPlant->setDirectPositionReferences(desiredPositionRad);
+
     for(unsigned i = 0; i < m_actuatedDOFs; i++)
         m_desiredJointValueDeg(i) = iDynTree::rad2deg(desiredPositionRad(i));
 
@@ -1053,13 +1227,13 @@ bool RobotInterface::setDirectPositionReferences(const iDynTree::VectorDynSize&
 
 bool RobotInterface::setVelocityReferences(const iDynTree::VectorDynSize& desiredVelocityRad)
 {
-    if(m_velocityInterface == nullptr)
+    if(!m_useKinematicPlant && m_velocityInterface == nullptr)
     {
         yError() << "[RobotInterface::setVelocityReferences] PositionDirect I/F not ready.";
         return false;
     }
 
-    if(m_encodersInterface == nullptr)
+    if(!m_useKinematicPlant && m_encodersInterface == nullptr)
     {
         yError() << "[RobotInterface::setVelocityReferences] Encoders I/F not ready.";
         return false;
@@ -1082,6 +1256,9 @@ bool RobotInterface::setVelocityReferences(const iDynTree::VectorDynSize& desire
         return false;
     }
 
+    if(m_useKinematicPlant)
+        return m_kinematicPlant->setVelocityReferences(desiredVelocityRad);
+
     for(unsigned i = 0; i < m_actuatedDOFs; i++)
         m_desiredJointValueDeg(i) = iDynTree::rad2deg(desiredVelocityRad(i));
 
@@ -1096,6 +1273,9 @@ bool RobotInterface::setVelocityReferences(const iDynTree::VectorDynSize& desire
 
 bool RobotInterface::close()
 {
+    if(m_useKinematicPlant)
+        return true;
+
     // close all the ports
     for(auto& wrench : m_leftFootMeasuredWrench)
         wrench.port->close();
@@ -1124,6 +1304,17 @@ const iDynTree::VectorDynSize& RobotInterface::getJointVelocity() const
     return m_velocityFeedbackRad;
 }
 
+double RobotInterface::getJointVelocityLatency() const
+{
+    if(m_useVelocityEstimator)
+        return m_velocityEstimator.getLatency().mean();
+
+    if(m_useVelocityFilter)
+        return m_filterBank.getGroupDelay(m_velocityFilterOffset);
+
+    return 0;
+}
+
 const iDynTree::Wrench& RobotInterface::getLeftWrench() const
 {
     return m_leftWrench;
@@ -1188,3 +1379,78 @@ bool RobotInterface::loadCustomInteractionMode()
 {
     return setInteractionMode(m_jointInteractionMode);
 }
+
+bool RobotInterface::configureKinematicPlant(const iDynTree::Model& model, const yarp::os::Searchable& config)
+{
+    if(!m_useKinematicPlant)
+    {
+        yError() << "[RobotInterface::configureKinematicPlant] The kinematic plant is not enabled.";
+        return false;
+    }
+
+    if(model.getNrOfDOFs() != m_actuatedDOFs)
+    {
+        yError() << "[RobotInterface::configureKinematicPlant] The model has" << model.getNrOfDOFs()
+                 << "DoFs while the controlled joints are" << m_actuatedDOFs;
+        return false;
+    }
+
+    m_kinematicPlant = std::make_unique<KinematicPlant>();
+    if(!m_kinematicPlant->initialize(config, model))
+    {
+        yError() << "[RobotInterface::configureKinematicPlant] Unable to initialize the kinematic plant.";
+        return false;
+    }
+
+    // the limits are taken from the model (the joints without limits are limited to one turn)
+    double minAngle, maxAngle;
+    for(unsigned int i = 0; i < m_actuatedDOFs; i++)
+    {
+        minAngle = -M_PI;
+        maxAngle = M_PI;
+        if(model.getJoint(i)->hasPosLimits())
+            model.getJoint(i)->getPosLimits(0, minAngle, maxAngle);
+
+        m_jointPositionsUpperBounds(i) = maxAngle;
+        m_jointPositionsLowerBounds(i) = minAngle;
+        m_jointVelocitiesBounds(i) = m_kinematicPlantMaxJointVelocity;
+    }
+
+    return getKinematicPlantFeedbacks();
+}
+
+bool RobotInterface::isKinematicPlantUsed() const
+{
+    return m_useKinematicPlant;
+}
+
+bool RobotInterface::setReplayedFeedback(iDynTree::Span<const double> jointPositions,
+                                         iDynTree::Span<const double> jointVelocities,
+                                         const iDynTree::Wrench& leftWrench,
+                                         const iDynTree::Wrench& rightWrench,
+                                         const iDynTree::Transform& baseTransform,
+                                         const iDynTree::Twist& baseTwist)
+{
+    if(jointPositions.size() != m_actuatedDOFs || jointVelocities.size() != m_actuatedDOFs)
+    {
+        yError() << "[RobotInterface::setReplayedFeedback] The size of the joint feedback is"
+                 << "different from the number of the actuated DoFs.";
+        return false;
+    }
+
+    for(unsigned j = 0; j < m_actuatedDOFs; j++)
+    {
+        m_positionFeedbackRad(j) = jointPositions[j];
+        m_velocityFeedbackRad(j) = jointVelocities[j];
+        m_positionFeedbackDeg(j) = iDynTree::rad2deg(jointPositions[j]);
+        m_velocityFeedbackDeg(j) = iDynTree::rad2deg(jointVelocities[j]);
+    }
+
+    m_leftWrench = leftWrench;
+    m_rightWrench = rightWrench;
+    m_robotBaseTransform = baseTransform;
+    m_robotBaseTwist = baseTwist;
+
+    m_useReplayedFeedback = true;
+    return true;
+}
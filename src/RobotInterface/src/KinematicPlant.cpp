@@ -0,0 +1,315 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <algorithm>
+#include <cmath>
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+// iDynTree
+#include <iDynTree/EigenHelpers.h>
+#include <iDynTree/Twist.h>
+#include <iDynTree/Utils.h>
+
+#include <WalkingControllers/RobotInterface/KinematicPlant.h>
+#include <WalkingControllers/YarpUtilities/Helper.h>
+
+using namespace WalkingControllers;
+
+bool KinematicPlant::initialize(const yarp::os::Searchable& config, const iDynTree::Model& model)
+{
+    if(!m_kinDyn.loadRobotModel(model))
+    {
+        yError() << "[KinematicPlant::initialize] Unable to load the model.";
+        return false;
+    }
+
+    std::string leftFootFrame, rightFootFrame;
+    if(!YarpUtilities::getStringFromSearchable(config, "left_foot_frame", leftFootFrame)
+       || !YarpUtilities::getStringFromSearchable(config, "right_foot_frame", rightFootFrame))
+    {
+        yError() << "[KinematicPlant::initialize] Unable to get the names of the foot frames.";
+        return false;
+    }
+
+    m_leftFootFrame = model.getFrameIndex(leftFootFrame);
+    m_rightFootFrame = model.getFrameIndex(rightFootFrame);
+    if(m_leftFootFrame == iDynTree::FRAME_INVALID_INDEX || m_rightFootFrame == iDynTree::FRAME_INVALID_INDEX)
+    {
+        yError() << "[KinematicPlant::initialize] Unable to find the frames" << leftFootFrame
+                 << "and" << rightFootFrame << "in the model.";
+        return false;
+    }
+
+    m_contactThreshold = config.check("kinematic_plant_contact_threshold", yarp::os::Value(0.005)).asFloat64();
+    m_mass = model.getTotalMass();
+
+    const size_t dofs = model.getNrOfDOFs();
+    m_jointPositions.resize(dofs);
+    m_jointPositions.zero();
+    if(config.check("kinematic_plant_initial_joint_positions"))
+    {
+        if(!YarpUtilities::getVectorFromSearchable(config, "kinematic_plant_initial_joint_positions",
+                                                   m_jointPositions))
+        {
+            yError() << "[KinematicPlant::initialize] Unable to get the initial joint positions.";
+            return false;
+        }
+        for(size_t i = 0; i < dofs; i++)
+            m_jointPositions(i) = iDynTree::deg2rad(m_jointPositions(i));
+    }
+
+    m_jointVelocities.resize(dofs);
+    m_jointVelocities.zero();
+    m_previousJointPositions = m_jointPositions;
+    m_initialJointPositions = m_jointPositions;
+    m_desiredJointPositions = m_jointPositions;
+    m_desiredJointVelocities.resize(dofs);
+    m_desiredJointVelocities.zero();
+
+    m_controlMode = ControlMode::Position;
+    m_positioningTime = 0;
+
+    // the world frame is the initial left sole frame
+    m_isLeftStance = true;
+    m_isDoubleSupport = true;
+    m_worldToStance = iDynTree::Transform::Identity();
+    m_comSamples = 0;
+    m_ZMP.zero();
+    m_leftWrench.zero();
+    m_rightWrench.zero();
+    m_isFirstUpdate = true;
+
+    return true;
+}
+
+bool KinematicPlant::setPositionReferences(const iDynTree::VectorDynSize& jointPositions,
+                                           const double& positioningTime, const double& now)
+{
+    if(jointPositions.size() != m_jointPositions.size())
+    {
+        yError() << "[KinematicPlant::setPositionReferences] Dimension mismatch between the desired "
+                 << "positions and the number of joints.";
+        return false;
+    }
+
+    m_controlMode = ControlMode::Position;
+    m_initialJointPositions = m_jointPositions;
+    m_desiredJointPositions = jointPositions;
+    m_positioningTime = positioningTime;
+    m_startingPositionControlTime = now;
+    return true;
+}
+
+bool KinematicPlant::isMotionDone(const double& now) const
+{
+    return m_controlMode != ControlMode::Position
+        || now - m_startingPositionControlTime >= m_positioningTime;
+}
+
+bool KinematicPlant::setDirectPositionReferences(const iDynTree::VectorDynSize& jointPositions)
+{
+    if(jointPositions.size() != m_jointPositions.size())
+    {
+        yError() << "[KinematicPlant::setDirectPositionReferences] Dimension mismatch between the "
+                 << "desired positions and the number of joints.";
+        return false;
+    }
+
+    m_controlMode = ControlMode::PositionDirect;
+    m_desiredJointPositions = jointPositions;
+    return true;
+}
+
+bool KinematicPlant::setVelocityReferences(const iDynTree::VectorDynSize& jointVelocities)
+{
+    if(jointVelocities.size() != m_jointPositions.size())
+    {
+        yError() << "[KinematicPlant::setVelocityReferences] Dimension mismatch between the "
+                 << "desired velocities and the number of joints.";
+        return false;
+    }
+
+    m_controlMode = ControlMode::Velocity;
+    m_desiredJointVelocities = jointVelocities;
+    return true;
+}
+
+void KinematicPlant::computeFootWrench(const iDynTree::Transform& worldToFoot, const iDynTree::Vector3& force,
+                                       const iDynTree::Position& copInWorld, iDynTree::Wrench& wrench) const
+{
+    const iDynTree::Transform footToWorld = worldToFoot.inverse();
+    const Eigen::Vector3d forceInFoot = iDynTree::toEigen(footToWorld.getRotation()) * iDynTree::toEigen(force);
+    const Eigen::Vector3d copInFoot = iDynTree::toEigen((footToWorld * copInWorld));
+
+    iDynTree::toEigen(wrench.getLinearVec3()) = forceInFoot;
+    iDynTree::toEigen(wrench.getAngularVec3()) = copInFoot.cross(forceInFoot);
+}
+
+bool KinematicPlant::update(const double& now)
+{
+    double dT = now - m_lastUpdateTime;
+    if(!m_isFirstUpdate && dT <= 0)
+        return true;
+
+    if(m_isFirstUpdate)
+        dT = 0;
+
+    m_previousJointPositions = m_jointPositions;
+    switch(m_controlMode)
+    {
+    case ControlMode::Position:
+    {
+        double s = 1;
+        if(m_positioningTime > 0)
+            s = std::min(std::max((now - m_startingPositionControlTime) / m_positioningTime, 0.0), 1.0);
+
+        // minimum jerk profile
+        const double ratio = s * s * s * (10 - 15 * s + 6 * s * s);
+        iDynTree::toEigen(m_jointPositions) = iDynTree::toEigen(m_initialJointPositions)
+            + ratio * (iDynTree::toEigen(m_desiredJointPositions) - iDynTree::toEigen(m_initialJointPositions));
+        break;
+    }
+    case ControlMode::PositionDirect:
+        m_jointPositions = m_desiredJointPositions;
+        break;
+    case ControlMode::Velocity:
+        iDynTree::toEigen(m_jointPositions) += dT * iDynTree::toEigen(m_desiredJointVelocities);
+        break;
+    }
+
+    if(dT > 0)
+        iDynTree::toEigen(m_jointVelocities) = (iDynTree::toEigen(m_jointPositions)
+                                                - iDynTree::toEigen(m_previousJointPositions)) / dT;
+    else
+        m_jointVelocities.zero();
+
+    // the kinematics is evaluated with the base in the origin, then it is moved such that the
+    // stance foot stands still
+    iDynTree::Twist baseTwist;
+    baseTwist.zero();
+    iDynTree::Vector3 gravity;
+    gravity.zero();
+    gravity(2) = -m_gravity;
+    if(!m_kinDyn.setRobotState(iDynTree::Transform::Identity(), m_jointPositions,
+                               baseTwist, m_jointVelocities, gravity))
+    {
+        yError() << "[KinematicPlant::update] Unable to set the robot state.";
+        return false;
+    }
+
+    const iDynTree::Transform baseToLeft = m_kinDyn.getWorldTransform(m_leftFootFrame);
+    const iDynTree::Transform baseToRight = m_kinDyn.getWorldTransform(m_rightFootFrame);
+    const iDynTree::Transform& baseToStance = m_isLeftStance ? baseToLeft : baseToRight;
+    const iDynTree::Transform& baseToSwing = m_isLeftStance ? baseToRight : baseToLeft;
+
+    // the swing foot becomes the stance foot when it is lower than the stance foot
+    const double swingHeight = (baseToStance.inverse() * baseToSwing).getPosition()(2);
+    m_isDoubleSupport = std::abs(swingHeight) < m_contactThreshold;
+    if(!m_isDoubleSupport && swingHeight < 0)
+    {
+        m_worldToStance = m_worldToStance * baseToStance.inverse() * baseToSwing;
+        m_isLeftStance = !m_isLeftStance;
+    }
+
+    const iDynTree::Transform worldToBase = m_worldToStance
+        * (m_isLeftStance ? baseToLeft : baseToRight).inverse();
+    const iDynTree::Transform worldToLeft = worldToBase * baseToLeft;
+    const iDynTree::Transform worldToRight = worldToBase * baseToRight;
+
+    // CoM acceleration (finite differences)
+    m_comPosition[2] = m_comPosition[1];
+    m_comPosition[1] = m_comPosition[0];
+    m_comPosition[0] = worldToBase * m_kinDyn.getCenterOfMassPosition();
+    m_comSamples = std::min(m_comSamples + 1, size_t(3));
+    if(dT <= 0)
+        m_comSamples = 1;
+
+    Eigen::Vector3d comAcceleration = Eigen::Vector3d::Zero();
+    if(m_comSamples == 3)
+        comAcceleration = (iDynTree::toEigen(m_comPosition[0]) - 2 * iDynTree::toEigen(m_comPosition[1])
+                           + iDynTree::toEigen(m_comPosition[2])) / (dT * dT);
+
+    // ZMP of the linear inverted pendulum. The ground is the plane of the stance sole
+    const double verticalAcceleration = std::max(m_gravity + comAcceleration(2), 0.0);
+    const double comHeight = m_comPosition[0](2) - m_worldToStance.getPosition()(2);
+    for(size_t i = 0; i < 2; i++)
+    {
+        m_ZMP(i) = m_comPosition[0](i);
+        if(verticalAcceleration > 0)
+            m_ZMP(i) -= comHeight / verticalAcceleration * comAcceleration(i);
+    }
+
+    iDynTree::Vector3 totalForce;
+    totalForce(0) = m_mass * comAcceleration(0);
+    totalForce(1) = m_mass * comAcceleration(1);
+    totalForce(2) = m_mass * verticalAcceleration;
+
+    m_leftWrench.zero();
+    m_rightWrench.zero();
+    const double groundHeight = m_worldToStance.getPosition()(2);
+    if(!m_isDoubleSupport)
+    {
+        const iDynTree::Position cop(m_ZMP(0), m_ZMP(1), groundHeight);
+        if(m_isLeftStance)
+            computeFootWrench(worldToLeft, totalForce, cop, m_leftWrench);
+        else
+            computeFootWrench(worldToRight, totalForce, cop, m_rightWrench);
+    }
+    else
+    {
+        // the force is split according to the projection of the ZMP on the segment connecting
+        // the feet, then the CoP of each foot is shifted such that the global CoP is the ZMP
+        const Eigen::Vector2d left = iDynTree::toEigen(worldToLeft.getPosition()).head<2>();
+        const Eigen::Vector2d right = iDynTree::toEigen(worldToRight.getPosition()).head<2>();
+        const Eigen::Vector2d zmp = iDynTree::toEigen(m_ZMP);
+        const Eigen::Vector2d leftToRight = right - left;
+
+        double alpha = 0.5;
+        if(leftToRight.squaredNorm() > 1e-8)
+            alpha = std::min(std::max((zmp - left).dot(leftToRight) / leftToRight.squaredNorm(), 0.0), 1.0);
+
+        const Eigen::Vector2d offset = zmp - (left + alpha * leftToRight);
+        iDynTree::Vector3 leftForce, rightForce;
+        iDynTree::toEigen(leftForce) = (1 - alpha) * iDynTree::toEigen(totalForce);
+        iDynTree::toEigen(rightForce) = alpha * iDynTree::toEigen(totalForce);
+
+        computeFootWrench(worldToLeft, leftForce,
+                          iDynTree::Position(left(0) + offset(0), left(1) + offset(1), groundHeight),
+                          m_leftWrench);
+        computeFootWrench(worldToRight, rightForce,
+                          iDynTree::Position(right(0) + offset(0), right(1) + offset(1), groundHeight),
+                          m_rightWrench);
+    }
+
+    m_lastUpdateTime = now;
+    m_isFirstUpdate = false;
+    return true;
+}
+
+const iDynTree::VectorDynSize& KinematicPlant::getJointPositions() const
+{
+    return m_jointPositions;
+}
+
+const iDynTree::VectorDynSize& KinematicPlant::getJointVelocities() const
+{
+    return m_jointVelocities;
+}
+
+const iDynTree::Wrench& KinematicPlant::getLeftWrench() const
+{
+    return m_leftWrench;
+}
+
+const iDynTree::Wrench& KinematicPlant::getRightWrench() const
+{
+    return m_rightWrench;
+}
+
+const iDynTree::Vector2& KinematicPlant::getZMP() const
+{
+    return m_ZMP;
+}
@@ -70,6 +70,8 @@ namespace WalkingControllers
 
         iDynTree::ConvexHullProjectionConstraint m_convexHullComputer; /**<iDynTree convex hull helper. */
         std::vector<iDynTree::Polygon> m_feetPolygons; /**<Vector containing the polygon of each foot (left and right). */
+        std::vector<iDynTree::Polygon> m_singleFootPolygon; /**<Vector containing the polygon of the foot in contact. */
+        std::vector<iDynTree::Transform> m_feetTransforms; /**<Transforms of the feet in contact (preallocated, used to build the convex hull). */
 
         /**
          * Pointer to the current MPCSolver.
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_SIMPLIFIED_MODEL_CONTROLLERS_DCM_MPC_THREAD_H
+#define WALKING_CONTROLLERS_SIMPLIFIED_MODEL_CONTROLLERS_DCM_MPC_THREAD_H
+
+// std
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+
+// YARP
+#include <yarp/os/Searchable.h>
+
+// iDynTree
+#include <iDynTree/VectorFixSize.h>
+#include <iDynTree/Transform.h>
+
+// BipedalLocomotion
+#include <BipedalLocomotion/System/TimeProfiler.h>
+
+#include <WalkingControllers/SimplifiedModelControllers/DCMModelPredictiveController.h>
+
+namespace WalkingControllers
+{
+
+/**
+ * WalkingControllerThread runs the DCM model predictive controller at a rate lower than the
+ * one of the walking module.
+ * The controller is solved every mpc_sampling_time / sampling_time calls of setInput() in a
+ * separate thread, the output is linearly interpolated between two consecutive solutions.
+ * The interpolation reaches a solution mpc_sampling_time after it is received, hence the output
+ * lags one MPC period behind the solutions (in addition to the time spent by the thread).
+ * The input buffers are swapped between the fast loop and the thread, once they reached the
+ * size of the horizon they are filled in place without allocations.
+ * If mpc_sampling_time is equal to sampling_time the controller is solved in the calling thread.
+ */
+    class WalkingControllerThread
+    {
+        WalkingController m_controller; /**< DCM model predictive controller. */
+
+        int m_decimation{1}; /**< Number of fast steps for each MPC step. */
+        int m_ticksSinceInput{0}; /**< Number of fast steps since the last input sent to the controller. */
+        int m_ticksSinceSolution{0}; /**< Number of fast steps since the last solution. */
+
+        bool m_hasSolution{false}; /**< True if at least one solution is available. */
+        bool m_newInputAvailable{false}; /**< True if a new input has to be processed by the thread. */
+        bool m_newSolutionAvailable{false}; /**< True if the thread computed a new solution. */
+        bool m_resetTrajectory{false}; /**< True if the reference trajectory has been reset since the last input. */
+        bool m_solverFailed{false}; /**< True if the thread was not able to solve the problem. */
+        bool m_isClosing{false}; /**< True if the thread has to be closed. */
+
+        /**
+         * Input of the controller. Only the first element of the feet trajectories is used by
+         * the controller.
+         */
+        struct Input
+        {
+            std::deque<iDynTree::Transform> leftFoot, rightFoot;
+            std::deque<bool> leftInContact, rightInContact;
+            std::deque<iDynTree::Vector2> referenceSignal; /**< Decimated DCM reference. */
+            iDynTree::Vector2 feedback; /**< DCM feedback. */
+        };
+
+        Input m_input; /**< Input written by the fast loop. */
+        Input m_threadInput; /**< Input used by the thread. */
+
+        iDynTree::Vector2 m_solution; /**< Last solution computed by the thread. */
+        iDynTree::Vector2 m_previousOutput; /**< Output at the time the last solution was received. */
+        iDynTree::Vector2 m_latestOutput; /**< Last solution used by the fast loop. */
+        iDynTree::Vector2 m_output; /**< Interpolated output. */
+
+        std::unique_ptr<BipedalLocomotion::System::TimeProfiler> m_profiler; /**< Profiler of the MPC rate. */
+
+        std::thread m_controllerThread; /**< Thread running the controller. */
+        std::condition_variable m_conditionVariable; /**< Synchronizer. */
+        std::mutex m_mutex; /**< Mutex protecting the input and output buffers. */
+        std::mutex m_controllerMutex; /**< Mutex protecting the controller. */
+
+        /**
+         * Main thread method.
+         */
+        void computeThread();
+
+        /**
+         * Solve the controller using the content of the input buffers.
+         * @return true/false in case of success/failure.
+         */
+        bool solve();
+
+    public:
+
+        /**
+         * Destructor.
+         */
+        ~WalkingControllerThread();
+
+        /**
+         * Initialize the controller.
+         * @param config yarp searchable configuration variable. It must contain the sampling_time
+         * of the walking module and optionally the mpc_sampling_time.
+         * @return true/false in case of success/failure
+         */
+        bool initialize(const yarp::os::Searchable& config);
+
+        /**
+         * Set the input of the controller. It has to be called at each step of the walking module.
+         * @param leftFoot deque containing the homogeneous transformation of the left foot;
+         * @param rightFoot deque containing the homogeneous transformation of the right foot;
+         * @param leftInContact deque containing information about the state of the left foot;
+         * @param rightInContact deque containing information about the state of the right foot;
+         * @param feedback measured DCM;
+         * @param referenceSignal deque containing the DCM reference at the walking module rate;
+         * @param resetTrajectory true if the reference signal has been reset.
+         * @return true/false in case of success/failure.
+         */
+        bool setInput(const std::deque<iDynTree::Transform>& leftFoot,
+                      const std::deque<iDynTree::Transform>& rightFoot,
+                      const std::deque<bool>& leftInContact,
+                      const std::deque<bool>& rightInContact,
+                      const iDynTree::Vector2& feedback,
+                      const std::deque<iDynTree::Vector2>& referenceSignal,
+                      const bool& resetTrajectory);
+
+        /**
+         * Get the (interpolated) output of the controller.
+         * @return the vector containing the output the controller.
+         */
+        const iDynTree::Vector2& getControllerOutput() const;
+
+        /**
+         * Reset the controller
+         */
+        void reset();
+    };
+};
+#endif
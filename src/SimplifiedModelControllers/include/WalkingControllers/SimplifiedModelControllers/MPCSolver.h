@@ -130,10 +130,11 @@ namespace WalkingControllers
         bool solve();
 
         /**
-         * Get the solver solution
+         * Get the solver solution. The solution is not copied, the reference is valid until the
+         * following call of solve().
          * @return the entire solution of the solver
          */
-        iDynTree::VectorDynSize getSolution();
+        Eigen::Ref<const Eigen::VectorXd> getSolution() const;
     };
 };
 
@@ -0,0 +1,330 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_SIMPLIFIED_MODEL_CONTROLLERS_SIMPLIFIED_MODEL_PIPELINE_H
+#define WALKING_CONTROLLERS_SIMPLIFIED_MODEL_CONTROLLERS_SIMPLIFIED_MODEL_PIPELINE_H
+
+// std
+#include <cmath>
+
+// YARP
+#include <yarp/os/Searchable.h>
+#include <yarp/os/LogStream.h>
+
+// Eigen
+#include <Eigen/Core>
+
+#include <WalkingControllers/YarpUtilities/Helper.h>
+#include <WalkingControllers/EigenUtilities/Integrator.h>
+#include <WalkingControllers/EigenUtilities/MinimumJerkTrajectory.h>
+
+namespace WalkingControllers
+{
+    namespace SimplifiedModel
+    {
+        using Vector2 = Eigen::Vector2d;
+
+        /**
+         * RuntimeGains contains the gains of the simplified model controllers loaded from the
+         * configuration file. As WalkingZMPController, it supports the gain scheduling of the
+         * ZMP-CoM controller gains.
+         */
+        class RuntimeGains
+        {
+            double m_kDCM{0}; /**< DCM controller gain. */
+            double m_kCoM{0}; /**< CoM controller gain. */
+            double m_kZMP{0}; /**< ZMP controller gain. */
+
+            bool m_useGainScheduling{false}; /**< True of the gain scheduling is used.*/
+            Vector2 m_stanceGains; /**< CoM and ZMP gains during the stance phase. */
+            Vector2 m_walkingGains; /**< CoM and ZMP gains during the walking phase. */
+            EigenUtilities::MinimumJerkTrajectory<2> m_gainsSmoother; /**< Minimum jerk trajectory for the
+                                                                         gains (CoM, ZMP). */
+
+        public:
+
+            /**
+             * Initialize the gains.
+             * @param dcmControllerConfig configuration of the DCM reactive controller;
+             * @param zmpControllerConfig configuration of the ZMP-CoM controller.
+             * @return true/false in case of success/failure
+             */
+            bool initialize(const yarp::os::Searchable& dcmControllerConfig,
+                            const yarp::os::Searchable& zmpControllerConfig)
+            {
+                if(!YarpUtilities::getNumberFromSearchable(dcmControllerConfig, "kDCM", m_kDCM))
+                {
+                    yError() << "[RuntimeGains::initialize] Unable to get the double from searchable.";
+                    return false;
+                }
+
+                if(!YarpUtilities::getNumberFromSearchable(zmpControllerConfig, "kCoM_walking", m_walkingGains(0))
+                   || !YarpUtilities::getNumberFromSearchable(zmpControllerConfig, "kZMP_walking", m_walkingGains(1)))
+                {
+                    yError() << "[RuntimeGains::initialize] Unable to get the double from searchable.";
+                    return false;
+                }
+
+                m_useGainScheduling = zmpControllerConfig.check("useGainScheduling", yarp::os::Value(false)).asBool();
+                if(!m_useGainScheduling)
+                {
+                    m_kCoM = m_walkingGains(0);
+                    m_kZMP = m_walkingGains(1);
+                    return true;
+                }
+
+                double samplingTime, smoothingTime;
+                if(!YarpUtilities::getNumberFromSearchable(zmpControllerConfig, "sampling_time", samplingTime)
+                   || !YarpUtilities::getNumberFromSearchable(zmpControllerConfig, "smoothingTime", smoothingTime)
+                   || !YarpUtilities::getNumberFromSearchable(zmpControllerConfig, "kCoM_stance", m_stanceGains(0))
+                   || !YarpUtilities::getNumberFromSearchable(zmpControllerConfig, "kZMP_stance", m_stanceGains(1)))
+                {
+                    yError() << "[RuntimeGains::initialize] Unable to get the double from searchable.";
+                    return false;
+                }
+
+                if(!m_gainsSmoother.initialize(samplingTime, smoothingTime, m_stanceGains))
+                {
+                    yError() << "[RuntimeGains::initialize] Unable to initialize the gains smoother.";
+                    return false;
+                }
+
+                m_kCoM = m_stanceGains(0);
+                m_kZMP = m_stanceGains(1);
+                return true;
+            }
+
+            /**
+             * Set the walking phase.
+             * @param isStancePhase true if the robot is in the stance phase.
+             */
+            void setPhase(const bool isStancePhase)
+            {
+                if(!m_useGainScheduling)
+                    return;
+
+                m_gainsSmoother.computeNextValues(isStancePhase ? m_stanceGains : m_walkingGains);
+                const auto gains = m_gainsSmoother.getPosition();
+                m_kCoM = gains(0);
+                m_kZMP = gains(1);
+            }
+
+            double kDCM() const { return m_kDCM; }
+            double kCoM() const { return m_kCoM; }
+            double kZMP() const { return m_kZMP; }
+        };
+
+        /**
+         * ConstantGains exposes gains known at compile time. Traits has to provide the
+         * static constexpr members kDCM, kCoM and kZMP, e.g.
+         * \code{.cpp}
+         * struct MyGains
+         * {
+         *     static constexpr double kDCM = 1.0;
+         *     static constexpr double kCoM = 6.0;
+         *     static constexpr double kZMP = 1.0;
+         * };
+         * SimplifiedModelPipeline<ConstantGains<MyGains>> pipeline;
+         * \endcode
+         * The gains contained in the configuration file are ignored.
+         */
+        template <class Traits>
+        class ConstantGains
+        {
+        public:
+            bool initialize(const yarp::os::Searchable&, const yarp::os::Searchable&)
+            {
+                return true;
+            }
+
+            constexpr void setPhase(const bool) const {}
+
+            static constexpr double kDCM() { return Traits::kDCM; }
+            static constexpr double kCoM() { return Traits::kCoM; }
+            static constexpr double kZMP() { return Traits::kZMP; }
+        };
+
+        /**
+         * SimplifiedModelPipeline implements the whole simplified model controller chain on
+         * fixed size vectors:
+         * - the DCM reference is fed into the 3D-LIPM (StableDCMModel) to obtain the desired CoM;
+         * - the DCM reactive controller (WalkingDCMReactiveController) evaluates the desired ZMP;
+         * - the ZMP-CoM controller (WalkingZMPController) evaluates the desired CoM velocity;
+         * - the CoM velocity is integrated to obtain the desired CoM position.
+         * All the stages are inlined and the gains are provided by the Gains policy (either
+         * RuntimeGains or ConstantGains).
+         */
+        template <class Gains = RuntimeGains>
+        class SimplifiedModelPipeline
+        {
+            Gains m_gains; /**< Gains of the controllers. */
+            double m_omega{0}; /**< Inverted time constant of the 3D-LIPM. */
+            bool m_isInitialized{false}; /**< True if the pipeline was initialized. */
+
+            EigenUtilities::Integrator<2> m_lipmIntegrator; /**< CoM integrator of the 3D-LIPM. */
+            EigenUtilities::Integrator<2> m_velocityIntegral; /**< Integrator of the ZMP-CoM controller output. */
+
+            Vector2 m_lipmCoMPosition{Vector2::Zero()}; /**< CoM position of the 3D-LIPM. */
+            Vector2 m_lipmCoMVelocity{Vector2::Zero()}; /**< CoM velocity of the 3D-LIPM. */
+            Vector2 m_desiredZMP{Vector2::Zero()}; /**< Output of the DCM controller. */
+            Vector2 m_desiredCoMVelocity{Vector2::Zero()}; /**< Output of the ZMP-CoM controller. */
+
+        public:
+
+            /**
+             * Initialize the pipeline.
+             * @param dcmControllerConfig configuration of the DCM reactive controller;
+             * @param zmpControllerConfig configuration of the ZMP-CoM controller.
+             * Both the configurations must contain the general options (sampling_time, com_height).
+             * @return true/false in case of success/failure
+             */
+            bool initialize(const yarp::os::Searchable& dcmControllerConfig,
+                            const yarp::os::Searchable& zmpControllerConfig)
+            {
+                double comHeight, samplingTime;
+                if(!YarpUtilities::getNumberFromSearchable(dcmControllerConfig, "com_height", comHeight)
+                   || !YarpUtilities::getNumberFromSearchable(zmpControllerConfig, "sampling_time", samplingTime))
+                {
+                    yError() << "[SimplifiedModelPipeline::initialize] Unable to get the double from searchable.";
+                    return false;
+                }
+                double gravityAcceleration = dcmControllerConfig.check("gravity_acceleration",
+                                                                       yarp::os::Value(9.81)).asFloat64();
+                m_omega = std::sqrt(gravityAcceleration / comHeight);
+
+                if(!m_lipmIntegrator.initialize(samplingTime) || !m_velocityIntegral.initialize(samplingTime))
+                {
+                    yError() << "[SimplifiedModelPipeline::initialize] Unable to initialize the integrators.";
+                    return false;
+                }
+
+                if(!m_gains.initialize(dcmControllerConfig, zmpControllerConfig))
+                {
+                    yError() << "[SimplifiedModelPipeline::initialize] Unable to initialize the gains.";
+                    return false;
+                }
+
+                m_isInitialized = true;
+                return true;
+            }
+
+            /**
+             * Return true if the pipeline has been initialized.
+             */
+            bool isInitialized() const
+            {
+                return m_isInitialized;
+            }
+
+            /**
+             * Reset the pipeline.
+             * @param comPosition initial position of the CoM (used by the 3D-LIPM and the ZMP-CoM controller).
+             */
+            template <typename Derived>
+            void reset(const Eigen::MatrixBase<Derived>& comPosition)
+            {
+                m_lipmIntegrator.reset(comPosition);
+                m_velocityIntegral.reset(comPosition);
+                m_lipmCoMPosition = comPosition;
+                m_lipmCoMVelocity.setZero();
+            }
+
+            /**
+             * Propagate the 3D-LIPM.
+             * @param dcmPositionDesired desired position of the DCM.
+             */
+            template <typename Derived>
+            void integrateReference(const Eigen::MatrixBase<Derived>& dcmPositionDesired)
+            {
+                m_lipmCoMVelocity = -m_omega * (m_lipmCoMPosition - dcmPositionDesired);
+                m_lipmCoMPosition = m_lipmIntegrator.integrate(m_lipmCoMVelocity);
+            }
+
+            /**
+             * Evaluate the DCM reactive controller.
+             * @param dcmPositionDesired desired position of the DCM;
+             * @param dcmVelocityDesired desired velocity of the DCM;
+             * @param dcmFeedback measured position of the DCM.
+             */
+            template <typename D1, typename D2, typename D3>
+            void evaluateDCMControl(const Eigen::MatrixBase<D1>& dcmPositionDesired,
+                                    const Eigen::MatrixBase<D2>& dcmVelocityDesired,
+                                    const Eigen::MatrixBase<D3>& dcmFeedback)
+            {
+                m_desiredZMP = dcmPositionDesired - 1 / m_omega * dcmVelocityDesired
+                    - m_gains.kDCM() * (dcmPositionDesired - dcmFeedback);
+            }
+
+            /**
+             * Evaluate the ZMP-CoM controller and integrate its output.
+             * @param isStancePhase true if the robot is in the stance phase (used by the gain scheduling);
+             * @param zmpDesired desired position of the ZMP;
+             * @param zmpFeedback measured position of the ZMP;
+             * @param comFeedback measured position of the CoM (only the first two elements are used).
+             */
+            template <typename D1, typename D2, typename D3>
+            void evaluateZMPControl(const bool isStancePhase,
+                                    const Eigen::MatrixBase<D1>& zmpDesired,
+                                    const Eigen::MatrixBase<D2>& zmpFeedback,
+                                    const Eigen::MatrixBase<D3>& comFeedback)
+            {
+                m_gains.setPhase(isStancePhase);
+
+                m_desiredCoMVelocity = m_gains.kCoM() * (m_lipmCoMPosition - comFeedback.template head<2>())
+                    - m_gains.kZMP() * (zmpDesired - zmpFeedback)
+                    + m_lipmCoMVelocity;
+
+                m_velocityIntegral.integrate(m_desiredCoMVelocity);
+            }
+
+            /**
+             * Run all the stages of the pipeline.
+             * @param dcmPositionDesired desired position of the DCM;
+             * @param dcmVelocityDesired desired velocity of the DCM;
+             * @param dcmFeedback measured position of the DCM;
+             * @param zmpFeedback measured position of the ZMP;
+             * @param comFeedback measured position of the CoM;
+             * @param isStancePhase true if the robot is in the stance phase.
+             */
+            template <typename D1, typename D2, typename D3, typename D4, typename D5>
+            void advance(const Eigen::MatrixBase<D1>& dcmPositionDesired,
+                         const Eigen::MatrixBase<D2>& dcmVelocityDesired,
+                         const Eigen::MatrixBase<D3>& dcmFeedback,
+                         const Eigen::MatrixBase<D4>& zmpFeedback,
+                         const Eigen::MatrixBase<D5>& comFeedback,
+                         const bool isStancePhase)
+            {
+                integrateReference(dcmPositionDesired);
+                evaluateDCMControl(dcmPositionDesired, dcmVelocityDesired, dcmFeedback);
+                evaluateZMPControl(isStancePhase, m_desiredZMP, zmpFeedback, comFeedback);
+            }
+
+            /**
+             * Get the CoM position of the 3D-LIPM.
+             */
+            const Vector2& getLIPMCoMPosition() const { return m_lipmCoMPosition; }
+
+            /**
+             * Get the CoM velocity of the 3D-LIPM.
+             */
+            const Vector2& getLIPMCoMVelocity() const { return m_lipmCoMVelocity; }
+
+            /**
+             * Get the output of the DCM controller (desired ZMP).
+             */
+            const Vector2& getDesiredZMP() const { return m_desiredZMP; }
+
+            /**
+             * Get the desired CoM position evaluated by the ZMP-CoM controller.
+             */
+            const Vector2& getDesiredCoMPosition() const { return m_velocityIntegral.get(); }
+
+            /**
+             * Get the desired CoM velocity evaluated by the ZMP-CoM controller.
+             */
+            const Vector2& getDesiredCoMVelocity() const { return m_desiredCoMVelocity; }
+        };
+    }
+};
+
+#endif
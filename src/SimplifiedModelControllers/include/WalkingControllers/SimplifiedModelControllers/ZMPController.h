@@ -4,20 +4,19 @@
 #ifndef WALKING_CONTROLLERS_SIMPLIFIED_MODEL_CONTROLLERS_ZMP_CONTROLLER_H
 #define WALKING_CONTROLLERS_SIMPLIFIED_MODEL_CONTROLLERS_ZMP_CONTROLLER_H
 
-// std
-#include <memory>
-
 // YARP
 #include <yarp/os/Searchable.h>
 
-// iCub-ctrl
-#include <iCub/ctrl/pids.h>
-#include <iCub/ctrl/minJerkCtrl.h>
+// Eigen
+#include <Eigen/Core>
 
 // iDynTree
 #include <iDynTree/VectorFixSize.h>
 #include <iDynTree/Position.h>
 
+#include <WalkingControllers/EigenUtilities/Integrator.h>
+#include <WalkingControllers/EigenUtilities/MinimumJerkTrajectory.h>
+
 namespace WalkingControllers
 {
 
@@ -38,7 +37,8 @@ namespace WalkingControllers
         double m_kCoMStance; /**< Desired CoM controller gain during the stance phase. */
         double m_kZMPStance; /**< Desired ZMP controller gain during the stance phase. */
 
-        bool m_controlEvaluated; /**< True if the control output was correctly evaluated. */
+        bool m_isInitialized{false}; /**< True if the controller was initialized. */
+        bool m_controlEvaluated{false}; /**< True if the control output was correctly evaluated. */
 
         iDynTree::Vector2 m_zmpFeedback; /**< Feedback signal containing the position of the ZMP. */
         iDynTree::Vector2 m_comFeedback; /**< Feedback signal containing the position of the CoM. */
@@ -50,16 +50,16 @@ namespace WalkingControllers
         iDynTree::Vector2 m_desiredCoMVelocity; /**< Controller output. */
 
         /**
-         * Pointer containing an integrator object.
+         * Integrator object.
          * It is useful to evaluate the desired CoM position from the CoM velocity.
          */
-        std::unique_ptr<iCub::ctrl::Integrator> m_velocityIntegral{nullptr};
+        EigenUtilities::Integrator<2> m_velocityIntegral;
 
         bool m_useGainScheduling; /**< True of the gain scheduling is used.*/
-        std::unique_ptr<iCub::ctrl::minJerkTrajGen> m_kZMPSmoother; /**< Minimum jerk trajectory for the
-                                                                       ZMP gain. */
-        std::unique_ptr<iCub::ctrl::minJerkTrajGen> m_kCoMSmoother; /**< Minimum jerk trajectory for the
-                                                                       CoM gain. */
+        EigenUtilities::MinimumJerkTrajectory<2> m_gainsSmoother; /**< Minimum jerk trajectory for the
+                                                                     gains (CoM, ZMP). */
+        Eigen::Vector2d m_stanceGains; /**< CoM and ZMP gains during the stance phase. */
+        Eigen::Vector2d m_walkingGains; /**< CoM and ZMP gains during the walking phase. */
 
     public:
 
@@ -301,6 +301,10 @@ bool WalkingController::initializeConstraints(const yarp::os::Searchable& config
     m_feetPolygons.resize(2);
     m_feetPolygons[0] = foot;
     m_feetPolygons[1] = foot;
+    m_singleFootPolygon.assign(1, foot);
+
+    // the convex hull is evaluated at each tick, the buffers are allocated only once
+    m_feetTransforms.reserve(2);
 
     // set the tolerance of the convex hull
     m_convexHullTolerance = config.check("convex_hull_tolerance", yarp::os::Value(0.01)).asFloat64();
@@ -459,12 +463,12 @@ bool WalkingController::buildConvexHull(const iDynTree::Transform& leftFootTrans
     iDynTree::Position planeOrigin;
     planeOrigin.zero();
 
-    std::vector<iDynTree::Transform> feetTransforms;
-    feetTransforms.push_back(leftFootTransform);
-    feetTransforms.push_back(rightFootTransform);
+    m_feetTransforms.clear();
+    m_feetTransforms.push_back(leftFootTransform);
+    m_feetTransforms.push_back(rightFootTransform);
 
     return m_convexHullComputer.buildConvexHull(xAxis, yAxis, planeOrigin,
-                                                m_feetPolygons, feetTransforms);
+                                                m_feetPolygons, m_feetTransforms);
 }
 
 bool WalkingController::buildConvexHull(const iDynTree::Transform& footTransform)
@@ -480,12 +484,11 @@ bool WalkingController::buildConvexHull(const iDynTree::Transform& footTransform
     iDynTree::Position planeOrigin;
     planeOrigin.zero();
 
-    std::vector<iDynTree::Transform> feetTransforms;
-    feetTransforms.push_back(footTransform);
+    m_feetTransforms.clear();
+    m_feetTransforms.push_back(footTransform);
 
     return m_convexHullComputer.buildConvexHull(xAxis, yAxis, planeOrigin,
-                                                std::vector<iDynTree::Polygon>(1, m_feetPolygons[0]),
-                                                feetTransforms);
+                                                m_singleFootPolygon, m_feetTransforms);
 }
 
 bool WalkingController::solve()
@@ -505,7 +508,8 @@ bool WalkingController::solve()
         return false;
     }
 
-    iDynTree::VectorDynSize solution = m_currentController->getSolution();
+    // only the first input is used, the solution is not copied
+    const auto solution = m_currentController->getSolution();
     m_output(0) = solution(m_stateSize * (m_controllerHorizon + 1));
     m_output(1) = solution(m_stateSize * (m_controllerHorizon + 1) + 1);
 
@@ -0,0 +1,279 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <algorithm>
+#include <cmath>
+
+// YARP
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Property.h>
+
+// iDynTree
+#include <iDynTree/EigenHelpers.h>
+
+#include <WalkingControllers/YarpUtilities/Helper.h>
+#include <WalkingControllers/SimplifiedModelControllers/DCMModelPredictiveControllerThread.h>
+
+using namespace WalkingControllers;
+
+WalkingControllerThread::~WalkingControllerThread()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_isClosing = true;
+        m_conditionVariable.notify_one();
+    }
+
+    if(m_controllerThread.joinable())
+    {
+        m_controllerThread.join();
+        m_controllerThread = std::thread();
+    }
+}
+
+bool WalkingControllerThread::initialize(const yarp::os::Searchable& config)
+{
+    double samplingTime;
+    if(!YarpUtilities::getNumberFromSearchable(config, "sampling_time", samplingTime))
+    {
+        yError() << "[WalkingControllerThread::initialize] Unable to get the double from searchable.";
+        return false;
+    }
+
+    double mpcSamplingTime = config.check("mpc_sampling_time", yarp::os::Value(samplingTime)).asFloat64();
+    m_decimation = static_cast<int>(std::round(mpcSamplingTime / samplingTime));
+    if(m_decimation < 1 || std::abs(m_decimation * samplingTime - mpcSamplingTime) > 1e-6)
+    {
+        yError() << "[WalkingControllerThread::initialize] The mpc_sampling_time has to be a multiple "
+                 << "of the sampling_time.";
+        return false;
+    }
+
+    // the controller is discretized with the MPC sampling time
+    yarp::os::Property controllerOptions;
+    controllerOptions.fromString(config.toString());
+    controllerOptions.put("sampling_time", mpcSamplingTime);
+    if(!m_controller.initialize(controllerOptions))
+    {
+        yError() << "[WalkingControllerThread::initialize] Unable to initialize the controller.";
+        return false;
+    }
+
+    if(m_decimation == 1)
+        return true;
+
+    // the feet buffers contain only the first element of the trajectories
+    for(Input* input : {&m_input, &m_threadInput})
+    {
+        input->leftFoot.resize(1);
+        input->rightFoot.resize(1);
+        input->leftInContact.resize(1);
+        input->rightInContact.resize(1);
+    }
+
+    m_profiler = std::make_unique<BipedalLocomotion::System::TimeProfiler>();
+    m_profiler->setPeriod(static_cast<int>(std::round(1 / mpcSamplingTime)));
+    m_profiler->addTimer("MPC-thread");
+
+    // start the thread
+    m_controllerThread = std::thread(&WalkingControllerThread::computeThread, this);
+
+    yInfo() << "[WalkingControllerThread::initialize] The MPC runs every" << m_decimation << "steps.";
+
+    return true;
+}
+
+void WalkingControllerThread::computeThread()
+{
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_conditionVariable.wait(lock, [this]{ return m_newInputAvailable || m_isClosing; });
+            if(m_isClosing)
+                return;
+        }
+
+        // the errors are reported to the walking module by setInput()
+        solve();
+    }
+}
+
+bool WalkingControllerThread::solve()
+{
+    std::lock_guard<std::mutex> controllerGuard(m_controllerMutex);
+
+    bool resetTrajectory;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if(!m_newInputAvailable)
+            return true;
+
+        // the buffers are swapped, the fast loop fills the ones used by the previous solution.
+        // std::deque::swap exchanges the storage, unlike the move of the deques
+        m_threadInput.leftFoot.swap(m_input.leftFoot);
+        m_threadInput.rightFoot.swap(m_input.rightFoot);
+        m_threadInput.leftInContact.swap(m_input.leftInContact);
+        m_threadInput.rightInContact.swap(m_input.rightInContact);
+        m_threadInput.referenceSignal.swap(m_input.referenceSignal);
+        m_threadInput.feedback = m_input.feedback;
+        resetTrajectory = m_resetTrajectory;
+
+        m_resetTrajectory = false;
+        m_newInputAvailable = false;
+    }
+
+    m_profiler->setInitTime("MPC-thread");
+
+    const Input& input = m_threadInput;
+    bool ok = m_controller.setConvexHullConstraint(input.leftFoot, input.rightFoot,
+                                                   input.leftInContact, input.rightInContact);
+    ok = ok && m_controller.setFeedback(input.feedback);
+    ok = ok && m_controller.setReferenceSignal(input.referenceSignal, resetTrajectory);
+    ok = ok && m_controller.solve();
+
+    m_profiler->setEndTime("MPC-thread");
+    m_profiler->profiling();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if(!ok)
+    {
+        m_solverFailed = true;
+        return false;
+    }
+
+    m_solution = m_controller.getControllerOutput();
+    m_newSolutionAvailable = true;
+    m_hasSolution = true;
+    return true;
+}
+
+bool WalkingControllerThread::setInput(const std::deque<iDynTree::Transform>& leftFoot,
+                                       const std::deque<iDynTree::Transform>& rightFoot,
+                                       const std::deque<bool>& leftInContact,
+                                       const std::deque<bool>& rightInContact,
+                                       const iDynTree::Vector2& feedback,
+                                       const std::deque<iDynTree::Vector2>& referenceSignal,
+                                       const bool& resetTrajectory)
+{
+    // single rate, the controller is solved in the calling thread
+    if(m_decimation == 1)
+    {
+        if(!m_controller.setConvexHullConstraint(leftFoot, rightFoot, leftInContact, rightInContact))
+        {
+            yError() << "[WalkingControllerThread::setInput] unable to evaluate the convex hull.";
+            return false;
+        }
+
+        if(!m_controller.setFeedback(feedback))
+        {
+            yError() << "[WalkingControllerThread::setInput] unable to set the feedback.";
+            return false;
+        }
+
+        if(!m_controller.setReferenceSignal(referenceSignal, resetTrajectory))
+        {
+            yError() << "[WalkingControllerThread::setInput] unable to set the reference Signal.";
+            return false;
+        }
+
+        if(!m_controller.solve())
+        {
+            yError() << "[WalkingControllerThread::setInput] Unable to solve the problem.";
+            return false;
+        }
+
+        m_output = m_controller.getControllerOutput();
+        return true;
+    }
+
+    bool firstSolution;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if(m_solverFailed)
+        {
+            yError() << "[WalkingControllerThread::setInput] Unable to solve the problem.";
+            return false;
+        }
+
+        // the gradient of the MPC is shifted at each solution, if the trajectory was reset in
+        // the meanwhile the gradient has to be evaluated from scratch
+        m_resetTrajectory = m_resetTrajectory || resetTrajectory;
+
+        if(m_ticksSinceInput == 0)
+        {
+            // only the first element of the feet trajectories is used by the controller. The
+            // buffers are filled in place
+            m_input.leftFoot.front() = leftFoot.front();
+            m_input.rightFoot.front() = rightFoot.front();
+            m_input.leftInContact.front() = leftInContact.front();
+            m_input.rightInContact.front() = rightInContact.front();
+
+            m_input.feedback = feedback;
+
+            // the reference is sampled at the MPC rate. Its size is the one of the horizon,
+            // the buffer is resized only when it changes
+            const size_t referenceSize = (referenceSignal.size() + m_decimation - 1) / m_decimation;
+            if(m_input.referenceSignal.size() != referenceSize)
+                m_input.referenceSignal.resize(referenceSize);
+            for(size_t i = 0; i < referenceSize; i++)
+                m_input.referenceSignal[i] = referenceSignal[i * m_decimation];
+
+            m_newInputAvailable = true;
+        }
+        m_ticksSinceInput = (m_ticksSinceInput + 1) % m_decimation;
+
+        firstSolution = !m_hasSolution;
+    }
+
+    if(firstSolution)
+    {
+        // the first solution is evaluated in the calling thread
+        if(!solve())
+        {
+            yError() << "[WalkingControllerThread::setInput] Unable to solve the problem.";
+            return false;
+        }
+    }
+    else
+        m_conditionVariable.notify_one();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if(m_newSolutionAvailable)
+    {
+        m_previousOutput = firstSolution ? m_solution : m_output;
+        m_latestOutput = m_solution;
+        m_ticksSinceSolution = 0;
+        m_newSolutionAvailable = false;
+    }
+
+    // interpolate the output of the controller
+    m_ticksSinceSolution++;
+    double alpha = std::min(1.0, static_cast<double>(m_ticksSinceSolution) / m_decimation);
+    iDynTree::toEigen(m_output) = (1 - alpha) * iDynTree::toEigen(m_previousOutput)
+        + alpha * iDynTree::toEigen(m_latestOutput);
+
+    return true;
+}
+
+const iDynTree::Vector2& WalkingControllerThread::getControllerOutput() const
+{
+    return m_output;
+}
+
+void WalkingControllerThread::reset()
+{
+    std::lock_guard<std::mutex> controllerGuard(m_controllerMutex);
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    m_controller.reset();
+
+    m_hasSolution = false;
+    m_newInputAvailable = false;
+    m_newSolutionAvailable = false;
+    m_resetTrajectory = false;
+    m_solverFailed = false;
+    m_ticksSinceInput = 0;
+    m_ticksSinceSolution = 0;
+}
@@ -306,14 +306,7 @@ bool MPCSolver::solve()
     return m_optimizerSolver->solveProblem() == OsqpEigen::ErrorExitFlag::NoError;
 }
 
-iDynTree::VectorDynSize MPCSolver::getSolution()
+Eigen::Ref<const Eigen::VectorXd> MPCSolver::getSolution() const
 {
-    Eigen::VectorXd solutionEigen = m_optimizerSolver->getSolution();
-
-    int solutionSize = m_stateSize * (m_controllerHorizon + 1) +
-        m_inputSize * m_controllerHorizon;
-    iDynTree::VectorDynSize solution(solutionSize);
-    iDynTree::toEigen(solution) = solutionEigen;
-
-    return solution;
+    return m_optimizerSolver->getSolution();
 }
@@ -6,8 +6,6 @@
 
 // iDynTree
 #include <iDynTree/EigenHelpers.h>
-#include <iDynTree/YARPConversions.h>
-#include <iDynTree/YARPEigenConversions.h>
 
 #include <WalkingControllers/YarpUtilities/Helper.h>
 #include <WalkingControllers/SimplifiedModelControllers/ZMPController.h>
@@ -53,11 +51,12 @@ bool WalkingZMPController::initialize(const yarp::os::Searchable& config)
         return false;
     }
 
-    yarp::sig::Vector buffer;
-    buffer.resize(2, 0.0);
-
-    // instantiate Integrator object
-    m_velocityIntegral = std::make_unique<iCub::ctrl::Integrator>(samplingTime, buffer);
+    // initialize the integrator
+    if(!m_velocityIntegral.initialize(samplingTime))
+    {
+        yError() << "[initialize] Unable to initialize the integrator.";
+        return false;
+    }
 
     // if gain scheduling is used the stance gains has to be loaded
     if(m_useGainScheduling)
@@ -81,14 +80,15 @@ bool WalkingZMPController::initialize(const yarp::os::Searchable& config)
             return false;
         }
 
-        m_kZMPSmoother = std::make_unique<iCub::ctrl::minJerkTrajGen>(1, samplingTime,
-                                                                      smoothingTime);
-        m_kCoMSmoother = std::make_unique<iCub::ctrl::minJerkTrajGen>(1, samplingTime,
-                                                                      smoothingTime);
+        m_stanceGains << m_kCoMStance, m_kZMPStance;
+        m_walkingGains << m_kCoMWalking, m_kZMPWalking;
 
-        // initialize the minimum jerk trajectories
-        m_kZMPSmoother->init(yarp::sig::Vector(1, m_kZMPStance));
-        m_kCoMSmoother->init(yarp::sig::Vector(1, m_kCoMStance));
+        // initialize the minimum jerk trajectory
+        if(!m_gainsSmoother.initialize(samplingTime, smoothingTime, m_stanceGains))
+        {
+            yError() << "[initialize] Unable to initialize the gains smoother.";
+            return false;
+        }
 
         m_kCoM = m_kCoMStance;
         m_kZMP = m_kZMPStance;
@@ -99,6 +99,8 @@ bool WalkingZMPController::initialize(const yarp::os::Searchable& config)
         m_kZMP = m_kZMPWalking;
     }
 
+    m_isInitialized = true;
+
     return true;
 }
 
@@ -106,18 +108,11 @@ void WalkingZMPController::setPhase(const bool& isStancePhase)
 {
     if(m_useGainScheduling)
     {
-        if(isStancePhase)
-        {
-            m_kCoMSmoother->computeNextValues(yarp::sig::Vector(1, m_kCoMStance));
-            m_kZMPSmoother->computeNextValues(yarp::sig::Vector(1, m_kZMPStance));
-        }
-        else
-        {
-            m_kCoMSmoother->computeNextValues(yarp::sig::Vector(1, m_kCoMWalking));
-            m_kZMPSmoother->computeNextValues(yarp::sig::Vector(1, m_kZMPWalking));
-        }
-        m_kCoM = m_kCoMSmoother->getPos()[0];
-        m_kZMP = m_kZMPSmoother->getPos()[0];
+        m_gainsSmoother.computeNextValues(isStancePhase ? m_stanceGains : m_walkingGains);
+
+        const auto gains = m_gainsSmoother.getPosition();
+        m_kCoM = gains(0);
+        m_kZMP = gains(1);
     }
 }
 
@@ -143,7 +138,7 @@ void WalkingZMPController::setReferenceSignal(const iDynTree::Vector2& zmpDesire
 bool WalkingZMPController::evaluateControl()
 {
     m_controlEvaluated = false;
-    if(m_velocityIntegral == nullptr)
+    if(!m_isInitialized)
     {
         yError() << "[evaluateControl] The integrator is not initialized.";
         return false;
@@ -157,13 +152,7 @@ bool WalkingZMPController::evaluateControl()
                                              +iDynTree::toEigen(m_comVelocityDesired);
 
     // integrate the velocity
-    yarp::sig::Vector desiredCoMVelocityYarp(2);
-    yarp::sig::Vector desiredCoMPositionYarp(2);
-    iDynTree::toYarp(m_desiredCoMVelocity, desiredCoMVelocityYarp);
-
-    desiredCoMPositionYarp = m_velocityIntegral->integrate(desiredCoMVelocityYarp);
-
-    iDynTree::toiDynTree(desiredCoMPositionYarp, m_controllerOutput);
+    iDynTree::toEigen(m_controllerOutput) = m_velocityIntegral.integrate(iDynTree::toEigen(m_desiredCoMVelocity));
 
     m_controlEvaluated = true;
     return true;
@@ -185,15 +174,12 @@ bool WalkingZMPController::getControllerOutput(iDynTree::Vector2& controllerOutp
 
 bool WalkingZMPController::reset(const iDynTree::Vector2& initialValue)
 {
-    if(m_velocityIntegral == nullptr)
+    if(!m_isInitialized)
     {
         yError() << "[reset] The integrator is not initialized.";
         return false;
     }
 
-    yarp::sig::Vector buffer(2);
-    iDynTree::toYarp(initialValue, buffer);
-
-    m_velocityIntegral->reset(buffer);
+    m_velocityIntegral.reset(iDynTree::toEigen(initialValue));
     return true;
 }
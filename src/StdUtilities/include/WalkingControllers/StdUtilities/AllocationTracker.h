@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_STD_ALLOCATION_TRACKER_H
+#define WALKING_CONTROLLERS_STD_ALLOCATION_TRACKER_H
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace WalkingControllers
+{
+    namespace StdUtilities
+    {
+        /**
+         * AllocationTracker counts the heap allocations of each thread. The counters are updated by
+         * the replacement of the global operator new contained in AllocationInterposer.cpp, which
+         * is compiled in the applications when WALKING_CONTROLLERS_TRACK_ALLOCATIONS is enabled.
+         * With glibc the interposer replaces also malloc, calloc, realloc and the aligned
+         * allocation functions, so the allocations of C code (e.g. strdup) are counted. With the
+         * other C libraries only operator new is counted.
+         * Without the interposer isEnabled() returns false and the counters are always zero.
+         * A thread can declare a scope in which it is not supposed to allocate memory: depending
+         * on the policy, an allocation in the scope is counted, logged with a backtrace or
+         * aborts the process.
+         * \code{.cpp}
+         * {
+         *     AllocationTracker::ScopedForbid noAllocation;
+         *     // code that is not supposed to allocate
+         * }
+         * \endcode
+         */
+        class AllocationTracker
+        {
+        public:
+
+            /**
+             * Action taken when a thread allocates in a no-allocation scope.
+             */
+            enum class Policy {Count, Log, Abort};
+
+            /**
+             * Allocations of a thread.
+             */
+            struct Counters
+            {
+                std::uint64_t allocations{0}; /**< Number of allocations. */
+                std::uint64_t bytes{0}; /**< Allocated bytes. */
+            };
+
+        private:
+
+            // the thread local variables are trivially constructible and destructible, hence they
+            // can be used by operator new also while a thread is created or destroyed
+            static inline thread_local std::uint64_t s_allocations{0}; /**< Allocations of the thread. */
+            static inline thread_local std::uint64_t s_bytes{0}; /**< Bytes allocated by the thread. */
+            static inline thread_local std::uint32_t s_forbidDepth{0}; /**< Nested no-allocation scopes. */
+            static inline thread_local std::uint32_t s_allowDepth{0}; /**< Nested allowed scopes. */
+
+            static inline std::atomic<bool> s_isEnabled{false}; /**< True if the interposer is linked. */
+            static inline std::atomic<Policy> s_policy{Policy::Count}; /**< Policy of the violations. */
+            static inline std::atomic<std::uint64_t> s_violations{0}; /**< Allocations in no-allocation scopes. */
+
+        public:
+
+            /**
+             * Scope in which the current thread is not supposed to allocate memory.
+             */
+            class ScopedForbid
+            {
+                bool m_isActive; /**< True if the scope is active. */
+
+            public:
+
+                /**
+                 * Constructor.
+                 * @param isActive if false the scope does not check the allocations.
+                 */
+                explicit ScopedForbid(const bool& isActive = true)
+                    : m_isActive(isActive)
+                {
+                    if(m_isActive)
+                        s_forbidDepth++;
+                }
+
+                ScopedForbid(const ScopedForbid&) = delete;
+                ScopedForbid& operator=(const ScopedForbid&) = delete;
+
+                ~ScopedForbid()
+                {
+                    if(m_isActive)
+                        s_forbidDepth--;
+                }
+            };
+
+            /**
+             * Scope, nested in a no-allocation scope, in which the current thread is allowed to
+             * allocate memory (e.g. to print an error). The allocations are still counted.
+             */
+            class ScopedAllow
+            {
+            public:
+
+                ScopedAllow()
+                {
+                    s_allowDepth++;
+                }
+
+                ScopedAllow(const ScopedAllow&) = delete;
+                ScopedAllow& operator=(const ScopedAllow&) = delete;
+
+                ~ScopedAllow()
+                {
+                    s_allowDepth--;
+                }
+            };
+
+            /**
+             * Return true if the allocations are tracked, i.e. the interposer is linked.
+             */
+            static bool isEnabled()
+            {
+                return s_isEnabled.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * Get the allocations of the current thread since it was created.
+             */
+            static Counters getCounters()
+            {
+                Counters counters;
+                counters.allocations = s_allocations;
+                counters.bytes = s_bytes;
+                return counters;
+            }
+
+            /**
+             * Set the policy used when a thread allocates in a no-allocation scope.
+             * @param policy the policy.
+             */
+            static void setPolicy(const Policy& policy)
+            {
+                s_policy.store(policy, std::memory_order_relaxed);
+            }
+
+            /**
+             * Get the policy used when a thread allocates in a no-allocation scope.
+             */
+            static Policy getPolicy()
+            {
+                return s_policy.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * Get the number of allocations in no-allocation scopes (of all the threads).
+             */
+            static std::uint64_t getViolations()
+            {
+                return s_violations.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * Called by the interposer at startup.
+             */
+            static void enable()
+            {
+                s_isEnabled.store(true, std::memory_order_relaxed);
+            }
+
+            /**
+             * Called by the interposer at each allocation. It does not allocate memory.
+             * @param size size of the allocation.
+             * @return true if the allocation has to be reported (logged or aborted).
+             */
+            static bool onAllocation(const std::size_t& size)
+            {
+                s_allocations++;
+                s_bytes += size;
+
+                if(s_forbidDepth == 0 || s_allowDepth > 0)
+                    return false;
+
+                s_violations.fetch_add(1, std::memory_order_relaxed);
+                return s_policy.load(std::memory_order_relaxed) != Policy::Count;
+            }
+        };
+    }
+}
+
+#endif
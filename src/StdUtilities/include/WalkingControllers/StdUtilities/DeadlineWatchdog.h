@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_STD_DEADLINE_WATCHDOG_H
+#define WALKING_CONTROLLERS_STD_DEADLINE_WATCHDOG_H
+
+// std
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace WalkingControllers
+{
+    namespace StdUtilities
+    {
+        /**
+         * DeadlineWatchdog checks the duration of the ticks of a control loop. A tick overruns if
+         * it lasts more than overrunRatio times the period. The number of overruns in the last
+         * window ticks selects the degradation level: the level i is reached when the overruns
+         * are at least thresholds[i - 1]. The levels lower than the sticky level are left when the
+         * overruns decrease, the others can be left only with reset().
+         * It does not allocate memory after initialize().
+         */
+        class DeadlineWatchdog
+        {
+            double m_deadline{0}; /**< A tick lasting more than the deadline overruns. */
+            std::vector<size_t> m_thresholds; /**< Number of overruns required to reach each level. */
+            size_t m_stickyLevel{0}; /**< The levels greater or equal than this one are kept. */
+
+            std::vector<bool> m_window; /**< Overruns of the last ticks (circular buffer). */
+            size_t m_windowIndex{0}; /**< Position of the next tick in the window. */
+            size_t m_overruns{0}; /**< Number of overruns in the window. */
+            size_t m_level{0}; /**< Current level. */
+
+            double m_maxDuration{0}; /**< Maximum duration of a tick since the last reset. */
+            size_t m_totalOverruns{0}; /**< Number of overruns since the last reset. */
+
+        public:
+
+            /**
+             * Initialize the watchdog.
+             * @param period period of the control loop;
+             * @param overrunRatio a tick overruns if it lasts more than overrunRatio * period;
+             * @param window number of ticks considered to evaluate the level;
+             * @param thresholds number of overruns required to reach the levels 1, 2, ... (non
+             * decreasing and not greater than the window);
+             * @param stickyLevel the levels greater or equal than this one are left only by reset().
+             * @return true/false in case of success/failure
+             */
+            bool initialize(const double& period, const double& overrunRatio, const size_t& window,
+                            const std::vector<size_t>& thresholds, const size_t& stickyLevel)
+            {
+                if(period <= 0 || overrunRatio <= 0 || window == 0)
+                {
+                    std::cerr << "[StdUtilities::DeadlineWatchdog::initialize] The period, the overrun "
+                              << "ratio and the window are supposed to be positive." << std::endl;
+                    return false;
+                }
+
+                if(thresholds.empty() || thresholds.front() == 0 || thresholds.back() > window
+                   || !std::is_sorted(thresholds.begin(), thresholds.end()))
+                {
+                    std::cerr << "[StdUtilities::DeadlineWatchdog::initialize] The thresholds are "
+                              << "supposed to be positive, non decreasing and not greater than the window."
+                              << std::endl;
+                    return false;
+                }
+
+                m_deadline = period * overrunRatio;
+                m_thresholds = thresholds;
+                m_stickyLevel = stickyLevel;
+                m_window.assign(window, false);
+                reset();
+                return true;
+            }
+
+            /**
+             * Add the duration of a tick.
+             * @param duration duration of the tick.
+             * @return true if the level changed.
+             */
+            bool update(const double& duration)
+            {
+                if(m_window.empty())
+                    return false;
+
+                const bool isOverrun = duration > m_deadline;
+                m_maxDuration = std::max(m_maxDuration, duration);
+                if(isOverrun)
+                    m_totalOverruns++;
+
+                if(m_window[m_windowIndex])
+                    m_overruns--;
+                m_window[m_windowIndex] = isOverrun;
+                if(isOverrun)
+                    m_overruns++;
+                m_windowIndex = (m_windowIndex + 1) % m_window.size();
+
+                size_t level = 0;
+                while(level < m_thresholds.size() && m_overruns >= m_thresholds[level])
+                    level++;
+
+                if(level < m_level && m_level >= m_stickyLevel)
+                    return false;
+
+                if(level == m_level)
+                    return false;
+
+                m_level = level;
+                return true;
+            }
+
+            /**
+             * Clear the window and go back to the level 0.
+             */
+            void reset()
+            {
+                std::fill(m_window.begin(), m_window.end(), false);
+                m_windowIndex = 0;
+                m_overruns = 0;
+                m_level = 0;
+                m_maxDuration = 0;
+                m_totalOverruns = 0;
+            }
+
+            /**
+             * Get the current level (0 if there are no degradations).
+             */
+            size_t getLevel() const
+            {
+                return m_level;
+            }
+
+            /**
+             * Get the number of overruns in the window.
+             */
+            size_t getOverruns() const
+            {
+                return m_overruns;
+            }
+
+            /**
+             * Get the number of overruns since the last reset.
+             */
+            size_t getTotalOverruns() const
+            {
+                return m_totalOverruns;
+            }
+
+            /**
+             * Get the maximum duration of a tick since the last reset.
+             */
+            double getMaxDuration() const
+            {
+                return m_maxDuration;
+            }
+        };
+    }
+}
+
+#endif
@@ -5,8 +5,10 @@
 #define WALKING_CONTROLLERS_STD_HELPER_H
 
 // std
-#include <vector>
+#include <cstddef>
 #include <deque>
+#include <iostream>
+#include <vector>
 
 namespace WalkingControllers
 {
@@ -17,13 +19,14 @@ namespace WalkingControllers
     namespace StdUtilities
     {
         /**
-         * Allow you to append vector to a deque.
+         * Allow you to append vector to a deque. The vector can use any allocator (e.g. a
+         * std::pmr::vector taking the memory from a TickArena).
          * @param input input vector;
          * @param output output deque;
          * @param initPoint point where the vector will be append to the deque
          */
-        template<typename T>
-        bool appendVectorToDeque(const std::vector<T>& input, std::deque<T>& output, const size_t& initPoint);
+        template<typename T, typename Allocator>
+        bool appendVectorToDeque(const std::vector<T, Allocator>& input, std::deque<T>& output, const size_t& initPoint);
     }
 }
 #include "Helper.tpp"
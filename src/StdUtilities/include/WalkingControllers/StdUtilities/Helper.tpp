@@ -1,5 +1,5 @@
-template<typename T>
-bool WalkingControllers::StdUtilities::appendVectorToDeque(const std::vector<T>& input, std::deque<T>& output, const size_t& initPoint)
+template<typename T, typename Allocator>
+bool WalkingControllers::StdUtilities::appendVectorToDeque(const std::vector<T, Allocator>& input, std::deque<T>& output, const size_t& initPoint)
 {
     if(initPoint > output.size())
     {
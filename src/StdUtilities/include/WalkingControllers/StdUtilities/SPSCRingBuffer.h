@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_STD_SPSC_RING_BUFFER_H
+#define WALKING_CONTROLLERS_STD_SPSC_RING_BUFFER_H
+
+// std
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+namespace WalkingControllers
+{
+    namespace StdUtilities
+    {
+        /**
+         * SPSCRingBuffer is a lock-free single producer single consumer ring buffer of fixed size
+         * records. Each record is a contiguous array of recordSize elements of type T. The memory
+         * is allocated once by initialize(), then the producer writes the records in place:
+         * \code{.cpp}
+         * if(double* record = ring.acquire())
+         * {
+         *     // fill the record
+         *     ring.commit();
+         * }
+         * \endcode
+         * and the consumer reads them with front() and pop().
+         */
+        template <typename T>
+        class SPSCRingBuffer
+        {
+            std::vector<T> m_data; /**< Storage of the records. */
+            size_t m_capacity{0}; /**< Maximum number of records. */
+            size_t m_recordSize{0}; /**< Number of elements of each record. */
+
+            alignas(64) std::atomic<size_t> m_head{0}; /**< Number of records written by the producer. */
+            alignas(64) std::atomic<size_t> m_tail{0}; /**< Number of records read by the consumer. */
+
+        public:
+
+            /**
+             * Initialize the buffer. It is not thread safe.
+             * @param capacity maximum number of records stored in the buffer;
+             * @param recordSize number of elements of each record.
+             * @return true/false in case of success/failure
+             */
+            bool initialize(const size_t capacity, const size_t recordSize)
+            {
+                if(capacity == 0 || recordSize == 0)
+                {
+                    std::cerr << "[StdUtilities::SPSCRingBuffer::initialize] The capacity and the size "
+                              << "of the record have to be positive numbers." << std::endl;
+                    return false;
+                }
+
+                m_capacity = capacity;
+                m_recordSize = recordSize;
+                m_data.assign(capacity * recordSize, T());
+                m_head = 0;
+                m_tail = 0;
+                return true;
+            }
+
+            /**
+             * Get the record that will be written by the producer.
+             * @return a pointer to the record or nullptr if the buffer is full.
+             */
+            T* acquire()
+            {
+                const size_t head = m_head.load(std::memory_order_relaxed);
+                if(head - m_tail.load(std::memory_order_acquire) == m_capacity)
+                    return nullptr;
+
+                return m_data.data() + (head % m_capacity) * m_recordSize;
+            }
+
+            /**
+             * Make the record obtained with acquire() available to the consumer.
+             */
+            void commit()
+            {
+                m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+            /**
+             * Get the oldest record written by the producer.
+             * @return a pointer to the record or nullptr if the buffer is empty.
+             */
+            const T* front() const
+            {
+                const size_t tail = m_tail.load(std::memory_order_relaxed);
+                if(m_head.load(std::memory_order_acquire) == tail)
+                    return nullptr;
+
+                return m_data.data() + (tail % m_capacity) * m_recordSize;
+            }
+
+            /**
+             * Release the record obtained with front().
+             */
+            void pop()
+            {
+                m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+            /**
+             * Get the number of records stored in the buffer.
+             */
+            size_t size() const
+            {
+                return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+            }
+
+            /**
+             * Get the maximum number of records.
+             */
+            size_t capacity() const
+            {
+                return m_capacity;
+            }
+
+            /**
+             * Get the number of elements of each record.
+             */
+            size_t recordSize() const
+            {
+                return m_recordSize;
+            }
+        };
+    }
+}
+
+#endif
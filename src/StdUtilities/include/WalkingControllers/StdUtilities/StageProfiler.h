@@ -0,0 +1,339 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_STD_STAGE_PROFILER_H
+#define WALKING_CONTROLLERS_STD_STAGE_PROFILER_H
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <WalkingControllers/StdUtilities/AllocationTracker.h>
+
+namespace WalkingControllers
+{
+    namespace StdUtilities
+    {
+        /**
+         * StageProfiler measures the duration of the stages of a control loop.
+         * The durations are stored in a log-linear histogram (the same layout used by HDR
+         * histograms): the values lower than 2^bucketBits nanoseconds are stored in linear
+         * buckets, then each power of two is divided in 2^(bucketBits - 1) buckets. Hence the
+         * relative error of the percentiles is lower than 1 / 2^(bucketBits - 1) (about 1.6%).
+         * The histograms are updated with relaxed atomic operations, so they can be read (and the
+         * stages can be measured) by any thread without locks.
+         * If the AllocationTracker is enabled the timers also count the heap allocations of the
+         * thread in which the stage runs.
+         * \code{.cpp}
+         * {
+         *     auto timer = profiler.scopedTimer(stage);
+         *     // code to be measured
+         * }
+         * \endcode
+         */
+        class StageProfiler
+        {
+            static constexpr int bucketBits = 7; /**< Number of bits used for the linear buckets. */
+            static constexpr int maxValueBits = 40; /**< Values greater than 2^40 ns are saturated. */
+            static constexpr size_t linearBuckets = size_t(1) << bucketBits;
+            static constexpr size_t halfLinearBuckets = linearBuckets / 2;
+            static constexpr size_t numberOfBuckets
+                = linearBuckets + (maxValueBits - bucketBits + 1) * halfLinearBuckets;
+
+            struct Stage
+            {
+                std::string name; /**< Name of the stage. */
+                std::unique_ptr<std::atomic<std::uint64_t>[]> buckets; /**< Histogram. */
+                std::atomic<std::uint64_t> count{0}; /**< Number of samples. */
+                std::atomic<std::uint64_t> sum{0}; /**< Sum of the samples in nanoseconds. */
+                std::atomic<std::uint64_t> max{0}; /**< Maximum sample in nanoseconds. */
+                std::atomic<std::uint64_t> allocations{0}; /**< Sum of the allocations. */
+                std::atomic<std::uint64_t> maxAllocations{0}; /**< Maximum allocations in a sample. */
+            };
+
+            std::vector<std::unique_ptr<Stage>> m_stages; /**< Profiled stages. */
+
+            /**
+             * Get the bucket containing a value.
+             * @param value value in nanoseconds.
+             * @return the index of the bucket.
+             */
+            static size_t bucketIndex(std::uint64_t value)
+            {
+                if(value >= (std::uint64_t(1) << maxValueBits))
+                    value = (std::uint64_t(1) << maxValueBits) - 1;
+
+                if(value < linearBuckets)
+                    return static_cast<size_t>(value);
+
+                int mostSignificantBit = 63;
+                while(!(value & (std::uint64_t(1) << mostSignificantBit)))
+                    mostSignificantBit--;
+
+                const int shift = mostSignificantBit - (bucketBits - 1);
+                const size_t mantissa = static_cast<size_t>(value >> shift);
+                return linearBuckets + (shift - 1) * halfLinearBuckets + (mantissa - halfLinearBuckets);
+            }
+
+            /**
+             * Get the value represented by a bucket (the center of the bucket).
+             * @param index index of the bucket.
+             * @return the value in nanoseconds.
+             */
+            static double bucketValue(const size_t& index)
+            {
+                if(index < linearBuckets)
+                    return static_cast<double>(index);
+
+                const size_t shift = (index - linearBuckets) / halfLinearBuckets + 1;
+                const size_t mantissa = (index - linearBuckets) % halfLinearBuckets + halfLinearBuckets;
+                const double lowerBound = static_cast<double>(std::uint64_t(mantissa) << shift);
+                return lowerBound + static_cast<double>(std::uint64_t(1) << shift) / 2;
+            }
+
+        public:
+
+            /**
+             * Statistics of a stage (the times are expressed in seconds).
+             */
+            struct Statistics
+            {
+                std::string name; /**< Name of the stage. */
+                std::uint64_t count{0}; /**< Number of samples. */
+                double mean{0}; /**< Mean duration. */
+                double p50{0}; /**< Median. */
+                double p99{0}; /**< 99th percentile. */
+                double p999{0}; /**< 99.9th percentile. */
+                double max{0}; /**< Maximum duration. */
+                double allocations{0}; /**< Mean number of heap allocations. */
+                std::uint64_t maxAllocations{0}; /**< Maximum number of heap allocations. */
+            };
+
+            /**
+             * RAII timer. The duration of its lifetime (or until stop() is called) is added to the
+             * histogram of the stage.
+             */
+            class ScopedTimer
+            {
+                StageProfiler* m_profiler; /**< Profiler (nullptr if the timer is stopped). */
+                size_t m_stage; /**< Index of the stage. */
+                std::chrono::steady_clock::time_point m_start; /**< Initial time. */
+                std::uint64_t m_allocations; /**< Allocations of the thread at the initial time. */
+
+            public:
+
+                ScopedTimer(StageProfiler& profiler, const size_t& stage)
+                    : m_profiler(&profiler), m_stage(stage), m_start(std::chrono::steady_clock::now()),
+                      m_allocations(AllocationTracker::getCounters().allocations)
+                {
+                }
+
+                ScopedTimer(ScopedTimer&& other)
+                    : m_profiler(other.m_profiler), m_stage(other.m_stage), m_start(other.m_start),
+                      m_allocations(other.m_allocations)
+                {
+                    other.m_profiler = nullptr;
+                }
+
+                ScopedTimer(const ScopedTimer&) = delete;
+                ScopedTimer& operator=(const ScopedTimer&) = delete;
+                ScopedTimer& operator=(ScopedTimer&&) = delete;
+
+                ~ScopedTimer()
+                {
+                    stop();
+                }
+
+                /**
+                 * Stop the timer before the end of the scope.
+                 */
+                void stop()
+                {
+                    if(m_profiler == nullptr)
+                        return;
+
+                    m_profiler->addSample(m_stage, std::chrono::steady_clock::now() - m_start,
+                                          AllocationTracker::getCounters().allocations - m_allocations);
+                    m_profiler = nullptr;
+                }
+            };
+
+            /**
+             * Add a stage. It is not thread safe and it has to be called before profiling.
+             * @param name name of the stage.
+             * @return the index of the stage.
+             */
+            size_t addStage(const std::string& name)
+            {
+                auto stage = std::make_unique<Stage>();
+                stage->name = name;
+                stage->buckets = std::make_unique<std::atomic<std::uint64_t>[]>(numberOfBuckets);
+                for(size_t i = 0; i < numberOfBuckets; i++)
+                    stage->buckets[i] = 0;
+
+                m_stages.push_back(std::move(stage));
+                return m_stages.size() - 1;
+            }
+
+            /**
+             * Get the number of stages.
+             */
+            size_t numberOfStages() const
+            {
+                return m_stages.size();
+            }
+
+            /**
+             * Start a timer.
+             * @param stage index of the stage.
+             * @return the timer.
+             */
+            ScopedTimer scopedTimer(const size_t& stage)
+            {
+                return ScopedTimer(*this, stage);
+            }
+
+            /**
+             * Add a sample to the histogram of a stage. It does not allocate memory.
+             * @param stage index of the stage;
+             * @param duration duration of the stage;
+             * @param allocations number of heap allocations of the stage.
+             */
+            void addSample(const size_t& stage, const std::chrono::steady_clock::duration& duration,
+                           const std::uint64_t& allocations = 0)
+            {
+                if(stage >= m_stages.size())
+                    return;
+
+                const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+                const std::uint64_t value = nanoseconds > 0 ? static_cast<std::uint64_t>(nanoseconds) : 0;
+
+                Stage& data = *m_stages[stage];
+                data.buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+                data.count.fetch_add(1, std::memory_order_relaxed);
+                data.sum.fetch_add(value, std::memory_order_relaxed);
+
+                std::uint64_t max = data.max.load(std::memory_order_relaxed);
+                while(value > max && !data.max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+
+                data.allocations.fetch_add(allocations, std::memory_order_relaxed);
+                std::uint64_t maxAllocations = data.maxAllocations.load(std::memory_order_relaxed);
+                while(allocations > maxAllocations
+                      && !data.maxAllocations.compare_exchange_weak(maxAllocations, allocations,
+                                                                    std::memory_order_relaxed));
+            }
+
+            /**
+             * Reset the histograms.
+             */
+            void reset()
+            {
+                for(auto& stage : m_stages)
+                {
+                    for(size_t i = 0; i < numberOfBuckets; i++)
+                        stage->buckets[i].store(0, std::memory_order_relaxed);
+                    stage->count = 0;
+                    stage->sum = 0;
+                    stage->max = 0;
+                    stage->allocations = 0;
+                    stage->maxAllocations = 0;
+                }
+            }
+
+            /**
+             * Compute the statistics of a stage.
+             * @param stage index of the stage.
+             * @return the statistics.
+             */
+            Statistics getStatistics(const size_t& stage) const
+            {
+                Statistics statistics;
+                if(stage >= m_stages.size())
+                    return statistics;
+
+                const Stage& data = *m_stages[stage];
+                statistics.name = data.name;
+
+                // the histogram may be updated while it is read, the percentiles are evaluated on
+                // the samples counted in the buckets
+                std::uint64_t count = 0;
+                for(size_t i = 0; i < numberOfBuckets; i++)
+                    count += data.buckets[i].load(std::memory_order_relaxed);
+
+                statistics.count = count;
+                if(count == 0)
+                    return statistics;
+
+                statistics.mean = static_cast<double>(data.sum.load(std::memory_order_relaxed))
+                    / std::max<std::uint64_t>(data.count.load(std::memory_order_relaxed), 1) * 1e-9;
+                statistics.max = static_cast<double>(data.max.load(std::memory_order_relaxed)) * 1e-9;
+                statistics.allocations = static_cast<double>(data.allocations.load(std::memory_order_relaxed))
+                    / std::max<std::uint64_t>(data.count.load(std::memory_order_relaxed), 1);
+                statistics.maxAllocations = data.maxAllocations.load(std::memory_order_relaxed);
+
+                const double percentiles[3] = {0.5, 0.99, 0.999};
+                double* outputs[3] = {&statistics.p50, &statistics.p99, &statistics.p999};
+                size_t percentile = 0;
+                std::uint64_t cumulative = 0;
+                for(size_t i = 0; i < numberOfBuckets && percentile < 3; i++)
+                {
+                    cumulative += data.buckets[i].load(std::memory_order_relaxed);
+                    while(percentile < 3 && cumulative >= percentiles[percentile] * count)
+                    {
+                        *outputs[percentile] = std::min(bucketValue(i) * 1e-9, statistics.max);
+                        percentile++;
+                    }
+                }
+
+                return statistics;
+            }
+
+            /**
+             * Get a table containing the statistics of all the stages (in milliseconds). If the
+             * AllocationTracker is enabled the mean and the maximum number of allocations are
+             * added.
+             */
+            std::string getReport() const
+            {
+                const bool addAllocations = AllocationTracker::isEnabled();
+
+                std::ostringstream report;
+                report << std::left << std::setw(20) << "stage" << std::right
+                       << std::setw(10) << "count" << std::setw(10) << "mean"
+                       << std::setw(10) << "p50" << std::setw(10) << "p99"
+                       << std::setw(10) << "p99.9" << std::setw(10) << "max";
+                if(addAllocations)
+                    report << std::setw(10) << "allocs" << std::setw(12) << "max allocs";
+                report << "\n";
+
+                report << std::fixed << std::setprecision(3);
+                for(size_t i = 0; i < m_stages.size(); i++)
+                {
+                    const Statistics statistics = getStatistics(i);
+                    report << std::left << std::setw(20) << statistics.name << std::right
+                           << std::setw(10) << statistics.count
+                           << std::setw(10) << statistics.mean * 1e3
+                           << std::setw(10) << statistics.p50 * 1e3
+                           << std::setw(10) << statistics.p99 * 1e3
+                           << std::setw(10) << statistics.p999 * 1e3
+                           << std::setw(10) << statistics.max * 1e3;
+                    if(addAllocations)
+                        report << std::setw(10) << statistics.allocations
+                               << std::setw(12) << statistics.maxAllocations;
+                    report << "\n";
+                }
+
+                return report.str();
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,309 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_STD_TASK_GRAPH_H
+#define WALKING_CONTROLLERS_STD_TASK_GRAPH_H
+
+// std
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace WalkingControllers
+{
+    namespace StdUtilities
+    {
+        /**
+         * TaskGraph executes a set of tasks respecting their dependencies. Independent tasks are
+         * executed concurrently by a small pool of worker threads (optionally pinned to a set of
+         * cores). The thread calling run() or wait() takes part in the execution, hence a graph
+         * without workers runs all the tasks serially in the order they were added.
+         * The graph is built once (addTask() and initialize()), then it can be run at each control
+         * tick without allocating memory.
+         */
+        class TaskGraph
+        {
+            struct Task
+            {
+                std::string name; /**< Name of the task. */
+                std::function<bool()> function; /**< Function executed by the task. */
+                std::vector<size_t> dependents; /**< Tasks depending on this task. */
+                size_t numberOfDependencies{0}; /**< Number of tasks this task depends on. */
+                size_t remainingDependencies{0}; /**< Dependencies not yet completed in the current run. */
+            };
+
+            std::vector<Task> m_tasks; /**< Tasks of the graph. */
+            std::vector<size_t> m_readyTasks; /**< Tasks ready to be executed (used as a stack). */
+            size_t m_completedTasks{0}; /**< Number of tasks completed in the current run. */
+            std::string m_failedTask; /**< Name of the first task failed in the current run. */
+
+            bool m_isRunning{false}; /**< True if the graph is running. */
+            bool m_isClosing{false}; /**< True if the workers have to be closed. */
+
+            std::vector<std::thread> m_workers; /**< Worker threads. */
+            std::mutex m_mutex; /**< Mutex. */
+            std::condition_variable m_workersCondition; /**< Used to wake up the workers. */
+            std::condition_variable m_doneCondition; /**< Used to notify that the graph is completed. */
+
+            /**
+             * Execute one of the ready tasks. The lock is released while the task is executed.
+             * @param lock lock on m_mutex.
+             */
+            void executeReadyTask(std::unique_lock<std::mutex>& lock)
+            {
+                const size_t index = m_readyTasks.back();
+                m_readyTasks.pop_back();
+
+                lock.unlock();
+                const bool ok = m_tasks[index].function();
+                lock.lock();
+
+                if(!ok && m_failedTask.empty())
+                    m_failedTask = m_tasks[index].name;
+
+                for(const size_t dependent : m_tasks[index].dependents)
+                {
+                    if(--m_tasks[dependent].remainingDependencies == 0)
+                        m_readyTasks.push_back(dependent);
+                }
+
+                if(++m_completedTasks == m_tasks.size())
+                {
+                    m_isRunning = false;
+                    m_doneCondition.notify_all();
+                }
+                else if(!m_readyTasks.empty())
+                {
+                    m_workersCondition.notify_one();
+                    m_doneCondition.notify_all();
+                }
+            }
+
+            /**
+             * Main method of the workers.
+             */
+            void workerThread()
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while(true)
+                {
+                    m_workersCondition.wait(lock, [this]{ return m_isClosing || !m_readyTasks.empty(); });
+                    if(m_isClosing)
+                        return;
+
+                    executeReadyTask(lock);
+                }
+            }
+
+            /**
+             * Pin a thread to a core.
+             * @param thread the thread;
+             * @param core index of the core.
+             * @return true/false in case of success/failure
+             */
+            static bool pinThread(std::thread& thread, const int core)
+            {
+#ifdef __linux__
+                cpu_set_t cpuSet;
+                CPU_ZERO(&cpuSet);
+                CPU_SET(core, &cpuSet);
+                return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+                return false;
+#endif
+            }
+
+        public:
+
+            /**
+             * Destructor.
+             */
+            ~TaskGraph()
+            {
+                {
+                    std::lock_guard<std::mutex> guard(m_mutex);
+                    m_isClosing = true;
+                    m_workersCondition.notify_all();
+                }
+
+                for(auto& worker : m_workers)
+                {
+                    if(worker.joinable())
+                        worker.join();
+                }
+            }
+
+            /**
+             * Add a task to the graph. It has to be called before initialize().
+             * @param name name of the task;
+             * @param function function executed by the task. It returns false in case of failure;
+             * @param dependencies names of the tasks (already added) that have to be completed
+             * before this task.
+             * @return true/false in case of success/failure
+             */
+            bool addTask(const std::string& name, std::function<bool()> function,
+                         const std::vector<std::string>& dependencies = {})
+            {
+                if(!m_workers.empty())
+                {
+                    std::cerr << "[StdUtilities::TaskGraph::addTask] The tasks cannot be added after the initialization."
+                              << std::endl;
+                    return false;
+                }
+
+                Task task;
+                task.name = name;
+                task.function = std::move(function);
+                task.numberOfDependencies = dependencies.size();
+
+                const size_t index = m_tasks.size();
+                for(const auto& dependency : dependencies)
+                {
+                    size_t i = 0;
+                    while(i < m_tasks.size() && m_tasks[i].name != dependency)
+                        i++;
+
+                    if(i == m_tasks.size())
+                    {
+                        std::cerr << "[StdUtilities::TaskGraph::addTask] Unable to find the task named "
+                                  << dependency << ". The dependencies have to be added first." << std::endl;
+                        for(auto& other : m_tasks)
+                        {
+                            if(!other.dependents.empty() && other.dependents.back() == index)
+                                other.dependents.pop_back();
+                        }
+                        return false;
+                    }
+                    m_tasks[i].dependents.push_back(index);
+                }
+
+                m_tasks.push_back(std::move(task));
+                return true;
+            }
+
+            /**
+             * Initialize the worker pool.
+             * @param numberOfWorkers number of worker threads. If zero the tasks are executed
+             * serially by the thread calling run();
+             * @param cores cores where the workers are pinned (the i-th worker is pinned on
+             * cores[i % cores.size()]). If empty the workers are not pinned.
+             * @return true/false in case of success/failure
+             */
+            bool initialize(const size_t numberOfWorkers, const std::vector<int>& cores = {})
+            {
+                if(!m_workers.empty())
+                {
+                    std::cerr << "[StdUtilities::TaskGraph::initialize] The graph is already initialized."
+                              << std::endl;
+                    return false;
+                }
+
+                m_readyTasks.reserve(m_tasks.size());
+                m_failedTask.reserve(64);
+
+                for(size_t i = 0; i < numberOfWorkers; i++)
+                {
+                    m_workers.emplace_back(&TaskGraph::workerThread, this);
+
+                    if(!cores.empty() && !pinThread(m_workers.back(), cores[i % cores.size()]))
+                    {
+                        std::cerr << "[StdUtilities::TaskGraph::initialize] Unable to pin the worker " << i
+                                  << " on the core " << cores[i % cores.size()] << "." << std::endl;
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * Start the execution of the graph without waiting for its completion.
+             * @return true/false in case of success/failure
+             */
+            bool start()
+            {
+                std::lock_guard<std::mutex> guard(m_mutex);
+                if(m_isRunning)
+                {
+                    std::cerr << "[StdUtilities::TaskGraph::start] The graph is already running." << std::endl;
+                    return false;
+                }
+
+                if(m_tasks.empty())
+                    return true;
+
+                m_completedTasks = 0;
+                m_failedTask.clear();
+                m_readyTasks.clear();
+                for(size_t i = 0; i < m_tasks.size(); i++)
+                {
+                    m_tasks[i].remainingDependencies = m_tasks[i].numberOfDependencies;
+                    if(m_tasks[i].numberOfDependencies == 0)
+                        m_readyTasks.push_back(i);
+                }
+
+                // the tasks are popped from the back, reverse them to keep the insertion order
+                // when the graph is executed serially
+                std::reverse(m_readyTasks.begin(), m_readyTasks.end());
+
+                m_isRunning = true;
+                m_workersCondition.notify_all();
+                return true;
+            }
+
+            /**
+             * Wait for the completion of the graph. The calling thread executes the ready tasks
+             * while waiting.
+             * @return true if all the tasks succeeded, false otherwise
+             */
+            bool wait()
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while(m_isRunning)
+                {
+                    if(!m_readyTasks.empty())
+                        executeReadyTask(lock);
+                    else
+                        m_doneCondition.wait(lock, [this]{ return !m_isRunning || !m_readyTasks.empty(); });
+                }
+
+                if(!m_failedTask.empty())
+                {
+                    std::cerr << "[StdUtilities::TaskGraph::wait] The task named " << m_failedTask
+                              << " failed." << std::endl;
+                    return false;
+                }
+                return true;
+            }
+
+            /**
+             * Execute the graph and wait for its completion.
+             * @return true if all the tasks succeeded, false otherwise
+             */
+            bool run()
+            {
+                return start() && wait();
+            }
+
+            /**
+             * Get the number of worker threads.
+             */
+            size_t numberOfWorkers() const
+            {
+                return m_workers.size();
+            }
+        };
+    }
+}
+
+#endif
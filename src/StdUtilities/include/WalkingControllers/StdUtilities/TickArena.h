@@ -0,0 +1,215 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_STD_TICK_ARENA_H
+#define WALKING_CONTROLLERS_STD_TICK_ARENA_H
+
+// std
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+namespace WalkingControllers
+{
+    namespace StdUtilities
+    {
+        /**
+         * TickArena is a monotonic memory resource for the temporaries of a tick of a control
+         * loop. The memory is taken from a buffer allocated by reserve() and it is released all
+         * together by reset(), that is called at the beginning of each tick. The deallocations are
+         * ignored. If the buffer is full the memory is taken from the heap (and released by the
+         * following reset()) and the overflow is counted, so the peak usage can be used to size the
+         * buffer.
+         * The arena can be used directly or through the std::pmr containers:
+         * \code{.cpp}
+         * arena.reset();
+         * double* buffer = arena.allocateArray<double>(size);
+         * std::pmr::vector<iDynTree::Transform> transforms(&arena);
+         * \endcode
+         * The memory is valid only until the following reset(). The arena is not thread safe and
+         * it may be used only from the thread of the tick: a function called also by other threads
+         * has to take the memory resource as a parameter instead of using the arena directly.
+         */
+        class TickArena : public std::pmr::memory_resource
+        {
+            /**
+             * Header of a block allocated in the heap when the buffer is full.
+             */
+            struct OverflowBlock
+            {
+                OverflowBlock* next; /**< Next block. */
+                std::size_t alignment; /**< Alignment of the block. */
+            };
+
+            std::unique_ptr<std::byte[]> m_buffer; /**< Preallocated buffer. */
+            std::size_t m_capacity{0}; /**< Size of the buffer. */
+            std::size_t m_used{0}; /**< Bytes used in the current tick (overflows included). */
+            std::size_t m_offset{0}; /**< First free byte of the buffer. */
+            std::size_t m_peak{0}; /**< Maximum number of bytes used in a tick. */
+            std::uint64_t m_overflows{0}; /**< Number of allocations taken from the heap. */
+            OverflowBlock* m_overflowBlocks{nullptr}; /**< Blocks allocated in the current tick. */
+
+            /**
+             * Release the blocks allocated in the heap.
+             */
+            void releaseOverflowBlocks()
+            {
+                while(m_overflowBlocks != nullptr)
+                {
+                    OverflowBlock* next = m_overflowBlocks->next;
+                    ::operator delete(static_cast<void*>(m_overflowBlocks), std::align_val_t(m_overflowBlocks->alignment));
+                    m_overflowBlocks = next;
+                }
+            }
+
+        protected:
+
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override
+            {
+                if(bytes == 0)
+                    bytes = 1;
+
+                m_used += bytes;
+                m_peak = std::max(m_peak, m_used);
+
+                const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+                const std::size_t begin = ((base + m_offset + alignment - 1) & ~(std::uintptr_t(alignment) - 1)) - base;
+                if(m_buffer != nullptr && begin + bytes <= m_capacity)
+                {
+                    m_offset = begin + bytes;
+                    return m_buffer.get() + begin;
+                }
+
+                // the header is padded to keep the alignment of the returned memory
+                m_overflows++;
+                const std::size_t blockAlignment = std::max(alignment, alignof(std::max_align_t));
+                const std::size_t header = (sizeof(OverflowBlock) + blockAlignment - 1) / blockAlignment * blockAlignment;
+                void* memory = ::operator new(header + bytes, std::align_val_t(blockAlignment));
+                OverflowBlock* block = static_cast<OverflowBlock*>(memory);
+                block->next = m_overflowBlocks;
+                block->alignment = blockAlignment;
+                m_overflowBlocks = block;
+                return static_cast<std::byte*>(memory) + header;
+            }
+
+            void do_deallocate(void*, std::size_t, std::size_t) override
+            {
+                // the memory is released by reset()
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+
+        public:
+
+            /**
+             * Constructor.
+             * @param capacity size of the buffer in bytes.
+             */
+            explicit TickArena(const std::size_t& capacity = 0)
+            {
+                reserve(capacity);
+            }
+
+            TickArena(const TickArena&) = delete;
+            TickArena& operator=(const TickArena&) = delete;
+
+            ~TickArena() override
+            {
+                releaseOverflowBlocks();
+            }
+
+            /**
+             * Allocate the buffer. It allocates memory so it has to be called before the control
+             * loop. The memory previously taken from the arena is released.
+             * @param capacity size of the buffer in bytes.
+             */
+            void reserve(const std::size_t& capacity)
+            {
+                m_buffer = capacity > 0 ? std::make_unique<std::byte[]>(capacity) : nullptr;
+                m_capacity = capacity;
+                m_peak = 0;
+                m_overflows = 0;
+                reset();
+            }
+
+            /**
+             * Release all the memory taken from the arena. The overflow blocks are deleted.
+             */
+            void reset()
+            {
+                releaseOverflowBlocks();
+                m_used = 0;
+                m_offset = 0;
+            }
+
+            /**
+             * Take an array of objects from the arena. The objects are value initialized and they
+             * are never destroyed, hence only trivially destructible types are allowed.
+             * @param size number of elements.
+             * @return a pointer to the first element.
+             */
+            template <typename T>
+            T* allocateArray(const std::size_t& size)
+            {
+                static_assert(std::is_trivially_destructible<T>::value,
+                              "The objects allocated in the arena are never destroyed.");
+
+                T* array = static_cast<T*>(allocate(size * sizeof(T), alignof(T)));
+                for(std::size_t i = 0; i < size; i++)
+                    new (array + i) T();
+                return array;
+            }
+
+            /**
+             * Get the size of the buffer in bytes.
+             */
+            std::size_t getCapacity() const
+            {
+                return m_capacity;
+            }
+
+            /**
+             * Get the number of bytes taken from the arena since the last reset().
+             */
+            std::size_t getUsedBytes() const
+            {
+                return m_used;
+            }
+
+            /**
+             * Get the maximum number of bytes taken from the arena in a tick (the overflows are
+             * included).
+             */
+            std::size_t getPeakBytes() const
+            {
+                return m_peak;
+            }
+
+            /**
+             * Get the number of allocations that did not fit in the buffer.
+             */
+            std::uint64_t getOverflows() const
+            {
+                return m_overflows;
+            }
+
+            /**
+             * Reset the peak usage and the number of overflows.
+             */
+            void resetStatistics()
+            {
+                m_peak = m_used;
+                m_overflows = 0;
+            }
+        };
+    }
+}
+
+#endif
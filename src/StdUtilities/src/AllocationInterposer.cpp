@@ -0,0 +1,323 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Replacement of the global operator new and delete used by AllocationTracker. The file is
+// compiled in the applications (not in a library) so that the operators of the whole process are
+// replaced. With glibc also malloc, calloc, realloc, free and the aligned allocation functions are
+// replaced (hence the allocations of C code and of strdup are counted); they forward to the
+// __libc_* implementations.
+
+// std
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <cerrno>
+#include <execinfo.h>
+#include <malloc.h>
+#include <unistd.h>
+
+extern "C"
+{
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t number, std::size_t size);
+    void* __libc_realloc(void* pointer, std::size_t size);
+    void* __libc_memalign(std::size_t alignment, std::size_t size);
+    void __libc_free(void* pointer);
+}
+#endif
+
+#include <WalkingControllers/StdUtilities/AllocationTracker.h>
+
+using namespace WalkingControllers::StdUtilities;
+
+namespace
+{
+    constexpr int maxLoggedViolations = 100; /**< The following violations are only counted. */
+    std::atomic<int> loggedViolations{0}; /**< Number of logged violations. */
+
+    /**
+     * Enable the tracker when the application is loaded.
+     */
+    struct TrackerEnabler
+    {
+        TrackerEnabler()
+        {
+            AllocationTracker::enable();
+        }
+    } trackerEnabler;
+
+    /**
+     * Print the backtrace of an allocation in a no-allocation scope and abort if required.
+     * @param size size of the allocation.
+     */
+    void reportViolation(const std::size_t& size)
+    {
+        // the output and the backtrace may allocate memory
+        AllocationTracker::ScopedAllow allow;
+
+        const bool abort = AllocationTracker::getPolicy() == AllocationTracker::Policy::Abort;
+        const int index = loggedViolations.fetch_add(1, std::memory_order_relaxed);
+        if(!abort && index >= maxLoggedViolations)
+        {
+            if(index == maxLoggedViolations)
+                std::fprintf(stderr, "[AllocationTracker] Too many allocations in no-allocation "
+                             "scopes. The following ones are only counted.\n");
+            return;
+        }
+
+        std::fprintf(stderr, "[AllocationTracker] Allocation of %zu bytes in a no-allocation scope.\n", size);
+#if defined(__GLIBC__)
+        void* frames[64];
+        const int numberOfFrames = backtrace(frames, 64);
+        backtrace_symbols_fd(frames, numberOfFrames, STDERR_FILENO);
+#endif
+
+        if(abort)
+            std::abort();
+    }
+
+    void* allocate(std::size_t size, const std::size_t& alignment)
+    {
+        if(size == 0)
+            size = 1;
+
+        void* pointer = nullptr;
+        while(true)
+        {
+#if defined(__GLIBC__)
+            // malloc is replaced too, the allocation is counted only once
+            if(alignment <= alignof(std::max_align_t))
+                pointer = __libc_malloc(size);
+            else
+                pointer = __libc_memalign(alignment, size);
+#elif defined(_MSC_VER)
+            if(alignment <= alignof(std::max_align_t))
+                pointer = std::malloc(size);
+            else
+                pointer = _aligned_malloc(size, alignment);
+#else
+            if(alignment <= alignof(std::max_align_t))
+                pointer = std::malloc(size);
+            else if(posix_memalign(&pointer, alignment, size) != 0)
+                pointer = nullptr;
+#endif
+
+            if(pointer != nullptr)
+                break;
+
+            std::new_handler handler = std::get_new_handler();
+            if(handler == nullptr)
+                return nullptr;
+            handler();
+        }
+
+        if(AllocationTracker::onAllocation(size))
+            reportViolation(size);
+
+        return pointer;
+    }
+
+#if defined(__GLIBC__)
+    /**
+     * Track an allocation of the C allocation functions.
+     * @param pointer the allocated memory (nullptr if the allocation failed);
+     * @param size size of the allocation.
+     * @return the allocated memory.
+     */
+    void* track(void* pointer, const std::size_t& size)
+    {
+        if(pointer != nullptr && AllocationTracker::onAllocation(size))
+            reportViolation(size);
+        return pointer;
+    }
+
+    /**
+     * Check the alignment of the aligned allocation functions.
+     * @param alignment the alignment.
+     * @return true if the alignment is a power of two.
+     */
+    bool isValidAlignment(const std::size_t& alignment)
+    {
+        return alignment != 0 && (alignment & (alignment - 1)) == 0;
+    }
+#endif
+
+    void deallocate(void* pointer, [[maybe_unused]] const std::size_t& alignment) noexcept
+    {
+#if defined(_MSC_VER)
+        if(alignment > alignof(std::max_align_t))
+        {
+            _aligned_free(pointer);
+            return;
+        }
+#endif
+        std::free(pointer);
+    }
+
+    void* allocateOrThrow(const std::size_t& size, const std::size_t& alignment)
+    {
+        void* pointer = allocate(size, alignment);
+        if(pointer == nullptr)
+            throw std::bad_alloc();
+        return pointer;
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return allocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept
+{
+    deallocate(pointer, alignof(std::max_align_t));
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    deallocate(pointer, alignof(std::max_align_t));
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    deallocate(pointer, alignof(std::max_align_t));
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    deallocate(pointer, alignof(std::max_align_t));
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer, alignof(std::max_align_t));
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer, alignof(std::max_align_t));
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+#if defined(__GLIBC__)
+extern "C"
+{
+    void* malloc(std::size_t size)
+    {
+        return track(__libc_malloc(size), size);
+    }
+
+    void* calloc(std::size_t number, std::size_t size)
+    {
+        return track(__libc_calloc(number, size), number * size);
+    }
+
+    void* realloc(void* pointer, std::size_t size)
+    {
+        // realloc(pointer, 0) frees the memory
+        if(size == 0 && pointer != nullptr)
+            return __libc_realloc(pointer, size);
+        return track(__libc_realloc(pointer, size), size);
+    }
+
+    void free(void* pointer)
+    {
+        __libc_free(pointer);
+    }
+
+    void* memalign(std::size_t alignment, std::size_t size)
+    {
+        return track(__libc_memalign(alignment, size), size);
+    }
+
+    void* aligned_alloc(std::size_t alignment, std::size_t size)
+    {
+        if(!isValidAlignment(alignment))
+        {
+            errno = EINVAL;
+            return nullptr;
+        }
+        return track(__libc_memalign(alignment, size), size);
+    }
+
+    int posix_memalign(void** pointer, std::size_t alignment, std::size_t size)
+    {
+        if(!isValidAlignment(alignment) || alignment % sizeof(void*) != 0)
+            return EINVAL;
+
+        void* memory = track(__libc_memalign(alignment, size), size);
+        if(memory == nullptr)
+            return ENOMEM;
+
+        *pointer = memory;
+        return 0;
+    }
+}
+#endif
@@ -4,19 +4,14 @@
 #ifndef WALKING_CONTROLLERS_TRAJECTORY_PLANNER_STABLE_DCM_MODEL_H
 #define WALKING_CONTROLLERS_TRAJECTORY_PLANNER_STABLE_DCM_MODEL_H
 
-// std
-#include <memory>
-
 // YARP
 #include <yarp/os/Searchable.h>
-#include <yarp/sig/Vector.h>
-
-// iCub-ctrl
-#include <iCub/ctrl/pids.h>
 
 //iDynTree
 #include <iDynTree/VectorFixSize.h>
 
+#include <WalkingControllers/EigenUtilities/Integrator.h>
+
 namespace WalkingControllers
 {
     /**
@@ -26,7 +21,7 @@ namespace WalkingControllers
     {
         double m_omega; /**< Inverted time constant of the 3D-LIPM. */
 
-        std::unique_ptr<iCub::ctrl::Integrator> m_comIntegrator{nullptr}; /**< CoM integrator object. */
+        EigenUtilities::Integrator<2> m_comIntegrator; /**< CoM integrator object. */
 
         iDynTree::Vector2 m_dcmPosition; /**< Position of the DCM. */
         iDynTree::Vector2 m_comPosition; /**< Position of the CoM. */
@@ -9,8 +9,10 @@
 #include <thread>
 #include <condition_variable>
 #include <memory>
+#include <vector>
 
 // YARP
+#include <yarp/os/LogStream.h>
 #include <yarp/os/Searchable.h>
 
 // iDynTree
@@ -164,18 +166,21 @@ namespace WalkingControllers
         bool isTrajectoryAsked();
 
         /**
-         * Get the desired 2D-DCM position trajectory
+         * Get the desired 2D-DCM position trajectory. The vector can use any allocator
+         * (e.g. a std::pmr::vector taking the memory from a StdUtilities::TickArena).
          * @param DCMPositionTrajectory desired trajectory of the DCM.
          * @return true/false in case of success/failure.
          */
-        bool getDCMPositionTrajectory(std::vector<iDynTree::Vector2>& DCMPositionTrajectory);
+        template <typename Allocator>
+        bool getDCMPositionTrajectory(std::vector<iDynTree::Vector2, Allocator>& DCMPositionTrajectory);
 
         /**
-         * Get the desired 2D-DCM velocity trajectory
+         * Get the desired 2D-DCM velocity trajectory. The vector can use any allocator.
          * @param DCMVelocityTrajectory desired trajectory of the DCM.
          * @return true/false in case of success/failure.
          */
-        bool getDCMVelocityTrajectory(std::vector<iDynTree::Vector2>& DCMVelocityTrajectory);
+        template <typename Allocator>
+        bool getDCMVelocityTrajectory(std::vector<iDynTree::Vector2, Allocator>& DCMVelocityTrajectory);
 
         /**
          * Get the feet trajectory
@@ -253,11 +258,12 @@ namespace WalkingControllers
         bool getIsStancePhase(std::vector<bool>& isStancePhase);
 
         /**
-         * Get the desired ZMP trajectory
+         * Get the desired ZMP trajectory. The vector can use any allocator.
          * @param desiredZMP vector containing the desired ZMP on the xy plane
          * @return true/false in case of success/failure.
          */
-        bool getDesiredZMPPosition(std::vector<iDynTree::Vector2>& desiredZMP);
+        template <typename Allocator>
+        bool getDesiredZMPPosition(std::vector<iDynTree::Vector2, Allocator>& desiredZMP);
 
         /**
          * Reset the planner
@@ -279,4 +285,6 @@ namespace WalkingControllers
     };
 };
 
+#include "TrajectoryGenerator.tpp"
+
 #endif
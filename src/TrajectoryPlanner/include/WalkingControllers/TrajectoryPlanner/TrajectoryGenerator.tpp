@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+template <typename Allocator>
+bool WalkingControllers::TrajectoryGenerator::getDCMPositionTrajectory(std::vector<iDynTree::Vector2, Allocator>& DCMPositionTrajectory)
+{
+    if(!isTrajectoryComputed())
+    {
+        yError() << "[getDCMPositionTrajectory] No trajectories are available";
+        return false;
+    }
+
+    const auto& trajectory = m_dcmGenerator->getDCMPosition();
+    DCMPositionTrajectory.assign(trajectory.begin(), trajectory.end());
+    return true;
+}
+
+template <typename Allocator>
+bool WalkingControllers::TrajectoryGenerator::getDCMVelocityTrajectory(std::vector<iDynTree::Vector2, Allocator>& DCMVelocityTrajectory)
+{
+    if(!isTrajectoryComputed())
+    {
+        yError() << "[getDCMVelocityTrajectory] No trajectories are available";
+        return false;
+    }
+
+    const auto& trajectory = m_dcmGenerator->getDCMVelocity();
+    DCMVelocityTrajectory.assign(trajectory.begin(), trajectory.end());
+    return true;
+}
+
+template <typename Allocator>
+bool WalkingControllers::TrajectoryGenerator::getDesiredZMPPosition(std::vector<iDynTree::Vector2, Allocator>& desiredZMP)
+{
+    if(!isTrajectoryComputed())
+    {
+        yError() << "[getDesiredZMP] No trajectories are available";
+        return false;
+    }
+
+    const auto& trajectory = m_dcmGenerator->getZMPPosition();
+    desiredZMP.assign(trajectory.begin(), trajectory.end());
+    return true;
+}
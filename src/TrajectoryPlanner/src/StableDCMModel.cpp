@@ -4,13 +4,10 @@
 #include <math.h>
 
 // YARP
-#include <yarp/sig/Vector.h>
 #include <yarp/os/LogStream.h>
 
 //iDynTree
 #include <iDynTree/EigenHelpers.h>
-#include <iDynTree/YARPConversions.h>
-#include <iDynTree/YARPEigenConversions.h>
 
 #include <WalkingControllers/TrajectoryPlanner/StableDCMModel.h>
 #include <WalkingControllers/YarpUtilities/Helper.h>
@@ -43,11 +40,12 @@ bool StableDCMModel::initialize(const yarp::os::Searchable& config)
         return false;
     }
 
-    yarp::sig::Vector buffer;
-    buffer.resize(2, 0.0);
-
-    // instantiate Integrator object
-    m_comIntegrator = std::make_unique<iCub::ctrl::Integrator>(samplingTime, buffer);
+    // initialize the integrator
+    if(!m_comIntegrator.initialize(samplingTime))
+    {
+        yError() << "[initialize] Unable to initialize the CoM integrator.";
+        return false;
+    }
 
     return true;
 }
@@ -59,7 +57,7 @@ void StableDCMModel::setInput(const iDynTree::Vector2& input)
 
 bool StableDCMModel::integrateModel()
 {
-    if(m_comIntegrator == nullptr)
+    if(!m_comIntegrator.isInitialized())
     {
         yError() << "[integrateModel] The dcm integrator object is not ready. "
                  << "Please call initialize method.";
@@ -67,17 +65,11 @@ bool StableDCMModel::integrateModel()
     }
 
     // evaluate the velocity of the CoM
-    yarp::sig::Vector comVelocityYarp(2);
-    iDynTree::toEigen(comVelocityYarp) = -m_omega * (iDynTree::toEigen(m_comPosition) -
-                                                     iDynTree::toEigen(m_dcmPosition));
+    iDynTree::toEigen(m_comVelocity) = -m_omega * (iDynTree::toEigen(m_comPosition) -
+                                                   iDynTree::toEigen(m_dcmPosition));
 
     // integrate velocities
-    yarp::sig::Vector comPositionYarp(2);
-    comPositionYarp = m_comIntegrator->integrate(comVelocityYarp);
-
-    // convert YARP vector into iDynTree vector
-    iDynTree::toiDynTree(comVelocityYarp, m_comVelocity);
-    iDynTree::toiDynTree(comPositionYarp, m_comPosition);
+    iDynTree::toEigen(m_comPosition) = m_comIntegrator.integrate(iDynTree::toEigen(m_comVelocity));
 
     return true;
 }
@@ -94,17 +86,14 @@ const iDynTree::Vector2& StableDCMModel::getCoMVelocity() const
 
 bool StableDCMModel::reset(const iDynTree::Vector2& initialValue)
 {
-    if(m_comIntegrator == nullptr)
+    if(!m_comIntegrator.isInitialized())
     {
         yError() << "[reset] The dcm integrator object is not ready. "
                  << "Please call initialize method.";
         return false;
     }
 
-    yarp::sig::Vector buffer;
-    iDynTree::toYarp(initialValue, buffer);
-
-    m_comIntegrator->reset(buffer);
+    m_comIntegrator.reset(iDynTree::toEigen(initialValue));
     m_comPosition = initialValue;
     return true;
 }
@@ -672,30 +672,6 @@ bool TrajectoryGenerator::isTrajectoryAsked()
     return m_generatorState == GeneratorState::Called;
 }
 
-bool TrajectoryGenerator::getDCMPositionTrajectory(std::vector<iDynTree::Vector2>& DCMPositionTrajectory)
-{
-    if(!isTrajectoryComputed())
-    {
-        yError() << "[getDCMPositionTrajectory] No trajectories are available";
-        return false;
-    }
-
-    DCMPositionTrajectory = m_dcmGenerator->getDCMPosition();
-    return true;
-}
-
-bool TrajectoryGenerator::getDCMVelocityTrajectory(std::vector<iDynTree::Vector2>& DCMVelocityTrajectory)
-{
-    if(!isTrajectoryComputed())
-    {
-        yError() << "[getDCMVelocityTrajectory] No trajectories are available";
-        return false;
-    }
-
-    DCMVelocityTrajectory = m_dcmGenerator->getDCMVelocity();
-    return true;
-}
-
 bool TrajectoryGenerator::getFeetTrajectories(std::vector<iDynTree::Transform>& lFootTrajectory,
                                               std::vector<iDynTree::Transform>& rFootTrajectory)
 {
@@ -852,18 +828,6 @@ bool TrajectoryGenerator::getIsStancePhase(std::vector<bool>& isStancePhase)
     return true;
 }
 
-bool TrajectoryGenerator::getDesiredZMPPosition(std::vector<iDynTree::Vector2> &desiredZMP)
-{
-    if(!isTrajectoryComputed())
-    {
-        yError() << "[getDesiredZMP] No trajectories are available";
-        return false;
-    }
-
-    desiredZMP = m_dcmGenerator->getZMPPosition();
-    return true;
-}
-
 const iDynTree::Rotation& TrajectoryGenerator::getChestAdditionalRotation() const
 {
     return m_chestAdditionalRotation;
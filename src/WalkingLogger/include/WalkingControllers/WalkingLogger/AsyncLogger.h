@@ -0,0 +1,270 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_WALKING_LOGGER_ASYNC_LOGGER_H
+#define WALKING_CONTROLLERS_WALKING_LOGGER_ASYNC_LOGGER_H
+
+// std
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <thread>
+#include <vector>
+
+// iDynTree
+#include <iDynTree/Rotation.h>
+
+// BipedalLocomotion
+#include <BipedalLocomotion/ParametersHandler/IParametersHandler.h>
+#include <BipedalLocomotion/YarpUtilities/VectorsCollectionServer.h>
+
+#include <WalkingControllers/StdUtilities/SPSCRingBuffer.h>
+#include <WalkingControllers/WalkingLogger/FlightRecorder.h>
+#include <WalkingControllers/WalkingLogger/LoggedChannel.h>
+
+namespace WalkingControllers
+{
+
+/**
+ * AsyncLogger decouples the control loop from the VectorsCollectionServer.
+ * The channels are declared once (addChannel()), then at each tick the control loop copies the
+ * raw data of all the channels (in the same order they were declared) into a preallocated
+ * record of a lock-free single producer single consumer ring buffer:
+ * \code{.cpp}
+ * if(logger.beginRecord())
+ * {
+ *     logger.push(dcm);
+ *     logger.push(footTransform.getRotation());
+ *     logger.endRecord();
+ * }
+ * \endcode
+ * A background thread converts the records (e.g. the rotation matrices in roll pitch yaw),
+ * maps them on the metadata and sends them on the YARP port.
+ * If the ring buffer is full the record is dropped, the number of dropped records is counted
+ * and it is published in the logger::dropped_records channel.
+ * If the flight recorder is enabled, the background thread also appends the raw records to a
+ * memory mapped file (see FlightRecorder) that can be read after the experiment (or a crash).
+ * The channels sent on the port can be decimated or disabled at runtime. In trigger mode
+ * nothing is sent on the port until trigger() is called: the last seconds are kept at full
+ * rate by the background thread and they are sent, followed by the records received after the
+ * event, only when the logger is triggered (e.g. in case of error).
+ */
+    class AsyncLogger
+    {
+    public:
+
+        using ChannelType = LoggedChannelType;
+
+    private:
+
+        struct Channel : public LoggedChannel
+        {
+            std::vector<double> buffer; /**< Data published by the background thread. */
+            size_t decimation{1}; /**< The channel is sent once every decimation records. */
+            bool isEnabled{true}; /**< True if the channel is sent. */
+            bool isSelected{false}; /**< True if the channel is sent with the current record. */
+        };
+
+        std::vector<Channel> m_channels; /**< Channels of the logger. */
+        size_t m_recordSize{1}; /**< Number of elements of a record (the first one is the timestamp). */
+        size_t m_ringBufferSize{0}; /**< Number of records stored in the ring buffer. */
+        std::chrono::microseconds m_pollingPeriod; /**< Period used by the background thread to check the ring buffer. */
+
+        StdUtilities::SPSCRingBuffer<double> m_ringBuffer; /**< Ring buffer between the control loop and the background thread. */
+        BipedalLocomotion::YarpUtilities::VectorsCollectionServer m_server; /**< Logger server (used only by the background thread). */
+
+        std::string m_flightRecorderFileName; /**< Name of the flight recorder file (empty if the recorder is disabled). */
+        size_t m_flightRecorderChunkSize{0}; /**< Number of records allocated each time the flight recorder file grows. */
+        std::unique_ptr<FlightRecorder> m_flightRecorder; /**< Flight recorder (used only by the background thread). */
+        bool m_flightRecorderFailed{false}; /**< True if the flight recorder was not able to write a record. */
+
+        std::mutex m_settingsMutex; /**< Mutex protecting the decimation and the enable flag of the channels. */
+        size_t m_defaultDecimation{1}; /**< Decimation of the channels read from the configuration. */
+        std::vector<std::pair<std::string, int>> m_initialDecimations; /**< Decimations read from the configuration. */
+        std::vector<std::string> m_initialDisabledChannels; /**< Disabled channels read from the configuration. */
+        size_t m_processedRecords{0}; /**< Number of records processed by the background thread. */
+
+        bool m_isTriggerModeEnabled{false}; /**< True if the records are sent only when the logger is triggered. */
+        std::vector<double> m_history; /**< Last records (circular buffer used in trigger mode). */
+        size_t m_historyCapacity{0}; /**< Maximum number of records stored in the history. */
+        size_t m_historyBegin{0}; /**< Position of the oldest record in the history. */
+        size_t m_historySize{0}; /**< Number of records stored in the history. */
+        size_t m_postTriggerSize{0}; /**< Number of records sent after the trigger. */
+        size_t m_postTriggerRecords{0}; /**< Number of records that still have to be sent after the last trigger. */
+        std::atomic<bool> m_isTriggerRequested{false}; /**< True if the logger has been triggered. */
+
+        double* m_record{nullptr}; /**< Record currently written by the control loop. */
+        size_t m_currentChannel{0}; /**< Channel that will be written by the next push(). */
+        bool m_isRecordValid{false}; /**< False if the data pushed in the record does not match the channels. */
+
+        std::atomic<size_t> m_droppedRecords{0}; /**< Number of records dropped because the ring buffer was full. */
+        std::atomic<size_t> m_invalidRecords{0}; /**< Number of records dropped because they did not match the channels. */
+        std::atomic<size_t> m_publishedRecords{0}; /**< Number of records sent by the background thread. */
+
+        bool m_isRunning{false}; /**< True if the background thread is running. */
+        std::atomic<bool> m_isClosing{false}; /**< True if the background thread has to be closed. */
+        std::thread m_publisherThread; /**< Background thread. */
+
+        /**
+         * Main method of the background thread.
+         */
+        void publisherThread();
+
+        /**
+         * Process a record in the background thread.
+         * @param record pointer to the record.
+         */
+        void processRecord(const double* record);
+
+        /**
+         * Send the history (trigger mode).
+         */
+        void flushHistory();
+
+        /**
+         * Send a record through the VectorsCollectionServer.
+         * @param record pointer to the record;
+         * @param useDecimation if false all the enabled channels are sent.
+         */
+        void publish(const double* record, const bool& useDecimation);
+
+    public:
+
+        /**
+         * Destructor.
+         */
+        ~AsyncLogger();
+
+        /**
+         * Initialize the logger.
+         * @param handler pointer to the parameter handler. It must contain the same parameters of
+         * the VectorsCollectionServer and optionally the ring_buffer_size (number of records),
+         * the polling_period of the background thread (in seconds), the flight_recorder_prefix
+         * (if set the records are also stored in the file prefix_YYYY_MM_DD_HH_MM_SS.wcfr) and the
+         * flight_recorder_chunk_size (number of records). The channels sent on the port can be
+         * configured with decimation (default decimation of all the channels), disabled_channels,
+         * decimated_channels and decimation_factors (lists of the same size). The names of the
+         * channels can be replaced by their prefix (e.g. joints_state). If trigger_mode is true,
+         * the sampling_time, trigger_history_duration and trigger_post_duration (in seconds)
+         * are also used;
+         * @return true/false in case of success/failure
+         */
+        bool initialize(std::weak_ptr<const BipedalLocomotion::ParametersHandler::IParametersHandler> handler);
+
+        /**
+         * Add a channel. It has to be called after initialize() and before start().
+         * @param name name of the channel;
+         * @param metadata metadata of the channel (one for each published element);
+         * @param type type of the channel.
+         * @return true/false in case of success/failure
+         */
+        bool addChannel(const std::string& name, const std::vector<std::string>& metadata,
+                        const ChannelType& type = ChannelType::Vector);
+
+        /**
+         * Allocate the ring buffer and start the background thread.
+         * @return true/false in case of success/failure
+         */
+        bool start();
+
+        /**
+         * Stop the background thread. The records already stored in the ring buffer are sent.
+         */
+        void close();
+
+        /**
+         * Set the decimation of a group of channels. It is thread safe.
+         * @param channel name of the channel or prefix of a group of channels (e.g. joints_state);
+         * @param decimation the channels are sent once every decimation records.
+         * @return true/false in case of success/failure
+         */
+        bool setChannelDecimation(const std::string& channel, const int& decimation);
+
+        /**
+         * Enable or disable a group of channels. It is thread safe.
+         * @param channel name of the channel or prefix of a group of channels (e.g. joints_state);
+         * @param enable true if the channels have to be sent.
+         * @return true/false in case of success/failure
+         */
+        bool enableChannel(const std::string& channel, const bool& enable);
+
+        /**
+         * Send the history of the records (only in trigger mode). It is thread safe.
+         * @return true/false in case of success/failure
+         */
+        bool trigger();
+
+        /**
+         * Check if the trigger mode is enabled.
+         * @return true if the records are sent only when the logger is triggered.
+         */
+        bool isTriggerModeEnabled() const;
+
+        /**
+         * Start a new record and set its timestamp. It does not allocate memory.
+         * @return false if the ring buffer is full. In this case the record is dropped and the
+         * following push() are ignored.
+         */
+        bool beginRecord();
+
+        /**
+         * Copy the data of the current channel in the record.
+         * @param data pointer to the data;
+         * @param size number of elements.
+         */
+        void push(const double* data, const size_t& size);
+
+        /**
+         * Copy the data of the current channel in the record.
+         * @param vector a vector exposing data() and size().
+         */
+        template <class Vector>
+        void push(const Vector& vector)
+        {
+            push(vector.data(), vector.size());
+        }
+
+        /**
+         * Copy a rotation matrix in the record. The channel has to be of type Rotation.
+         * @param rotation the rotation matrix.
+         */
+        void push(const iDynTree::Rotation& rotation);
+
+        /**
+         * Copy a scalar in the record.
+         * @param value the scalar.
+         */
+        void push(const double& value);
+
+        /**
+         * Make the record available to the background thread.
+         * @return false if the data pushed in the record does not match the channels.
+         */
+        bool endRecord();
+
+        /**
+         * Get the number of records dropped because the ring buffer was full.
+         */
+        size_t getDroppedRecords() const;
+
+        /**
+         * Get the number of records dropped because they did not match the channels.
+         */
+        size_t getInvalidRecords() const;
+
+        /**
+         * Get the number of records sent by the background thread.
+         */
+        size_t getPublishedRecords() const;
+
+        /**
+         * Get the name of the flight recorder file.
+         * @return the name of the file or an empty string if the flight recorder is disabled.
+         */
+        const std::string& getFlightRecorderFileName() const;
+    };
+};
+#endif
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_WALKING_LOGGER_FLIGHT_RECORDER_H
+#define WALKING_CONTROLLERS_WALKING_LOGGER_FLIGHT_RECORDER_H
+
+// std
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <WalkingControllers/WalkingLogger/LoggedChannel.h>
+
+namespace WalkingControllers
+{
+
+/**
+ * Header of the flight recorder file. The file contains:
+ * - the header;
+ * - the schema, i.e. one line for each channel: name, type (vector or rotation), offset, size
+ *   and metadata (separated by commas). The fields are separated by tabs;
+ * - the records, stored in chunks of recordsPerChunk records. The first chunk starts at
+ *   dataOffset and each chunk is chunkSize bytes long.
+ * The number of records is updated after each record, hence the file can be read also if
+ * the process that was writing it crashed.
+ */
+    struct FlightRecorderHeader
+    {
+        char magic[8]; /**< File signature (WCFLTREC). */
+        std::uint32_t version; /**< Version of the file format. */
+        std::uint32_t reserved; /**< Unused. */
+        std::uint64_t schemaSize; /**< Size of the schema in bytes. */
+        std::uint64_t dataOffset; /**< Position of the first chunk in bytes. */
+        std::uint64_t recordSize; /**< Number of doubles of each record (timestamp included). */
+        std::uint64_t recordsPerChunk; /**< Number of records of each chunk. */
+        std::uint64_t chunkSize; /**< Size of a chunk in bytes. */
+        std::uint64_t numberOfRecords; /**< Number of records written in the file. */
+    };
+
+/**
+ * FlightRecorder writes the records of the logger in a preallocated, memory mapped and append
+ * only binary file. The file grows by chunks, the records are written directly in the mapped
+ * memory.
+ */
+    class FlightRecorder
+    {
+        int m_file{-1}; /**< File descriptor. */
+        FlightRecorderHeader* m_header{nullptr}; /**< Mapped header. */
+        size_t m_headerMappingSize{0}; /**< Size of the memory mapping of the header and the schema. */
+
+        double* m_chunk{nullptr}; /**< Chunk currently written. */
+        size_t m_numberOfChunks{0}; /**< Number of chunks allocated in the file. */
+        size_t m_recordsInChunk{0}; /**< Number of records written in the current chunk. */
+
+        /**
+         * Allocate and map a new chunk.
+         * @return true/false in case of success/failure
+         */
+        bool addChunk();
+
+    public:
+
+        /**
+         * Destructor.
+         */
+        ~FlightRecorder();
+
+        /**
+         * Create the file and write the schema.
+         * @param fileName name of the file;
+         * @param channels channels of the records;
+         * @param recordSize number of doubles of each record (timestamp included);
+         * @param recordsPerChunk number of records allocated each time the file grows.
+         * @return true/false in case of success/failure
+         */
+        bool open(const std::string& fileName, const std::vector<LoggedChannel>& channels,
+                  const size_t& recordSize, const size_t& recordsPerChunk);
+
+        /**
+         * Get the memory where the next record will be written. The file grows if the current
+         * chunk is full.
+         * @return a pointer to the record or nullptr in case of failure.
+         */
+        double* acquire();
+
+        /**
+         * Increase the number of records of the file.
+         */
+        void commit();
+
+        /**
+         * Append a record to the file.
+         * @param record pointer to the record.
+         * @return true/false in case of success/failure
+         */
+        bool write(const double* record);
+
+        /**
+         * Unmap and close the file.
+         */
+        void close();
+
+        /**
+         * Get the number of records written in the file.
+         */
+        size_t getNumberOfRecords() const;
+    };
+
+/**
+ * FlightRecorderReader reads a file written by the FlightRecorder.
+ */
+    class FlightRecorderReader
+    {
+        int m_file{-1}; /**< File descriptor. */
+        const char* m_data{nullptr}; /**< Mapped file. */
+        size_t m_fileSize{0}; /**< Size of the file in bytes. */
+        FlightRecorderHeader m_header{}; /**< Header of the file. */
+        std::vector<LoggedChannel> m_channels; /**< Channels of the records. */
+
+    public:
+
+        /**
+         * Destructor.
+         */
+        ~FlightRecorderReader();
+
+        /**
+         * Open a file.
+         * @param fileName name of the file.
+         * @return true/false in case of success/failure
+         */
+        bool open(const std::string& fileName);
+
+        /**
+         * Unmap and close the file.
+         */
+        void close();
+
+        /**
+         * Get the channels of the records.
+         */
+        const std::vector<LoggedChannel>& getChannels() const;
+
+        /**
+         * Get the number of records.
+         */
+        size_t getNumberOfRecords() const;
+
+        /**
+         * Get the number of doubles of each record (timestamp included).
+         */
+        size_t getRecordSize() const;
+
+        /**
+         * Get a record.
+         * @param index index of the record.
+         * @return a pointer to the record (the first element is the timestamp) or nullptr if
+         * the index is not valid.
+         */
+        const double* getRecord(const size_t& index) const;
+    };
+};
+#endif
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_WALKING_LOGGER_LOGGED_CHANNEL_H
+#define WALKING_CONTROLLERS_WALKING_LOGGER_LOGGED_CHANNEL_H
+
+// std
+#include <string>
+#include <vector>
+
+namespace WalkingControllers
+{
+
+/**
+ * Type of the data stored in a logged channel.
+ */
+    enum class LoggedChannelType
+    {
+        Vector, /**< The data is published as it is. */
+        Rotation /**< A rotation matrix (row major) published as roll pitch yaw. */
+    };
+
+/**
+ * Description of a channel of the records written by the control loop.
+ * The first element of each record is the timestamp, the channels follow in the order they
+ * were declared.
+ */
+    struct LoggedChannel
+    {
+        std::string name; /**< Name of the channel. */
+        std::vector<std::string> metadata; /**< Metadata of the channel (one for each published element). */
+        LoggedChannelType type{LoggedChannelType::Vector}; /**< Type of the channel. */
+        size_t offset{0}; /**< Position of the channel in the record. */
+        size_t size{0}; /**< Number of elements of the channel in the record. */
+    };
+};
+#endif
@@ -0,0 +1,554 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+
+// YARP
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
+
+// iDynTree
+#include <iDynTree/VectorFixSize.h>
+
+#include <WalkingControllers/WalkingLogger/AsyncLogger.h>
+
+using namespace WalkingControllers;
+
+namespace
+{
+    /**
+     * Check if a channel belongs to a group.
+     * @param channel name of the channel;
+     * @param group name of the channel or prefix of a group of channels.
+     * @return true if the channel belongs to the group.
+     */
+    bool isInGroup(const std::string& channel, const std::string& group)
+    {
+        return channel.compare(0, group.size(), group) == 0
+            && (channel.size() == group.size() || channel.compare(group.size(), 2, "::") == 0);
+    }
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    close();
+}
+
+bool AsyncLogger::initialize(std::weak_ptr<const BipedalLocomotion::ParametersHandler::IParametersHandler> handler)
+{
+    auto ptr = handler.lock();
+    if(ptr == nullptr)
+    {
+        yError() << "[AsyncLogger::initialize] Invalid parameter handler.";
+        return false;
+    }
+
+    int ringBufferSize = 1000;
+    ptr->getParameter("ring_buffer_size", ringBufferSize);
+    if(ringBufferSize <= 0)
+    {
+        yError() << "[AsyncLogger::initialize] The ring_buffer_size has to be a positive number.";
+        return false;
+    }
+    m_ringBufferSize = static_cast<size_t>(ringBufferSize);
+
+    double pollingPeriod = 0.005;
+    ptr->getParameter("polling_period", pollingPeriod);
+    if(pollingPeriod <= 0)
+    {
+        yError() << "[AsyncLogger::initialize] The polling_period has to be a positive number.";
+        return false;
+    }
+    m_pollingPeriod = std::chrono::microseconds(static_cast<long>(std::round(pollingPeriod * 1e6)));
+
+    std::string flightRecorderPrefix;
+    if(ptr->getParameter("flight_recorder_prefix", flightRecorderPrefix) && !flightRecorderPrefix.empty())
+    {
+        int chunkSize = 10000;
+        ptr->getParameter("flight_recorder_chunk_size", chunkSize);
+        if(chunkSize <= 0)
+        {
+            yError() << "[AsyncLogger::initialize] The flight_recorder_chunk_size has to be a positive number.";
+            return false;
+        }
+        m_flightRecorderChunkSize = static_cast<size_t>(chunkSize);
+
+        char timeString[32];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(timeString, sizeof(timeString), "%Y_%m_%d_%H_%M_%S", std::localtime(&now));
+        m_flightRecorderFileName = flightRecorderPrefix + "_" + timeString + ".wcfr";
+    }
+
+    int decimation = 1;
+    ptr->getParameter("decimation", decimation);
+    if(decimation < 1)
+    {
+        yError() << "[AsyncLogger::initialize] The decimation has to be a positive number.";
+        return false;
+    }
+    m_defaultDecimation = static_cast<size_t>(decimation);
+
+    std::vector<std::string> decimatedChannels;
+    if(ptr->getParameter("decimated_channels", decimatedChannels))
+    {
+        std::vector<int> decimationFactors;
+        if(!ptr->getParameter("decimation_factors", decimationFactors)
+           || decimationFactors.size() != decimatedChannels.size())
+        {
+            yError() << "[AsyncLogger::initialize] The decimation_factors list has to contain one factor "
+                     << "for each element of decimated_channels.";
+            return false;
+        }
+
+        for(size_t i = 0; i < decimatedChannels.size(); i++)
+            m_initialDecimations.emplace_back(decimatedChannels[i], decimationFactors[i]);
+    }
+
+    ptr->getParameter("disabled_channels", m_initialDisabledChannels);
+
+    m_isTriggerModeEnabled = false;
+    ptr->getParameter("trigger_mode", m_isTriggerModeEnabled);
+    if(m_isTriggerModeEnabled)
+    {
+        double samplingTime;
+        if(!ptr->getParameter("sampling_time", samplingTime) || samplingTime <= 0)
+        {
+            yError() << "[AsyncLogger::initialize] The sampling_time is required in trigger mode.";
+            return false;
+        }
+
+        double historyDuration = 5.0;
+        double postDuration = 1.0;
+        ptr->getParameter("trigger_history_duration", historyDuration);
+        ptr->getParameter("trigger_post_duration", postDuration);
+        if(historyDuration <= 0 || postDuration < 0)
+        {
+            yError() << "[AsyncLogger::initialize] The trigger_history_duration has to be positive and "
+                     << "the trigger_post_duration cannot be negative.";
+            return false;
+        }
+
+        m_historyCapacity = std::max(static_cast<size_t>(std::round(historyDuration / samplingTime)), size_t(1));
+        m_postTriggerSize = static_cast<size_t>(std::round(postDuration / samplingTime));
+    }
+
+    if(!m_server.initialize(ptr))
+    {
+        yError() << "[AsyncLogger::initialize] Unable to initialize the vectors collection server.";
+        return false;
+    }
+
+    return true;
+}
+
+bool AsyncLogger::addChannel(const std::string& name, const std::vector<std::string>& metadata,
+                             const ChannelType& type)
+{
+    if(m_isRunning)
+    {
+        yError() << "[AsyncLogger::addChannel] The channels cannot be added after start().";
+        return false;
+    }
+
+    if(type == ChannelType::Rotation && metadata.size() != 3)
+    {
+        yError() << "[AsyncLogger::addChannel] The rotation channel" << name
+                 << "has to contain three metadata (roll, pitch and yaw).";
+        return false;
+    }
+
+    Channel channel;
+    channel.name = name;
+    channel.metadata = metadata;
+    channel.type = type;
+    channel.offset = m_recordSize;
+    channel.size = type == ChannelType::Rotation ? 9 : metadata.size();
+    channel.buffer.resize(metadata.size());
+    channel.decimation = m_defaultDecimation;
+
+    m_recordSize += channel.size;
+    m_channels.push_back(std::move(channel));
+
+    return true;
+}
+
+bool AsyncLogger::start()
+{
+    if(m_isRunning)
+    {
+        yError() << "[AsyncLogger::start] The logger is already running.";
+        return false;
+    }
+
+    if(m_channels.empty())
+    {
+        yError() << "[AsyncLogger::start] No channel has been added.";
+        return false;
+    }
+
+    if(!m_ringBuffer.initialize(m_ringBufferSize, m_recordSize))
+    {
+        yError() << "[AsyncLogger::start] Unable to initialize the ring buffer.";
+        return false;
+    }
+
+    for(const auto& channel : m_channels)
+    {
+        if(!m_server.populateMetadata(channel.name, channel.metadata))
+        {
+            yError() << "[AsyncLogger::start] Unable to populate the metadata of the channel" << channel.name;
+            return false;
+        }
+    }
+    m_server.populateMetadata("logger::dropped_records", {"scalar"});
+    m_server.finalizeMetadata();
+
+    for(const auto& [channel, decimation] : m_initialDecimations)
+    {
+        if(!setChannelDecimation(channel, decimation))
+        {
+            yError() << "[AsyncLogger::start] Unable to set the decimation of" << channel;
+            return false;
+        }
+    }
+
+    for(const auto& channel : m_initialDisabledChannels)
+    {
+        if(!enableChannel(channel, false))
+        {
+            yError() << "[AsyncLogger::start] Unable to disable" << channel;
+            return false;
+        }
+    }
+
+    if(m_isTriggerModeEnabled)
+    {
+        m_history.resize(m_historyCapacity * m_recordSize);
+        m_historyBegin = 0;
+        m_historySize = 0;
+        m_postTriggerRecords = 0;
+    }
+
+    if(!m_flightRecorderFileName.empty())
+    {
+        const std::vector<LoggedChannel> channels(m_channels.begin(), m_channels.end());
+        m_flightRecorder = std::make_unique<FlightRecorder>();
+        if(!m_flightRecorder->open(m_flightRecorderFileName, channels, m_recordSize, m_flightRecorderChunkSize))
+        {
+            yError() << "[AsyncLogger::start] Unable to open the flight recorder.";
+            return false;
+        }
+        yInfo() << "[AsyncLogger::start] The logged data are recorded in" << m_flightRecorderFileName;
+    }
+
+    m_isClosing = false;
+    m_isRunning = true;
+    m_publisherThread = std::thread(&AsyncLogger::publisherThread, this);
+
+    return true;
+}
+
+void AsyncLogger::close()
+{
+    if(!m_isRunning)
+        return;
+
+    m_isClosing = true;
+    if(m_publisherThread.joinable())
+        m_publisherThread.join();
+
+    m_isRunning = false;
+
+    if(m_flightRecorder != nullptr)
+    {
+        yInfo() << "[AsyncLogger::close]" << m_flightRecorder->getNumberOfRecords() << "records stored in"
+                << m_flightRecorderFileName;
+        m_flightRecorder->close();
+    }
+
+    if(m_droppedRecords > 0 || m_invalidRecords > 0)
+        yWarning() << "[AsyncLogger::close]" << m_droppedRecords.load() << "records dropped because the ring buffer was full and"
+                   << m_invalidRecords.load() << "records dropped because they did not match the channels.";
+}
+
+void AsyncLogger::publisherThread()
+{
+    while(true)
+    {
+        const double* record = m_ringBuffer.front();
+        if(record == nullptr)
+        {
+            // the remaining records are sent before closing the thread
+            if(m_isClosing)
+            {
+                if(m_isTriggerModeEnabled && m_isTriggerRequested.exchange(false))
+                    flushHistory();
+                return;
+            }
+
+            std::this_thread::sleep_for(m_pollingPeriod);
+            continue;
+        }
+
+        if(m_flightRecorder != nullptr && !m_flightRecorderFailed && !m_flightRecorder->write(record))
+        {
+            yError() << "[AsyncLogger::publisherThread] Unable to write in the flight recorder. The recorder is disabled.";
+            m_flightRecorderFailed = true;
+        }
+
+        processRecord(record);
+        m_ringBuffer.pop();
+        m_publishedRecords++;
+    }
+}
+
+void AsyncLogger::processRecord(const double* record)
+{
+    if(!m_isTriggerModeEnabled)
+    {
+        publish(record, true);
+        return;
+    }
+
+    if(m_isTriggerRequested.exchange(false))
+    {
+        flushHistory();
+        m_postTriggerRecords = m_postTriggerSize;
+    }
+
+    // the records following the event are sent at full rate
+    if(m_postTriggerRecords > 0)
+    {
+        publish(record, false);
+        m_postTriggerRecords--;
+        return;
+    }
+
+    // store the record in the history, the oldest record is overwritten if the history is full
+    size_t index;
+    if(m_historySize == m_historyCapacity)
+    {
+        index = m_historyBegin;
+        m_historyBegin = (m_historyBegin + 1) % m_historyCapacity;
+    }
+    else
+    {
+        index = (m_historyBegin + m_historySize) % m_historyCapacity;
+        m_historySize++;
+    }
+    std::memcpy(m_history.data() + index * m_recordSize, record, m_recordSize * sizeof(double));
+}
+
+void AsyncLogger::flushHistory()
+{
+    for(size_t i = 0; i < m_historySize; i++)
+    {
+        const size_t index = (m_historyBegin + i) % m_historyCapacity;
+        publish(m_history.data() + index * m_recordSize, false);
+    }
+
+    m_historyBegin = 0;
+    m_historySize = 0;
+}
+
+void AsyncLogger::publish(const double* record, const bool& useDecimation)
+{
+    bool isAnyChannelSelected = false;
+    {
+        std::lock_guard<std::mutex> guard(m_settingsMutex);
+        for(auto& channel : m_channels)
+        {
+            channel.isSelected = channel.isEnabled
+                && (!useDecimation || m_processedRecords % channel.decimation == 0);
+            isAnyChannelSelected = isAnyChannelSelected || channel.isSelected;
+        }
+    }
+
+    if(useDecimation)
+        m_processedRecords++;
+
+    if(!isAnyChannelSelected)
+        return;
+
+    m_server.prepareData();
+    m_server.clearData();
+
+    for(auto& channel : m_channels)
+    {
+        if(!channel.isSelected)
+            continue;
+
+        const double* data = record + channel.offset;
+        if(channel.type == ChannelType::Rotation)
+        {
+            iDynTree::Rotation rotation;
+            std::memcpy(rotation.data(), data, 9 * sizeof(double));
+            const iDynTree::Vector3 rpy = rotation.asRPY();
+            std::memcpy(channel.buffer.data(), rpy.data(), 3 * sizeof(double));
+        }
+        else
+            std::memcpy(channel.buffer.data(), data, channel.size * sizeof(double));
+
+        m_server.populateData(channel.name, channel.buffer);
+    }
+
+    m_server.populateData("logger::dropped_records",
+                          std::array<double, 1>{static_cast<double>(m_droppedRecords.load())});
+
+    m_server.sendData();
+}
+
+bool AsyncLogger::setChannelDecimation(const std::string& channel, const int& decimation)
+{
+    if(decimation < 1)
+    {
+        yError() << "[AsyncLogger::setChannelDecimation] The decimation has to be a positive number.";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(m_settingsMutex);
+    bool found = false;
+    for(auto& loggedChannel : m_channels)
+    {
+        if(isInGroup(loggedChannel.name, channel))
+        {
+            loggedChannel.decimation = static_cast<size_t>(decimation);
+            found = true;
+        }
+    }
+
+    if(!found)
+        yError() << "[AsyncLogger::setChannelDecimation] Unable to find the channel" << channel;
+
+    return found;
+}
+
+bool AsyncLogger::enableChannel(const std::string& channel, const bool& enable)
+{
+    std::lock_guard<std::mutex> guard(m_settingsMutex);
+    bool found = false;
+    for(auto& loggedChannel : m_channels)
+    {
+        if(isInGroup(loggedChannel.name, channel))
+        {
+            loggedChannel.isEnabled = enable;
+            found = true;
+        }
+    }
+
+    if(!found)
+        yError() << "[AsyncLogger::enableChannel] Unable to find the channel" << channel;
+
+    return found;
+}
+
+bool AsyncLogger::trigger()
+{
+    if(!m_isTriggerModeEnabled)
+    {
+        yError() << "[AsyncLogger::trigger] The trigger mode is not enabled.";
+        return false;
+    }
+
+    m_isTriggerRequested = true;
+    return true;
+}
+
+bool AsyncLogger::isTriggerModeEnabled() const
+{
+    return m_isTriggerModeEnabled;
+}
+
+bool AsyncLogger::beginRecord()
+{
+    m_currentChannel = 0;
+    m_record = m_isRunning ? m_ringBuffer.acquire() : nullptr;
+    m_isRecordValid = m_record != nullptr;
+
+    if(m_record == nullptr)
+    {
+        if(m_isRunning)
+            m_droppedRecords++;
+        return false;
+    }
+
+    m_record[0] = yarp::os::Time::now();
+    return true;
+}
+
+void AsyncLogger::push(const double* data, const size_t& size)
+{
+    if(!m_isRecordValid)
+        return;
+
+    if(m_currentChannel >= m_channels.size() || m_channels[m_currentChannel].size != size)
+    {
+        m_isRecordValid = false;
+        return;
+    }
+
+    std::memcpy(m_record + m_channels[m_currentChannel].offset, data, size * sizeof(double));
+    m_currentChannel++;
+}
+
+void AsyncLogger::push(const iDynTree::Rotation& rotation)
+{
+    if(m_isRecordValid && m_currentChannel < m_channels.size()
+       && m_channels[m_currentChannel].type != ChannelType::Rotation)
+    {
+        m_isRecordValid = false;
+        return;
+    }
+
+    // iDynTree matrices are stored in row major order
+    push(rotation.data(), 9);
+}
+
+void AsyncLogger::push(const double& value)
+{
+    push(&value, 1);
+}
+
+bool AsyncLogger::endRecord()
+{
+    if(m_record == nullptr)
+        return false;
+
+    m_record = nullptr;
+
+    if(!m_isRecordValid || m_currentChannel != m_channels.size())
+    {
+        // the error is reported only the first time to avoid flooding the terminal
+        if(m_invalidRecords++ == 0)
+            yError() << "[AsyncLogger::endRecord] The data pushed in the record does not match the channels.";
+        return false;
+    }
+
+    m_ringBuffer.commit();
+    return true;
+}
+
+size_t AsyncLogger::getDroppedRecords() const
+{
+    return m_droppedRecords;
+}
+
+size_t AsyncLogger::getInvalidRecords() const
+{
+    return m_invalidRecords;
+}
+
+size_t AsyncLogger::getPublishedRecords() const
+{
+    return m_publishedRecords;
+}
+
+const std::string& AsyncLogger::getFlightRecorderFileName() const
+{
+    return m_flightRecorderFileName;
+}
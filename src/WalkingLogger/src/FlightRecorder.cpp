@@ -0,0 +1,352 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+// POSIX
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+#include <WalkingControllers/WalkingLogger/FlightRecorder.h>
+
+using namespace WalkingControllers;
+
+namespace
+{
+    constexpr char magic[8] = {'W', 'C', 'F', 'L', 'T', 'R', 'E', 'C'};
+    constexpr std::uint32_t version = 1;
+
+    size_t roundToPageSize(const size_t& size)
+    {
+#ifndef _WIN32
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        const size_t pageSize = 4096;
+#endif
+        return ((size + pageSize - 1) / pageSize) * pageSize;
+    }
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    close();
+}
+
+bool FlightRecorder::open(const std::string& fileName, const std::vector<LoggedChannel>& channels,
+                          const size_t& recordSize, const size_t& recordsPerChunk)
+{
+#ifdef _WIN32
+    yError() << "[FlightRecorder::open] The flight recorder is not supported on this platform.";
+    return false;
+#else
+    if(m_file != -1)
+    {
+        yError() << "[FlightRecorder::open] The file is already open.";
+        return false;
+    }
+
+    if(recordSize == 0 || recordsPerChunk == 0)
+    {
+        yError() << "[FlightRecorder::open] The size of the record and the number of records of each chunk have to be positive numbers.";
+        return false;
+    }
+
+    // schema
+    std::ostringstream schema;
+    for(const auto& channel : channels)
+    {
+        schema << channel.name << "\t" << (channel.type == LoggedChannelType::Rotation ? "rotation" : "vector")
+               << "\t" << channel.offset << "\t" << channel.size << "\t";
+        for(size_t i = 0; i < channel.metadata.size(); i++)
+            schema << (i == 0 ? "" : ",") << channel.metadata[i];
+        schema << "\n";
+    }
+    const std::string schemaString = schema.str();
+
+    m_file = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(m_file == -1)
+    {
+        yError() << "[FlightRecorder::open] Unable to create the file" << fileName << ":" << std::strerror(errno);
+        return false;
+    }
+
+    m_headerMappingSize = roundToPageSize(sizeof(FlightRecorderHeader) + schemaString.size());
+    if(ftruncate(m_file, m_headerMappingSize) != 0)
+    {
+        yError() << "[FlightRecorder::open] Unable to allocate the header:" << std::strerror(errno);
+        close();
+        return false;
+    }
+
+    void* header = mmap(nullptr, m_headerMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+    if(header == MAP_FAILED)
+    {
+        yError() << "[FlightRecorder::open] Unable to map the header:" << std::strerror(errno);
+        close();
+        return false;
+    }
+    m_header = static_cast<FlightRecorderHeader*>(header);
+
+    std::memcpy(m_header->magic, magic, sizeof(magic));
+    m_header->version = version;
+    m_header->reserved = 0;
+    m_header->schemaSize = schemaString.size();
+    m_header->dataOffset = m_headerMappingSize;
+    m_header->recordSize = recordSize;
+    m_header->recordsPerChunk = recordsPerChunk;
+    m_header->chunkSize = roundToPageSize(recordsPerChunk * recordSize * sizeof(double));
+    m_header->numberOfRecords = 0;
+    std::memcpy(reinterpret_cast<char*>(m_header) + sizeof(FlightRecorderHeader),
+                schemaString.data(), schemaString.size());
+
+    m_numberOfChunks = 0;
+    if(!addChunk())
+    {
+        yError() << "[FlightRecorder::open] Unable to allocate the first chunk.";
+        close();
+        return false;
+    }
+
+    return true;
+#endif
+}
+
+bool FlightRecorder::addChunk()
+{
+#ifdef _WIN32
+    return false;
+#else
+    if(m_chunk != nullptr)
+    {
+        munmap(m_chunk, m_header->chunkSize);
+        m_chunk = nullptr;
+    }
+
+    const off_t offset = m_header->dataOffset + m_numberOfChunks * m_header->chunkSize;
+
+#ifdef __linux__
+    // the blocks are reserved, hence the writes in the mapped memory cannot fail if the disk is full
+    if(posix_fallocate(m_file, offset, m_header->chunkSize) != 0)
+#else
+    if(ftruncate(m_file, offset + m_header->chunkSize) != 0)
+#endif
+    {
+        yError() << "[FlightRecorder::addChunk] Unable to allocate a new chunk.";
+        return false;
+    }
+
+    void* chunk = mmap(nullptr, m_header->chunkSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, offset);
+    if(chunk == MAP_FAILED)
+    {
+        yError() << "[FlightRecorder::addChunk] Unable to map the new chunk:" << std::strerror(errno);
+        return false;
+    }
+
+    m_chunk = static_cast<double*>(chunk);
+    m_numberOfChunks++;
+    m_recordsInChunk = 0;
+    return true;
+#endif
+}
+
+double* FlightRecorder::acquire()
+{
+    if(m_header == nullptr)
+        return nullptr;
+
+    if(m_recordsInChunk == m_header->recordsPerChunk && !addChunk())
+        return nullptr;
+
+    return m_chunk + m_recordsInChunk * m_header->recordSize;
+}
+
+void FlightRecorder::commit()
+{
+    m_recordsInChunk++;
+    m_header->numberOfRecords++;
+}
+
+bool FlightRecorder::write(const double* record)
+{
+    double* destination = acquire();
+    if(destination == nullptr)
+        return false;
+
+    std::memcpy(destination, record, m_header->recordSize * sizeof(double));
+    commit();
+    return true;
+}
+
+void FlightRecorder::close()
+{
+#ifndef _WIN32
+    if(m_chunk != nullptr)
+        munmap(m_chunk, m_header->chunkSize);
+
+    if(m_header != nullptr)
+        munmap(m_header, m_headerMappingSize);
+
+    if(m_file != -1)
+        ::close(m_file);
+#endif
+
+    m_chunk = nullptr;
+    m_header = nullptr;
+    m_file = -1;
+}
+
+size_t FlightRecorder::getNumberOfRecords() const
+{
+    return m_header == nullptr ? 0 : m_header->numberOfRecords;
+}
+
+FlightRecorderReader::~FlightRecorderReader()
+{
+    close();
+}
+
+bool FlightRecorderReader::open(const std::string& fileName)
+{
+#ifdef _WIN32
+    yError() << "[FlightRecorderReader::open] The flight recorder is not supported on this platform.";
+    return false;
+#else
+    close();
+
+    m_file = ::open(fileName.c_str(), O_RDONLY);
+    if(m_file == -1)
+    {
+        yError() << "[FlightRecorderReader::open] Unable to open the file" << fileName << ":" << std::strerror(errno);
+        return false;
+    }
+
+    struct stat fileStatus;
+    if(fstat(m_file, &fileStatus) != 0 || static_cast<size_t>(fileStatus.st_size) < sizeof(FlightRecorderHeader))
+    {
+        yError() << "[FlightRecorderReader::open] The file" << fileName << "is not valid.";
+        close();
+        return false;
+    }
+    m_fileSize = fileStatus.st_size;
+
+    void* data = mmap(nullptr, m_fileSize, PROT_READ, MAP_SHARED, m_file, 0);
+    if(data == MAP_FAILED)
+    {
+        yError() << "[FlightRecorderReader::open] Unable to map the file:" << std::strerror(errno);
+        m_data = nullptr;
+        close();
+        return false;
+    }
+    m_data = static_cast<const char*>(data);
+
+    std::memcpy(&m_header, m_data, sizeof(FlightRecorderHeader));
+    if(std::memcmp(m_header.magic, magic, sizeof(magic)) != 0 || m_header.version != version
+       || m_header.recordSize == 0 || m_header.recordsPerChunk == 0 || m_header.chunkSize == 0
+       || sizeof(FlightRecorderHeader) + m_header.schemaSize > m_header.dataOffset
+       || m_header.dataOffset > m_fileSize)
+    {
+        yError() << "[FlightRecorderReader::open] The file" << fileName << "is not a flight recorder file.";
+        close();
+        return false;
+    }
+
+    // the records stored in chunks that were not completely written (e.g. if the disk was full)
+    // are discarded
+    const size_t numberOfChunks = (m_fileSize - m_header.dataOffset) / m_header.chunkSize;
+    if(m_header.numberOfRecords > numberOfChunks * m_header.recordsPerChunk)
+    {
+        yWarning() << "[FlightRecorderReader::open] The file" << fileName << "is truncated.";
+        m_header.numberOfRecords = numberOfChunks * m_header.recordsPerChunk;
+    }
+
+    // schema
+    std::istringstream schema(std::string(m_data + sizeof(FlightRecorderHeader), m_header.schemaSize));
+    std::string line;
+    while(std::getline(schema, line))
+    {
+        std::istringstream fields(line);
+        LoggedChannel channel;
+        std::string type, offset, size, metadata;
+        if(!std::getline(fields, channel.name, '\t') || !std::getline(fields, type, '\t')
+           || !std::getline(fields, offset, '\t') || !std::getline(fields, size, '\t')
+           || !std::getline(fields, metadata))
+        {
+            yError() << "[FlightRecorderReader::open] Unable to parse the schema line:" << line;
+            close();
+            return false;
+        }
+
+        channel.type = type == "rotation" ? LoggedChannelType::Rotation : LoggedChannelType::Vector;
+        channel.offset = std::stoul(offset);
+        channel.size = std::stoul(size);
+
+        std::istringstream elements(metadata);
+        std::string element;
+        while(std::getline(elements, element, ','))
+            channel.metadata.push_back(element);
+
+        if(channel.offset + channel.size > m_header.recordSize)
+        {
+            yError() << "[FlightRecorderReader::open] The channel" << channel.name << "does not fit in the record.";
+            close();
+            return false;
+        }
+
+        m_channels.push_back(std::move(channel));
+    }
+
+    return true;
+#endif
+}
+
+void FlightRecorderReader::close()
+{
+#ifndef _WIN32
+    if(m_data != nullptr)
+        munmap(const_cast<char*>(m_data), m_fileSize);
+
+    if(m_file != -1)
+        ::close(m_file);
+#endif
+
+    m_data = nullptr;
+    m_file = -1;
+    m_fileSize = 0;
+    m_channels.clear();
+}
+
+const std::vector<LoggedChannel>& FlightRecorderReader::getChannels() const
+{
+    return m_channels;
+}
+
+size_t FlightRecorderReader::getNumberOfRecords() const
+{
+    return m_data == nullptr ? 0 : m_header.numberOfRecords;
+}
+
+size_t FlightRecorderReader::getRecordSize() const
+{
+    return m_data == nullptr ? 0 : m_header.recordSize;
+}
+
+const double* FlightRecorderReader::getRecord(const size_t& index) const
+{
+    if(m_data == nullptr || index >= m_header.numberOfRecords)
+        return nullptr;
+
+    const size_t chunk = index / m_header.recordsPerChunk;
+    const size_t record = index % m_header.recordsPerChunk;
+    return reinterpret_cast<const double*>(m_data + m_header.dataOffset + chunk * m_header.chunkSize
+                                           + record * m_header.recordSize * sizeof(double));
+}
@@ -5,7 +5,7 @@
 #define WALKING_MODULE_HPP
 
 // std
-#include <WalkingControllers/WholeBodyControllers/BLFIK.h>
+#include <WalkingControllers/WholeBodyControllers/BLFIKThread.h>
 #include <iDynTree/Rotation.h>
 #include <memory>
 #include <deque>
@@ -13,12 +13,13 @@
 
 // YARP
 #include <yarp/os/RFModule.h>
+#include <yarp/os/Bottle.h>
+#include <yarp/os/BufferedPort.h>
 #include <yarp/sig/Vector.h>
 
 #include <yarp/os/RpcClient.h>
 
 
-#include <BipedalLocomotion/YarpUtilities/VectorsCollectionServer.h>
 #include <BipedalLocomotion/Contacts/GlobalCoPEvaluator.h>
 #include <BipedalLocomotion/System/TimeProfiler.h>
 
@@ -34,18 +35,30 @@
 #include <WalkingControllers/TrajectoryPlanner/StableDCMModel.h>
 #include <WalkingControllers/TrajectoryPlanner/FreeSpaceEllipseManager.h>
 
-#include <WalkingControllers/SimplifiedModelControllers/DCMModelPredictiveController.h>
+#include <WalkingControllers/SimplifiedModelControllers/DCMModelPredictiveControllerThread.h>
 #include <WalkingControllers/SimplifiedModelControllers/DCMReactiveController.h>
 #include <WalkingControllers/SimplifiedModelControllers/ZMPController.h>
+#include <WalkingControllers/SimplifiedModelControllers/SimplifiedModelPipeline.h>
 
 #include <WalkingControllers/WholeBodyControllers/InverseKinematics.h>
 
+#include <WalkingControllers/EigenUtilities/BoundedIntegrator.h>
+
 #include <WalkingControllers/KinDynWrapper/Wrapper.h>
 
 #include <WalkingControllers/RetargetingHelper/Helper.h>
 
 #include <WalkingControllers/YarpUtilities/TransformHelper.h>
 
+#include <WalkingControllers/StdUtilities/TaskGraph.h>
+#include <WalkingControllers/StdUtilities/StageProfiler.h>
+#include <WalkingControllers/StdUtilities/DeadlineWatchdog.h>
+#include <WalkingControllers/StdUtilities/AllocationTracker.h>
+#include <WalkingControllers/StdUtilities/TickArena.h>
+
+#include <WalkingControllers/WalkingLogger/AsyncLogger.h>
+#include <WalkingControllers/WalkingLogger/FlightRecorder.h>
+
 // iCub-ctrl
 #include <iCub/ctrl/filters.h>
 
@@ -59,7 +72,10 @@ namespace WalkingControllers
  */
     class WalkingModule: public yarp::os::RFModule, public WalkingCommands
     {
+    public:
         enum class WalkingFSM {Idle, Configured, Preparing, Prepared, Walking, Paused, Stopped};
+
+    private:
         WalkingFSM m_robotState{WalkingFSM::Idle}; /**< State  of the WalkingFSM. */
 
         double m_dT; /**< RFModule period. */
@@ -70,6 +86,7 @@ namespace WalkingControllers
 
         bool m_useMPC; /**< True if the MPC controller is used. */
         bool m_useQPIK; /**< True if the QP-IK is used. */
+        bool m_useSimplifiedModelPipeline; /**< True if the header-only simplified model pipeline is used. */
         bool m_dumpData; /**< True if data are saved. */
         bool m_firstRun; /**< True if it is the first run. */
         bool m_skipDCMController; /**< True if the desired ZMP should be used instead of the DCM controller. */
@@ -82,20 +99,22 @@ namespace WalkingControllers
         std::unique_ptr<RobotInterface> m_robotControlHelper; /**< Robot control helper. */
         std::unique_ptr<TrajectoryGenerator> m_trajectoryGenerator; /**< Pointer to the trajectory generator object. */
         std::unique_ptr<FreeSpaceEllipseManager> m_freeSpaceEllipseManager; /**< Pointer to the free space ellipse manager. */
-        std::unique_ptr<WalkingController> m_walkingController; /**< Pointer to the walking DCM MPC object. */
+        std::unique_ptr<WalkingControllerThread> m_walkingController; /**< Pointer to the walking DCM MPC object (possibly running at a lower rate). */
         std::unique_ptr<WalkingDCMReactiveController> m_walkingDCMReactiveController; /**< Pointer to the walking DCM reactive controller object. */
         std::unique_ptr<WalkingZMPController> m_walkingZMPController; /**< Pointer to the walking ZMP controller object. */
         std::unique_ptr<WalkingIK> m_IKSolver; /**< Pointer to the inverse kinematics solver. */
-        std::unique_ptr<BLFIK> m_BLFIKSolver; /**< Pointer to the integration based ik. */
+        std::unique_ptr<BLFIKThread> m_BLFIKSolver; /**< Pointer to the integration based ik (possibly running at a lower rate). */
         std::unique_ptr<WalkingFK> m_FKSolver; /**< Pointer to the forward kinematics solver. */
         std::unique_ptr<StableDCMModel> m_stableDCMModel; /**< Pointer to the stable DCM dynamics. */
+        std::unique_ptr<SimplifiedModel::SimplifiedModelPipeline<>> m_simplifiedModelPipeline; /**< Pointer to the simplified model pipeline
+                                                                                                  (3D-LIPM, DCM and ZMP-CoM controllers). */
         std::unique_ptr<WalkingPIDHandler> m_PIDHandler; /**< Pointer to the PID handler object. */
         std::unique_ptr<RetargetingClient> m_retargetingClient; /**< Pointer to the stable DCM dynamics. */
         std::unique_ptr<BipedalLocomotion::System::TimeProfiler> m_profiler; /**< Time profiler. */
         std::unique_ptr<YarpUtilities::TransformHelper> m_transformHelper; /**< Transform server/client helper. */
         BipedalLocomotion::Contacts::GlobalCoPEvaluator m_globalCoPEvaluator;
 
-        std::vector<std::pair<iDynTree::FrameIndex, std::string>> m_framesToStream; /**< Frames to send to the transform server. */
+        std::vector<std::pair<std::size_t, std::string>> m_framesToStream; /**< Frames to send to the transform server (index in the frame set of the FK solver and name). */
 
         double m_additionalRotationWeightDesired; /**< Desired additional rotational weight matrix. */
         double m_desiredJointsWeight; /**< Desired joint weight matrix. */
@@ -147,10 +166,59 @@ namespace WalkingControllers
         size_t m_feedbackAttempts;
         double m_feedbackAttemptDelay;
 
-        // debug
-        std::unique_ptr<iCub::ctrl::Integrator> m_velocityIntegral{nullptr};
+        EigenUtilities::BoundedIntegrator<Eigen::Dynamic> m_velocityIntegral; /**< Integrator of the QP-IK joint velocities within the joint limits. */
+        bool m_saturateJointVelocity{false}; /**< True if the integrated joint velocities are saturated with the limits of the robot. */
+        double m_maxJointAcceleration{0}; /**< Bound on the variation of the integrated joint velocities (0 if not bounded). */
+
+        AsyncLogger m_logger; /**< Logger. The data are sent by a background thread. */
+
+        StdUtilities::TaskGraph m_feedbackTasks; /**< Tasks evaluated to get the feedback (robot and retargeting). */
+        StdUtilities::TaskGraph m_publishTasks; /**< Tasks evaluated to publish the transforms and the logged data. */
+        iDynTree::Vector2 m_loggedMeasuredZMP; /**< ZMP measured in the current tick (used by the logger). */
+        iDynTree::Position m_loggedDesiredCoMPosition; /**< Output of the ZMP-CoM controller in the current tick (used by the logger). */
+
+        /**
+         * Stages of the control loop measured by the stage profiler (in the same order they are
+         * added to the profiler).
+         */
+        enum ProfiledStage : size_t {TotalStage, PlannerStage, FeedbackStage, FKStage, CoPStage,
+                                     DCMControllerStage, ZMPControllerStage, IKStage,
+                                     CommandStage, TransformsStage, LoggerStage};
+        StdUtilities::StageProfiler m_stageProfiler; /**< Histograms of the durations of the stages of the control loop. */
+        yarp::os::BufferedPort<yarp::os::Bottle> m_stageProfilerPort; /**< Port used to publish the statistics of the stages. */
+        size_t m_stageProfilerPeriod{0}; /**< The statistics are published once every m_stageProfilerPeriod ticks (0 to disable the port). */
+        size_t m_stageProfilerCounter{0}; /**< Number of ticks since the statistics were published. */
+        bool m_forbidAllocationsWhileWalking{false}; /**< True if the walking ticks are checked by the AllocationTracker. */
+        StdUtilities::TickArena m_tickArena; /**< Memory of the temporaries of a tick, it is reset at the beginning of updateModule() and used only by the tick. */
+
+        /**
+         * Degradation levels selected by the deadline watchdog. Each level includes the previous ones.
+         */
+        enum DegradationLevel : size_t {NominalLevel, NoLoggingLevel, NoTransformsLevel,
+                                        ReactiveControllerLevel, PauseLevel};
+        bool m_useDeadlineWatchdog{false}; /**< True if the controller is degraded when the ticks overrun the period. */
+        StdUtilities::DeadlineWatchdog m_deadlineWatchdog; /**< Watchdog checking the duration of the ticks. */
+        bool m_mpcDegraded{false}; /**< True if the watchdog replaced the MPC with the DCM reactive controller. */
 
-        BipedalLocomotion::YarpUtilities::VectorsCollectionServer m_vectorsCollectionServer; /**< Logger server. */
+        /**
+         * Channels of the records of the controller inputs (in the same order they are added to
+         * m_inputChannels).
+         */
+        enum InputChannel : size_t {StateInput, JointPositionsInput, JointVelocitiesInput,
+                                    LeftWrenchInput, RightWrenchInput, BasePositionInput,
+                                    BaseOrientationInput, BaseTwistInput, LeftHandPositionInput,
+                                    LeftHandOrientationInput, RightHandPositionInput,
+                                    RightHandOrientationInput, RetargetingJointPositionsInput,
+                                    RetargetingJointVelocitiesInput, RetargetingRawJointPositionsInput,
+                                    CoMHeightInput, GoalSizeInput, GoalInput};
+        std::vector<LoggedChannel> m_inputChannels; /**< Channels of the records of the controller inputs. */
+        size_t m_inputRecordSize{1}; /**< Number of elements of an input record (the first one is the timestamp). */
+        FlightRecorder m_inputRecorder; /**< Recorder of the controller inputs (robot feedback, retargeting and goal). */
+        bool m_recordInputs{false}; /**< True if the controller inputs are recorded. */
+        bool m_replayInputs{false}; /**< True if the controller inputs are set by setReplayedInputs(). */
+        bool m_isGoalReceived{false}; /**< True if a goal was received (or replayed) in the current tick. */
+        yarp::sig::Vector m_receivedGoal; /**< Goal received in the current tick (before the scaling). */
+        yarp::sig::Vector m_replayedGoal; /**< Replayed goal, scaled in place by the tick. */
 
         /**
          * Get the robot model from the resource finder and set it.
@@ -202,6 +270,62 @@ namespace WalkingControllers
          */
         iDynTree::Rotation computeAverageYawRotationFromPlannedFeet() const;
 
+        /**
+         * Publish the transforms through the transform helper.
+         */
+        void publishTransforms();
+
+        /**
+         * Send the data of the current tick to the logger.
+         */
+        void sendLoggerData();
+
+        /**
+         * Publish the statistics of the stages of the control loop. For each stage the port
+         * contains a list (name count mean p50 p99 p99.9 max), the times are in seconds.
+         */
+        void publishStageProfiler();
+
+        /**
+         * Update the deadline watchdog and apply the degradation level (i.e. switch to the DCM
+         * reactive controller or pause walking).
+         * @param tickDuration duration of the current tick in seconds.
+         */
+        void updateDeadlineWatchdog(const double& tickDuration);
+
+        /**
+         * Add a channel to the records of the controller inputs.
+         * @param name name of the channel;
+         * @param metadata metadata of the channel (one for each published element);
+         * @param type type of the channel.
+         */
+        void addInputChannel(const std::string& name, const std::vector<std::string>& metadata,
+                             const LoggedChannelType& type = LoggedChannelType::Vector);
+
+        /**
+         * Record the inputs of the current tick, i.e. the state of the module, the feedback of
+         * the robot, the outputs of the retargeting client and the goal.
+         */
+        void recordInputs();
+
+        /**
+         * Get the desired ZMP evaluated by the DCM controller.
+         * @return the desired ZMP.
+         */
+        iDynTree::Vector2 getDCMControllerOutput() const;
+
+        /**
+         * Get the CoM position of the 3D-LIPM.
+         * @return the desired CoM position.
+         */
+        iDynTree::Vector2 getLIPMCoMPosition() const;
+
+        /**
+         * Get the CoM velocity of the 3D-LIPM.
+         * @return the desired CoM velocity.
+         */
+        iDynTree::Vector2 getLIPMCoMVelocity() const;
+
         /**
          * Generate the first trajectory.
          * This method has to be called before updateTrajectories() method.
@@ -234,9 +358,11 @@ namespace WalkingControllers
          * This method has to be called only if the trajectory generator has finished to evaluate the new trajectory.
          * The old and the new trajectory will be merged at mergePoint.
          * @param mergePoint instant at which the old and the new trajectory will be merged
+         * @param memoryResource memory of the temporary copies of the trajectories. The tick
+         * arena can be used only by updateModule(), the other callers use the default resource.
          * @return true/false in case of success/failure.
          */
-        bool updateTrajectories(const size_t& mergePoint);
+        bool updateTrajectories(const size_t& mergePoint, std::pmr::memory_resource* memoryResource);
 
         /**
          * Set the input of the planner. The size of the input is different according to the
@@ -289,6 +415,46 @@ namespace WalkingControllers
          */
         bool close() override;
 
+        /**
+         * Check if the robot is prepared, i.e. the walking can be started.
+         * @return true if the robot is prepared.
+         */
+        bool isPrepared();
+
+        /**
+         * Check if the robot is walking.
+         * @return true if the robot is walking.
+         */
+        bool isWalking();
+
+        /**
+         * Get the profiler of the stages of the control loop.
+         * @return the stage profiler.
+         */
+        const StdUtilities::StageProfiler& getStageProfiler() const;
+
+        /**
+         * Get the arena used for the temporaries of the control loop.
+         * @return the tick arena.
+         */
+        const StdUtilities::TickArena& getTickArena() const;
+
+        /**
+         * Get the channels of the records of the controller inputs (input_recorder_prefix option).
+         * @return the channels of the records.
+         */
+        const std::vector<LoggedChannel>& getInputChannels() const;
+
+        /**
+         * Set the inputs of the next tick from a record of the controller inputs. From now on
+         * the robot feedback, the retargeting outputs and the goal are not read anymore. The
+         * recorded state of the module is ignored, the commands (e.g. startWalking()) have to
+         * be called by the caller.
+         * @param record record written by the input recorder (timestamp included).
+         * @return true in case of success and false otherwise.
+         */
+        bool setReplayedInputs(const double* record);
+
         /**
          * This allows you to put the robot in a home position for walking.
          * @return true in case of success and false otherwise.
@@ -318,6 +484,42 @@ namespace WalkingControllers
          * @return true in case of success and false otherwise.
          */
         virtual bool stopWalking() override;
+
+        /**
+         * Set the decimation of the channels sent by the logger.
+         * @param channel name of the channel or prefix of a group of channels;
+         * @param decimation the channels are sent once every decimation steps.
+         * @return true in case of success and false otherwise.
+         */
+        virtual bool setLoggerChannelDecimation(const std::string& channel, const std::int32_t decimation) override;
+
+        /**
+         * Enable or disable the channels sent by the logger.
+         * @param channel name of the channel or prefix of a group of channels;
+         * @param enable true if the channels have to be sent.
+         * @return true in case of success and false otherwise.
+         */
+        virtual bool enableLoggerChannel(const std::string& channel, const bool enable) override;
+
+        /**
+         * Send the last seconds of logged data (the logger has to be in trigger mode).
+         * @return true in case of success and false otherwise.
+         */
+        virtual bool triggerLogger() override;
+
+        /**
+         * Get the statistics of the stages of the control loop.
+         * @return a table containing the number of samples, the mean, the 50th, 99th and 99.9th
+         * percentiles and the maximum duration (in milliseconds) of each stage, followed by the
+         * peak usage of the tick arena.
+         */
+        virtual std::string getStageProfilerReport() override;
+
+        /**
+         * Reset the statistics of the stages of the control loop.
+         * @return true in case of success and false otherwise.
+         */
+        virtual bool resetStageProfiler() override;
     };
 };
 #endif
@@ -0,0 +1,385 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+// YARP
+#include <yarp/os/BufferedPort.h>
+#include <yarp/os/Clock.h>
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Network.h>
+#include <yarp/os/ResourceFinder.h>
+#include <yarp/os/Time.h>
+#include <yarp/sig/Vector.h>
+
+#include <WalkingControllers/WalkingLogger/FlightRecorder.h>
+#include <WalkingControllers/WalkingModule/Module.h>
+#include <WalkingControllers/YarpUtilities/Helper.h>
+
+using namespace WalkingControllers;
+
+namespace
+{
+    /**
+     * Clock advanced by the harness. The delays wait for the wall time without advancing the
+     * simulated time, so the other threads of the module can progress while it is frozen.
+     */
+    class SimulatedClock : public yarp::os::Clock
+    {
+        std::atomic<double> m_now{0}; /**< Current time [s]. */
+
+    public:
+
+        double now() override
+        {
+            return m_now;
+        }
+
+        void delay(double seconds) override
+        {
+            if (seconds > 0)
+                std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+        }
+
+        bool isValid() const override
+        {
+            return true;
+        }
+
+        /**
+         * Advance the time.
+         * @param dT time step [s].
+         */
+        void advance(const double& dT)
+        {
+            m_now = m_now + dT;
+        }
+
+        /**
+         * Set the time.
+         * @param now current time [s].
+         */
+        void set(const double& now)
+        {
+            m_now = now;
+        }
+    };
+
+    /**
+     * Check that the channels of a log match the inputs of the module.
+     * @param logChannels channels stored in the log;
+     * @param moduleChannels input channels of the module.
+     * @return true if the channels match and false otherwise.
+     */
+    bool checkInputChannels(const std::vector<LoggedChannel>& logChannels,
+                            const std::vector<LoggedChannel>& moduleChannels)
+    {
+        if (logChannels.size() != moduleChannels.size())
+        {
+            yError() << "[checkInputChannels] The log contains" << logChannels.size()
+                     << "channels while the module expects" << moduleChannels.size();
+            return false;
+        }
+
+        for (size_t i = 0; i < logChannels.size(); i++)
+        {
+            if (logChannels[i].name != moduleChannels[i].name
+                || logChannels[i].offset != moduleChannels[i].offset
+                || logChannels[i].size != moduleChannels[i].size)
+            {
+                yError() << "[checkInputChannels] The channel" << logChannels[i].name
+                         << "does not match the channel" << moduleChannels[i].name
+                         << "of the module. Was the log recorded with a different robot?";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Replay the inputs recorded by the module. The state transitions stored in the log are
+     * requested to the module as done by the RPC port. The preparation is simulated by the
+     * kinematic plant, hence before starting to walk the harness waits for the robot to be
+     * prepared and the recorded time is shifted accordingly.
+     * @param module the walking module;
+     * @param clock the simulated clock;
+     * @param log the recorded inputs;
+     * @param realTime if true the records are replayed at the recorded rate, otherwise as fast
+     * as possible;
+     * @param maxPreparationTime maximum time for the preparation of the robot [s];
+     * @param ticks number of walking ticks;
+     * @param wallTime wall-clock walking time [s].
+     * @return true in case of success and false otherwise.
+     */
+    bool replay(WalkingModule& module, SimulatedClock& clock, const FlightRecorderReader& log,
+                const bool& realTime, const double& maxPreparationTime, size_t& ticks, double& wallTime)
+    {
+        using WalkingFSM = WalkingModule::WalkingFSM;
+
+        const double dT = module.getPeriod();
+        const size_t stateOffset = module.getInputChannels().front().offset;
+        const double firstTimestamp = log.getRecord(0)[0];
+        const auto wallReplayBeginning = std::chrono::steady_clock::now();
+
+        std::chrono::steady_clock::time_point wallBeginning;
+        double timeOffset = 0;
+        bool isPreparationRequested = false;
+        WalkingFSM previousState = WalkingFSM::Configured;
+        ticks = 0;
+        wallTime = 0;
+
+        for (size_t i = 0; i < log.getNumberOfRecords(); i++)
+        {
+            const double* record = log.getRecord(i);
+            const WalkingFSM state = static_cast<WalkingFSM>(static_cast<int>(record[stateOffset]));
+
+            if (realTime)
+                std::this_thread::sleep_until(wallReplayBeginning
+                                              + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                  std::chrono::duration<double>(record[0] - firstTimestamp)));
+
+            bool ok = true;
+            if (state == WalkingFSM::Preparing && !isPreparationRequested)
+            {
+                ok = module.prepareRobot();
+                isPreparationRequested = true;
+            }
+            else if (state == WalkingFSM::Walking && previousState == WalkingFSM::Paused)
+                ok = module.startWalking();
+            else if (state == WalkingFSM::Walking && previousState != WalkingFSM::Walking)
+            {
+                // the log may begin while the robot is walking
+                if (!isPreparationRequested)
+                {
+                    ok = module.prepareRobot();
+                    isPreparationRequested = true;
+                }
+
+                for (double time = 0; ok && !module.isPrepared(); time += dT)
+                {
+                    timeOffset += dT;
+                    clock.set(record[0] - firstTimestamp + timeOffset);
+                    ok = module.updateModule() && time < maxPreparationTime;
+                }
+
+                ok = ok && module.startWalking();
+                if (ticks == 0)
+                    wallBeginning = std::chrono::steady_clock::now();
+            }
+            else if (state == WalkingFSM::Paused && previousState == WalkingFSM::Walking)
+                ok = module.pauseWalking();
+            else if (state == WalkingFSM::Stopped && previousState != WalkingFSM::Stopped)
+                ok = module.stopWalking();
+
+            if (!ok)
+            {
+                yError() << "[replay] Unable to reproduce the state transition of the record" << i;
+                return false;
+            }
+            previousState = state;
+
+            if (!module.setReplayedInputs(record))
+            {
+                yError() << "[replay] Unable to set the inputs of the record" << i;
+                return false;
+            }
+
+            clock.set(record[0] - firstTimestamp + timeOffset);
+            if (!module.updateModule())
+            {
+                yError() << "[replay] The control loop failed at the record" << i;
+                return false;
+            }
+
+            if (state == WalkingFSM::Walking)
+            {
+                ticks++;
+                wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallBeginning).count();
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Write the statistics of the control loop in a json file.
+     * @param fileName name of the file;
+     * @param profiler stage profiler of the module;
+     * @param arena tick arena of the module;
+     * @param ticks number of walking ticks;
+     * @param simulatedTime simulated walking time [s];
+     * @param wallTime wall-clock walking time [s].
+     * @return true in case of success and false otherwise.
+     */
+    bool writeReport(const std::string& fileName, const StdUtilities::StageProfiler& profiler,
+                     const StdUtilities::TickArena& arena, const size_t& ticks, const double& simulatedTime, const double& wallTime)
+    {
+        std::ofstream file(fileName);
+        if (!file.is_open())
+        {
+            yError() << "[writeReport] Unable to open the file" << fileName;
+            return false;
+        }
+
+        file << "{\n"
+             << "  \"ticks\": " << ticks << ",\n"
+             << "  \"simulated_time\": " << simulatedTime << ",\n"
+             << "  \"wall_time\": " << wallTime << ",\n"
+             << "  \"real_time_factor\": " << (wallTime > 0 ? simulatedTime / wallTime : 0) << ",\n"
+             << "  \"stages\": {";
+
+        for (size_t i = 0; i < profiler.numberOfStages(); i++)
+        {
+            const StdUtilities::StageProfiler::Statistics statistics = profiler.getStatistics(i);
+            file << (i == 0 ? "\n" : ",\n")
+                 << "    \"" << statistics.name << "\": {"
+                 << "\"count\": " << statistics.count
+                 << ", \"mean_ms\": " << statistics.mean * 1e3
+                 << ", \"p50_ms\": " << statistics.p50 * 1e3
+                 << ", \"p99_ms\": " << statistics.p99 * 1e3
+                 << ", \"p999_ms\": " << statistics.p999 * 1e3
+                 << ", \"max_ms\": " << statistics.max * 1e3
+                 << ", \"allocations\": " << statistics.allocations
+                 << ", \"max_allocations\": " << statistics.maxAllocations << "}";
+        }
+        file << "\n  },\n"
+             << "  \"tick_arena\": {\"capacity\": " << arena.getCapacity()
+             << ", \"peak_bytes\": " << arena.getPeakBytes()
+             << ", \"overflows\": " << arena.getOverflows() << "}\n}\n";
+
+        return file.good();
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    // the time is simulated, the control loop runs as fast as possible. The clock is created
+    // before the network so that it outlives it
+    SimulatedClock clock;
+
+    // the ports are local to the process, the YARP server is not required
+    yarp::os::Network yarp;
+    yarp::os::NetworkBase::setLocalMode(true);
+    yarp::os::Time::useCustomClock(&clock);
+
+    // prepare and configure the resource finder
+    yarp::os::ResourceFinder& rf = yarp::os::ResourceFinder::getResourceFinderSingleton();
+    rf.setDefaultConfigFile("dcm_walking_with_joypad.ini");
+    rf.setDefault("use_kinematic_plant", "true");
+    rf.configure(argc, argv);
+
+    const double duration = rf.check("duration", yarp::os::Value(20.0)).asFloat64();
+    const double maxPreparationTime = rf.check("max_preparation_time", yarp::os::Value(10.0)).asFloat64();
+    const std::string reportFileName = rf.check("report", yarp::os::Value("")).asString();
+
+    yarp::sig::Vector goal(3, 0.0);
+    goal(0) = 1.0;
+    if (rf.check("goal") && !YarpUtilities::getVectorFromSearchable(rf, "goal", goal))
+    {
+        yError() << "[main] The goal is supposed to be a list of three numbers.";
+        return EXIT_FAILURE;
+    }
+
+    WalkingModule module;
+    if (!module.configure(rf))
+    {
+        yError() << "[main] Unable to configure the module.";
+        return EXIT_FAILURE;
+    }
+
+    const double dT = module.getPeriod();
+
+    // replay of the recorded inputs
+    if (rf.check("replay"))
+    {
+        FlightRecorderReader log;
+        if (!log.open(rf.find("replay").asString()) || log.getNumberOfRecords() == 0
+            || !checkInputChannels(log.getChannels(), module.getInputChannels()))
+        {
+            yError() << "[main] Unable to load the recorded inputs.";
+            module.close();
+            return EXIT_FAILURE;
+        }
+
+        size_t ticks;
+        double wallTime;
+        bool ok = replay(module, clock, log, rf.check("real_time"), maxPreparationTime, ticks, wallTime);
+
+        std::cout << module.getStageProfilerReport();
+        std::cout << "Replayed records: " << log.getNumberOfRecords() << ", simulated walking time: "
+                  << ticks * dT << " s, wall time: " << wallTime << " s" << std::endl;
+
+        if (!reportFileName.empty()
+            && !writeReport(reportFileName, module.getStageProfiler(), module.getTickArena(), ticks, ticks * dT, wallTime))
+            ok = false;
+
+        module.close();
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // the goal is sent as the joypad does
+    yarp::os::BufferedPort<yarp::sig::Vector> goalPort;
+    const std::string goalPortName = "/" + module.getName() + "/harness/goal:o";
+    if (!goalPort.open(goalPortName)
+        || !yarp::os::Network::connect(goalPortName, "/" + module.getName()
+                                       + rf.check("goal_port_suffix", yarp::os::Value("/goal:i")).asString()))
+    {
+        yError() << "[main] Unable to open the goal port.";
+        module.close();
+        return EXIT_FAILURE;
+    }
+
+    bool ok = module.prepareRobot();
+    for (double time = 0; ok && !module.isPrepared(); time += dT)
+    {
+        clock.advance(dT);
+        ok = module.updateModule() && time < maxPreparationTime;
+    }
+
+    if (!ok || !module.startWalking())
+    {
+        yError() << "[main] Unable to prepare the robot.";
+        goalPort.close();
+        module.close();
+        return EXIT_FAILURE;
+    }
+
+    size_t ticks = 0;
+    const auto wallBeginning = std::chrono::steady_clock::now();
+    for (double time = 0; ok && time < duration && module.isWalking(); time += dT)
+    {
+        yarp::sig::Vector& goalToSend = goalPort.prepare();
+        goalToSend = goal;
+        goalPort.write();
+
+        clock.advance(dT);
+        ok = module.updateModule();
+        ticks++;
+    }
+    const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallBeginning).count();
+
+    if (!ok)
+        yError() << "[main] The control loop failed after" << ticks * dT << "seconds.";
+    else if (!module.isWalking())
+    {
+        yError() << "[main] The robot stopped walking after" << ticks * dT << "seconds.";
+        ok = false;
+    }
+
+    std::cout << module.getStageProfilerReport();
+    std::cout << "Simulated time: " << ticks * dT << " s, wall time: " << wallTime << " s" << std::endl;
+
+    if (!reportFileName.empty()
+        && !writeReport(reportFileName, module.getStageProfiler(), module.getTickArena(), ticks, ticks * dT, wallTime))
+        ok = false;
+
+    goalPort.close();
+    module.close();
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
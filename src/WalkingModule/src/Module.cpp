@@ -5,6 +5,10 @@
 #include <iostream>
 #include <memory>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <memory_resource>
 
 // YARP
 #include <yarp/eigen/Eigen.h>
@@ -14,6 +18,7 @@
 #include <yarp/sig/Matrix.h>
 #include <yarp/sig/Vector.h>
 #include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
 
 // iDynTree
 #include <iDynTree/VectorFixSize.h>
@@ -32,7 +37,7 @@
 #include <WalkingControllers/WalkingModule/Module.h>
 #include <WalkingControllers/YarpUtilities/Helper.h>
 #include <WalkingControllers/StdUtilities/Helper.h>
-#include <WalkingControllers/WholeBodyControllers/BLFIK.h>
+#include <WalkingControllers/WholeBodyControllers/BLFIKThread.h>
 
 using namespace WalkingControllers;
 
@@ -133,6 +138,14 @@ bool WalkingModule::configure(yarp::os::ResourceFinder &rf)
     // module name (used as prefix for opened ports)
     m_useMPC = rf.check("use_mpc", yarp::os::Value(false)).asBool();
     m_useQPIK = rf.check("use_QP-IK", yarp::os::Value(false)).asBool();
+    m_saturateJointVelocity = rf.check("saturate_joint_velocity", yarp::os::Value(false)).asBool();
+    m_maxJointAcceleration = rf.check("max_joint_acceleration", yarp::os::Value(0.0)).asFloat64();
+    if (m_maxJointAcceleration < 0)
+    {
+        yError() << "[WalkingModule::configure] max_joint_acceleration is supposed to be non negative.";
+        return false;
+    }
+    m_useSimplifiedModelPipeline = rf.check("use_simplified_model_pipeline", yarp::os::Value(false)).asBool();
     m_dumpData = rf.check("dump_data", yarp::os::Value(false)).asBool();
     m_maxInitialCoMVelocity = rf.check("max_initial_com_vel", yarp::os::Value(1.0)).asFloat64();
     std::string goalSuffix = rf.check("goal_port_suffix", yarp::os::Value("/goal:i")).asString();
@@ -156,6 +169,36 @@ bool WalkingModule::configure(yarp::os::ResourceFinder &rf)
         return false;
     }
 
+    // deadline watchdog. When the ticks overrun the period the module stops logging, stops
+    // publishing the transforms, switches from the MPC to the DCM reactive controller and
+    // finally pauses walking
+    m_useDeadlineWatchdog = rf.check("deadline_watchdog", yarp::os::Value(false)).asBool();
+    if (m_useDeadlineWatchdog)
+    {
+        const double overrunRatio = rf.check("deadline_overrun_ratio", yarp::os::Value(1.0)).asFloat64();
+        const int window = rf.check("deadline_window", yarp::os::Value(100)).asInt32();
+        std::vector<size_t> thresholds{5, 10, 20, 40};
+        yarp::os::Value* thresholdsValue;
+        if (rf.check("deadline_thresholds", thresholdsValue))
+        {
+            if (!thresholdsValue->isList() || thresholdsValue->asList()->size() != thresholds.size())
+            {
+                yError() << "[WalkingModule::configure] deadline_thresholds is supposed to be a list of"
+                         << thresholds.size() << "elements.";
+                return false;
+            }
+            for (size_t i = 0; i < thresholds.size(); i++)
+                thresholds[i] = static_cast<size_t>(std::max(thresholdsValue->asList()->get(i).asInt32(), 0));
+        }
+
+        if (window <= 0
+            || !m_deadlineWatchdog.initialize(m_dT, overrunRatio, window, thresholds, ReactiveControllerLevel))
+        {
+            yError() << "[WalkingModule::configure] Unable to initialize the deadline watchdog.";
+            return false;
+        }
+    }
+
     double maxFBDelay = rf.check("max_feedback_delay_in_s", yarp::os::Value(1.0)).asFloat64();
     m_feedbackAttemptDelay = m_dT / 10;
     m_feedbackAttempts = static_cast<size_t>(std::round(maxFBDelay / m_feedbackAttemptDelay));
@@ -177,6 +220,14 @@ bool WalkingModule::configure(yarp::os::ResourceFinder &rf)
     m_robotControlHelper = std::make_unique<RobotInterface>();
     yarp::os::Bottle &robotControlHelperOptions = rf.findGroup("ROBOT_CONTROL");
     robotControlHelperOptions.append(generalOptions);
+    // the kinematic plant replaces the robot when the controller runs offline (see the
+    // WalkingClosedLoopHarness application)
+    if (rf.check("use_kinematic_plant", yarp::os::Value(false)).asBool())
+    {
+        yarp::os::Bottle& kinematicPlantOption = robotControlHelperOptions.addList();
+        kinematicPlantOption.addString("use_kinematic_plant");
+        kinematicPlantOption.addBool(true);
+    }
     if (!m_robotControlHelper->configureRobot(robotControlHelperOptions))
     {
         yError() << "[WalkingModule::configure] Unable to configure the robot.";
@@ -205,6 +256,18 @@ bool WalkingModule::configure(yarp::os::ResourceFinder &rf)
         return false;
     }
 
+    // the kinematic plant replaces the robot when the controller runs offline
+    if (m_robotControlHelper->isKinematicPlantUsed())
+    {
+        yarp::os::Bottle kinematicPlantOptions = rf.findGroup("FORWARD_KINEMATICS_SOLVER");
+        kinematicPlantOptions.append(robotControlHelperOptions);
+        if (!m_robotControlHelper->configureKinematicPlant(m_loader.model(), kinematicPlantOptions))
+        {
+            yError() << "[WalkingModule::configure] Unable to configure the kinematic plant.";
+            return false;
+        }
+    }
+
     // open RPC port for external command
     std::string rpcPortName = "/" + getName() + "/rpc";
     this->yarp().attachAsServer(this->m_rpcPort);
@@ -242,10 +305,31 @@ bool WalkingModule::configure(yarp::os::ResourceFinder &rf)
         return false;
     }
 
-    if (m_useMPC)
+    if (m_useSimplifiedModelPipeline && m_useMPC)
+    {
+        yError() << "[WalkingModule::configure] The simplified model pipeline can be used only "
+                 << "with the DCM reactive controller.";
+        return false;
+    }
+
+    if (m_useSimplifiedModelPipeline)
+    {
+        // initialize the simplified model pipeline (3D-LIPM, DCM and ZMP-CoM controllers)
+        m_simplifiedModelPipeline = std::make_unique<SimplifiedModel::SimplifiedModelPipeline<>>();
+        yarp::os::Bottle &dcmControllerOptions = rf.findGroup("DCM_REACTIVE_CONTROLLER");
+        dcmControllerOptions.append(generalOptions);
+        yarp::os::Bottle &zmpControllerOptions = rf.findGroup("ZMP_CONTROLLER");
+        zmpControllerOptions.append(generalOptions);
+        if (!m_simplifiedModelPipeline->initialize(dcmControllerOptions, zmpControllerOptions))
+        {
+            yError() << "[WalkingModule::configure] Unable to initialize the simplified model pipeline.";
+            return false;
+        }
+    }
+    else if (m_useMPC)
     {
         // initialize the MPC controller
-        m_walkingController = std::make_unique<WalkingController>();
+        m_walkingController = std::make_unique<WalkingControllerThread>();
         yarp::os::Bottle &dcmControllerOptions = rf.findGroup("DCM_MPC_CONTROLLER");
         dcmControllerOptions.append(generalOptions);
         if (!m_walkingController->initialize(dcmControllerOptions))
@@ -254,9 +338,11 @@ bool WalkingModule::configure(yarp::os::ResourceFinder &rf)
             return false;
         }
     }
-    else
+
+    if (!m_useSimplifiedModelPipeline && (!m_useMPC || m_useDeadlineWatchdog))
     {
-        // initialize the MPC controller
+        // initialize the DCM reactive controller. If the MPC is used, it is the controller used
+        // by the deadline watchdog in case of overload
         m_walkingDCMReactiveController = std::make_unique<WalkingDCMReactiveController>();
         yarp::os::Bottle &dcmControllerOptions = rf.findGroup("DCM_REACTIVE_CONTROLLER");
         dcmControllerOptions.append(generalOptions);
@@ -267,14 +353,17 @@ bool WalkingModule::configure(yarp::os::ResourceFinder &rf)
         }
     }
 
-    // initialize the ZMP controller
-    m_walkingZMPController = std::make_unique<WalkingZMPController>();
-    yarp::os::Bottle &zmpControllerOptions = rf.findGroup("ZMP_CONTROLLER");
-    zmpControllerOptions.append(generalOptions);
-    if (!m_walkingZMPController->initialize(zmpControllerOptions))
+    if (!m_useSimplifiedModelPipeline)
     {
-        yError() << "[WalkingModule::configure] Unable to initialize the ZMP controller.";
-        return false;
+        // initialize the ZMP controller
+        m_walkingZMPController = std::make_unique<WalkingZMPController>();
+        yarp::os::Bottle &zmpControllerOptions = rf.findGroup("ZMP_CONTROLLER");
+        zmpControllerOptions.append(generalOptions);
+        if (!m_walkingZMPController->initialize(zmpControllerOptions))
+        {
+            yError() << "[WalkingModule::configure] Unable to initialize the ZMP controller.";
+            return false;
+        }
     }
 
     // initialize the inverse kinematics solver
@@ -302,24 +391,29 @@ bool WalkingModule::configure(yarp::os::ResourceFinder &rf)
         yarp::os::Bottle &inverseKinematicsQPSolverOptions = rf.findGroup("INVERSE_KINEMATICS_QP_SOLVER");
         // TODO check if this is required
         inverseKinematicsQPSolverOptions.append(generalOptions);
-        m_BLFIKSolver = std::make_unique<BLFIK>();
+        m_BLFIKSolver = std::make_unique<BLFIKThread>();
         auto paramHandler = std::make_shared<BipedalLocomotion::ParametersHandler::YarpImplementation>();
         paramHandler->set(inverseKinematicsQPSolverOptions);
         paramHandler->setParameter("use_root_link_for_height", m_useRootLinkForHeight);
 
-        if (!m_BLFIKSolver->initialize(paramHandler, m_FKSolver->getKinDyn()))
+        // the QP-IK is evaluated on the desired state of the robot, hence the measured kinematics
+        // is not invalidated at each tick
+        if (!m_BLFIKSolver->initialize(paramHandler, m_FKSolver->getKinDyn(WalkingFK::KinematicState::Desired)))
         {
             yError() << "[WalkingModule::configure] Failed to configure the blf ik solver";
             return false;
         }
     }
 
-    // initialize the linear inverted pendulum model
-    m_stableDCMModel = std::make_unique<StableDCMModel>();
-    if (!m_stableDCMModel->initialize(generalOptions))
+    if (!m_useSimplifiedModelPipeline)
     {
-        yError() << "[WalkingModule::configure] Failed to configure the lipm.";
-        return false;
+        // initialize the linear inverted pendulum model
+        m_stableDCMModel = std::make_unique<StableDCMModel>();
+        if (!m_stableDCMModel->initialize(generalOptions))
+        {
+            yError() << "[WalkingModule::configure] Failed to configure the lipm.";
+            return false;
+        }
     }
 
     // set PIDs gains
@@ -352,10 +446,12 @@ bool WalkingModule::configure(yarp::os::ResourceFinder &rf)
             m_transformHelper.reset(nullptr);
         }
         else {
+            // the transforms of the frames are evaluated together by the FK solver
             for (const std::string& frame : m_transformHelper->getAdditionalFrames())
             {
-                iDynTree::FrameIndex frameIndex = m_loader.model().getFrameIndex(frame);
-                if (frameIndex != iDynTree::FRAME_INVALID_INDEX)
+                std::size_t frameIndex;
+                if (m_loader.model().getFrameIndex(frame) != iDynTree::FRAME_INVALID_INDEX
+                    && m_FKSolver->addFrame(frame, frameIndex))
                 {
                     m_framesToStream.push_back({ frameIndex, frame });
                 }
@@ -387,66 +483,236 @@ bool WalkingModule::configure(yarp::os::ResourceFinder &rf)
         // prepend the module name to the port name
         logPort = "/" + getName() + logPort;
         loggerOption->setParameter("remote", logPort);
-        if (!m_vectorsCollectionServer.initialize(loggerOption))
+        loggerOption->setParameter("sampling_time", m_dT);
+        if (!m_logger.initialize(loggerOption))
         {
-            yError() << "[WalkingModule::configure] Unable to get the string from searchable.";
+            yError() << "[WalkingModule::configure] Unable to initialize the logger.";
             return false;
         }
 
-        m_vectorsCollectionServer.populateMetadata("dcm::position::measured", {"x", "y"});
-        m_vectorsCollectionServer.populateMetadata("dcm::position::desired", {"x", "y"});
-        m_vectorsCollectionServer.populateMetadata("dcm::velocity::desired", {"x", "y"});
+        bool ok = m_logger.addChannel("dcm::position::measured", {"x", "y"});
+        ok = ok && m_logger.addChannel("dcm::position::desired", {"x", "y"});
+        ok = ok && m_logger.addChannel("dcm::velocity::desired", {"x", "y"});
 
         // ZMP
-        m_vectorsCollectionServer.populateMetadata("zmp::measured", {"x", "y"});
-        m_vectorsCollectionServer.populateMetadata("zmp::desired", {"x", "y"});
+        ok = ok && m_logger.addChannel("zmp::measured", {"x", "y"});
+        ok = ok && m_logger.addChannel("zmp::desired", {"x", "y"});
 
-        m_vectorsCollectionServer.populateMetadata("zmp::desired_planner", {"x", "y"});
+        ok = ok && m_logger.addChannel("zmp::desired_planner", {"x", "y"});
 
         // COM
-        m_vectorsCollectionServer.populateMetadata("com::position::measured", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("com::position::desired", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("com::position::CoM_ZMP_controller", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("com::velocity::desired", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("com::position::measured", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("com::position::desired", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("com::position::CoM_ZMP_controller", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("com::velocity::desired", {"x", "y", "z"});
 
         // Left foot
-        m_vectorsCollectionServer.populateMetadata("left_foot::position::measured", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("left_foot::position::desired", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("left_foot::orientation::measured", {"roll", "pitch", "yaw"});
-        m_vectorsCollectionServer.populateMetadata("left_foot::orientation::desired", {"roll", "pitch", "yaw"});
-        m_vectorsCollectionServer.populateMetadata("left_foot::linear_velocity::desired", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("left_foot::angular_velocity::desired", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("left_foot::linear_force::measured", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("left_foot::angular_torque::measured", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("left_foot::position::measured", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("left_foot::position::desired", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("left_foot::orientation::measured", {"roll", "pitch", "yaw"}, AsyncLogger::ChannelType::Rotation);
+        ok = ok && m_logger.addChannel("left_foot::orientation::desired", {"roll", "pitch", "yaw"}, AsyncLogger::ChannelType::Rotation);
+        ok = ok && m_logger.addChannel("left_foot::linear_velocity::desired", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("left_foot::angular_velocity::desired", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("left_foot::linear_force::measured", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("left_foot::angular_torque::measured", {"x", "y", "z"});
 
         // Right foot
-        m_vectorsCollectionServer.populateMetadata("right_foot::position::measured", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("right_foot::position::desired", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("right_foot::orientation::measured", {"roll", "pitch", "yaw"});
-        m_vectorsCollectionServer.populateMetadata("right_foot::orientation::desired", {"roll", "pitch", "yaw"});
-        m_vectorsCollectionServer.populateMetadata("right_foot::linear_velocity::desired", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("right_foot::angular_velocity::desired", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("right_foot::linear_force::measured", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("right_foot::angular_torque::measured", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("right_foot::position::measured", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("right_foot::position::desired", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("right_foot::orientation::measured", {"roll", "pitch", "yaw"}, AsyncLogger::ChannelType::Rotation);
+        ok = ok && m_logger.addChannel("right_foot::orientation::desired", {"roll", "pitch", "yaw"}, AsyncLogger::ChannelType::Rotation);
+        ok = ok && m_logger.addChannel("right_foot::linear_velocity::desired", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("right_foot::angular_velocity::desired", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("right_foot::linear_force::measured", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("right_foot::angular_torque::measured", {"x", "y", "z"});
 
         // Joint
-        m_vectorsCollectionServer.populateMetadata("joints_state::positions::measured", m_robotControlHelper->getAxesList());
-        m_vectorsCollectionServer.populateMetadata("joints_state::positions::desired", m_robotControlHelper->getAxesList());
-        m_vectorsCollectionServer.populateMetadata("joints_state::positions::retargeting", m_robotControlHelper->getAxesList());
-        m_vectorsCollectionServer.populateMetadata("joints_state::positions::retargeting_raw", m_robotControlHelper->getAxesList());
-        m_vectorsCollectionServer.populateMetadata("joints_state::velocities::measured", m_robotControlHelper->getAxesList());
-        m_vectorsCollectionServer.populateMetadata("joints_state::velocities::retargeting", m_robotControlHelper->getAxesList());
+        ok = ok && m_logger.addChannel("joints_state::positions::measured", m_robotControlHelper->getAxesList());
+        ok = ok && m_logger.addChannel("joints_state::positions::desired", m_robotControlHelper->getAxesList());
+        ok = ok && m_logger.addChannel("joints_state::positions::retargeting", m_robotControlHelper->getAxesList());
+        ok = ok && m_logger.addChannel("joints_state::positions::retargeting_raw", m_robotControlHelper->getAxesList());
+        ok = ok && m_logger.addChannel("joints_state::velocities::measured", m_robotControlHelper->getAxesList());
+        ok = ok && m_logger.addChannel("joints_state::velocities::retargeting", m_robotControlHelper->getAxesList());
 
         // root link information
-        m_vectorsCollectionServer.populateMetadata("root_link::position::measured", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("root_link::orientation::measured", {"roll", "pitch", "yaw"});
-        m_vectorsCollectionServer.populateMetadata("root_link::linear_velocity::measured", {"x", "y", "z"});
-        m_vectorsCollectionServer.populateMetadata("root_link::angular_velocity::measured", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("root_link::position::measured", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("root_link::orientation::measured", {"roll", "pitch", "yaw"}, AsyncLogger::ChannelType::Rotation);
+        ok = ok && m_logger.addChannel("root_link::linear_velocity::measured", {"x", "y", "z"});
+        ok = ok && m_logger.addChannel("root_link::angular_velocity::measured", {"x", "y", "z"});
 
         // collect the stance foot information
-        m_vectorsCollectionServer.populateMetadata("stance_foot::is_left", {"scalar"});
+        ok = ok && m_logger.addChannel("stance_foot::is_left", {"scalar"});
+
+        if (!ok || !m_logger.start())
+        {
+            yError() << "[WalkingModule::configure] Unable to start the logger.";
+            return false;
+        }
+    }
+
+    // channels of the records of the controller inputs. The channels are added in the same
+    // order of the InputChannel enum
+    const std::vector<std::string>& axesList = m_robotControlHelper->getAxesList();
+    const std::vector<std::string> wrenchMetadata{"fx", "fy", "fz", "tx", "ty", "tz"};
+    addInputChannel("module::state", {"state"});
+    addInputChannel("robot::joints_state::positions", axesList);
+    addInputChannel("robot::joints_state::velocities", axesList);
+    addInputChannel("robot::left_foot::wrench", wrenchMetadata);
+    addInputChannel("robot::right_foot::wrench", wrenchMetadata);
+    addInputChannel("robot::base::position", {"x", "y", "z"});
+    addInputChannel("robot::base::orientation", {"roll", "pitch", "yaw"}, LoggedChannelType::Rotation);
+    addInputChannel("robot::base::twist", {"vx", "vy", "vz", "wx", "wy", "wz"});
+    addInputChannel("retargeting::left_hand::position", {"x", "y", "z"});
+    addInputChannel("retargeting::left_hand::orientation", {"roll", "pitch", "yaw"}, LoggedChannelType::Rotation);
+    addInputChannel("retargeting::right_hand::position", {"x", "y", "z"});
+    addInputChannel("retargeting::right_hand::orientation", {"roll", "pitch", "yaw"}, LoggedChannelType::Rotation);
+    addInputChannel("retargeting::joints_state::positions", axesList);
+    addInputChannel("retargeting::joints_state::velocities", axesList);
+    addInputChannel("retargeting::joints_state::raw_positions", axesList);
+    addInputChannel("retargeting::com_height", {"position", "velocity"});
+    addInputChannel("goal::size", {"scalar"});
+    addInputChannel("goal::input", {"input_0", "input_1", "input_2"});
+    m_receivedGoal.resize(m_inputChannels[GoalInput].size);
+    m_replayedGoal.resize(m_inputChannels[GoalInput].size);
+
+    // the inputs are stored in a flight recorder file, hence they can be converted with the
+    // WalkingFlightRecorderConverter
+    const std::string inputRecorderPrefix = rf.check("input_recorder_prefix", yarp::os::Value("")).asString();
+    if (!inputRecorderPrefix.empty())
+    {
+        const int chunkSize = rf.check("input_recorder_chunk_size", yarp::os::Value(10000)).asInt32();
+        if (chunkSize <= 0)
+        {
+            yError() << "[WalkingModule::configure] input_recorder_chunk_size is supposed to be a positive number.";
+            return false;
+        }
+
+        char timeString[32];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(timeString, sizeof(timeString), "%Y_%m_%d_%H_%M_%S", std::localtime(&now));
+        const std::string inputRecorderFileName = inputRecorderPrefix + "_" + timeString + ".wcfr";
+        if (!m_inputRecorder.open(inputRecorderFileName, m_inputChannels, m_inputRecordSize,
+                                  static_cast<size_t>(chunkSize)))
+        {
+            yError() << "[WalkingModule::configure] Unable to open the input recorder.";
+            return false;
+        }
+        m_recordInputs = true;
+        yInfo() << "[WalkingModule::configure] The inputs of the controller are recorded in" << inputRecorderFileName;
+    }
+
+    // stage profiler. The stages are added in the same order of the ProfiledStage enum
+    for (const auto& stage : {"total", "planner", "feedback", "fk", "cop", "dcm_controller",
+                              "zmp_controller", "ik", "command", "transforms", "logger"})
+        m_stageProfiler.addStage(stage);
+
+    const double stageProfilerPeriod = rf.check("stage_profiler_period", yarp::os::Value(1.0)).asFloat64();
+    if (stageProfilerPeriod < 0)
+    {
+        yError() << "[WalkingModule::configure] stage_profiler_period is supposed to be non negative.";
+        return false;
+    }
+    m_stageProfilerPeriod = static_cast<size_t>(std::round(stageProfilerPeriod / m_dT));
+    if (m_stageProfilerPeriod > 0)
+    {
+        std::string stageProfilerPortName = "/" + getName() + "/profiler:o";
+        if (!m_stageProfilerPort.open(stageProfilerPortName))
+        {
+            yError() << "[WalkingModule::configure] Could not open" << stageProfilerPortName << " port.";
+            return false;
+        }
+    }
+
+    // heap allocations in the walking state. The allocations are counted only if the module is
+    // compiled with WALKING_CONTROLLERS_TRACK_ALLOCATIONS
+    const std::string allocationPolicy = rf.check("allocation_tracker_policy", yarp::os::Value("count")).asString();
+    if (allocationPolicy == "count")
+        StdUtilities::AllocationTracker::setPolicy(StdUtilities::AllocationTracker::Policy::Count);
+    else if (allocationPolicy == "log")
+        StdUtilities::AllocationTracker::setPolicy(StdUtilities::AllocationTracker::Policy::Log);
+    else if (allocationPolicy == "abort")
+        StdUtilities::AllocationTracker::setPolicy(StdUtilities::AllocationTracker::Policy::Abort);
+    else
+    {
+        yError() << "[WalkingModule::configure] allocation_tracker_policy is supposed to be count, log or abort.";
+        return false;
+    }
+    m_forbidAllocationsWhileWalking = allocationPolicy != "count";
+    if (m_forbidAllocationsWhileWalking && !StdUtilities::AllocationTracker::isEnabled())
+        yWarning() << "[WalkingModule::configure] The module is compiled without WALKING_CONTROLLERS_TRACK_ALLOCATIONS."
+                   << "The allocations will not be checked.";
+
+    // memory of the temporaries of the control loop (e.g. the new trajectories). It is reset at
+    // each tick, if it is full the memory is taken from the heap and the overflow is reported
+    const int tickArenaSize = rf.check("tick_arena_size", yarp::os::Value(131072)).asInt32();
+    if (tickArenaSize < 0)
+    {
+        yError() << "[WalkingModule::configure] tick_arena_size is supposed to be non negative.";
+        return false;
+    }
+    m_tickArena.reserve(static_cast<std::size_t>(tickArenaSize));
+
+    // tasks evaluated at each tick. If task_graph_workers is greater than zero the independent
+    // tasks are executed concurrently
+    bool ok = m_feedbackTasks.addTask("robot_feedback", [this] {
+        return m_robotControlHelper->getFeedbacks(m_feedbackAttempts, m_feedbackAttemptDelay);
+    });
+    ok = ok && m_feedbackTasks.addTask("retargeting_feedback", [this] {
+        auto retargetingPhase = m_isStancePhase.front() ? RetargetingClient::Phase::Stance : RetargetingClient::Phase::Walking;
+        m_retargetingClient->setPhase(retargetingPhase);
+        return m_retargetingClient->getFeedback();
+    });
+
+    // the transforms and the logged data are published while the joint references are sent to
+    // the robot. The two tasks access the kinDynComputations object so they are run serially
+    ok = ok && m_publishTasks.addTask("transforms", [this] {
+        if (m_deadlineWatchdog.getLevel() >= NoTransformsLevel)
+            return true;
+
+        auto timer = m_stageProfiler.scopedTimer(TransformsStage);
+        publishTransforms();
+        return true;
+    });
+    if (m_dumpData)
+    {
+        ok = ok && m_publishTasks.addTask("logger", [this] {
+            if (m_deadlineWatchdog.getLevel() >= NoLoggingLevel)
+                return true;
+
+            auto timer = m_stageProfiler.scopedTimer(LoggerStage);
+            sendLoggerData();
+            return true;
+        }, {"transforms"});
+    }
+    if (m_stageProfilerPeriod > 0)
+    {
+        ok = ok && m_publishTasks.addTask("stage_profiler", [this] {
+            publishStageProfiler();
+            return true;
+        });
+    }
+
+    const int taskGraphWorkers = rf.check("task_graph_workers", yarp::os::Value(0)).asInt32();
+    std::vector<int> taskGraphCores;
+    yarp::os::Value* taskGraphCoresValue;
+    if (rf.check("task_graph_cores", taskGraphCoresValue) && taskGraphCoresValue->isList())
+    {
+        for (size_t i = 0; i < taskGraphCoresValue->asList()->size(); i++)
+            taskGraphCores.push_back(taskGraphCoresValue->asList()->get(i).asInt32());
+    }
+
+    if (taskGraphWorkers < 0)
+    {
+        yError() << "[WalkingModule::configure] task_graph_workers is supposed to be non negative.";
+        return false;
+    }
 
-        m_vectorsCollectionServer.finalizeMetadata();
+    ok = ok && m_feedbackTasks.initialize(taskGraphWorkers, taskGraphCores);
+    ok = ok && m_publishTasks.initialize(taskGraphWorkers, taskGraphCores);
+    if (!ok)
+    {
+        yError() << "[WalkingModule::configure] Unable to initialize the task graphs.";
+        return false;
     }
 
     // time profiler
@@ -481,9 +747,45 @@ void WalkingModule::reset()
     if (m_useMPC)
         m_walkingController->reset();
 
+    if (m_useQPIK)
+        m_BLFIKSolver->reset();
+
     m_trajectoryGenerator->reset();
 }
 
+iDynTree::Vector2 WalkingModule::getDCMControllerOutput() const
+{
+    iDynTree::Vector2 desiredZMP;
+    if (m_useSimplifiedModelPipeline)
+        iDynTree::toEigen(desiredZMP) = m_simplifiedModelPipeline->getDesiredZMP();
+    else if (m_useMPC && !m_mpcDegraded)
+        desiredZMP = m_walkingController->getControllerOutput();
+    else
+        desiredZMP = m_walkingDCMReactiveController->getControllerOutput();
+
+    return desiredZMP;
+}
+
+iDynTree::Vector2 WalkingModule::getLIPMCoMPosition() const
+{
+    if (!m_useSimplifiedModelPipeline)
+        return m_stableDCMModel->getCoMPosition();
+
+    iDynTree::Vector2 comPosition;
+    iDynTree::toEigen(comPosition) = m_simplifiedModelPipeline->getLIPMCoMPosition();
+    return comPosition;
+}
+
+iDynTree::Vector2 WalkingModule::getLIPMCoMVelocity() const
+{
+    if (!m_useSimplifiedModelPipeline)
+        return m_stableDCMModel->getCoMVelocity();
+
+    iDynTree::Vector2 comVelocity;
+    iDynTree::toEigen(comVelocity) = m_simplifiedModelPipeline->getLIPMCoMVelocity();
+    return comVelocity;
+}
+
 void WalkingModule::applyGoalScaling(yarp::sig::Vector &plannerInput)
 {
     for (size_t i = 0; i < std::min(plannerInput.size(), m_goalScaling.size()); ++i)
@@ -500,9 +802,31 @@ bool WalkingModule::close()
     // close retargeting ports
     m_retargetingClient->close();
 
+    // send the remaining logged data and stop the logger. In trigger mode the last seconds
+    // before the module is closed (e.g. because of an error) are sent
+    if (m_dumpData)
+    {
+        if (m_logger.isTriggerModeEnabled())
+        {
+            m_logger.trigger();
+        }
+        m_logger.close();
+    }
+
+    // close the input recorder
+    if (m_inputRecorder.getNumberOfRecords() > 0)
+        yInfo() << "[WalkingModule::close]" << m_inputRecorder.getNumberOfRecords() << "input records stored.";
+    m_inputRecorder.close();
+    m_recordInputs = false;
+
+    if (StdUtilities::AllocationTracker::isEnabled())
+        yInfo() << "[WalkingModule::close]" << StdUtilities::AllocationTracker::getViolations()
+                << "heap allocations while walking.";
+
     // close the ports
     m_rpcPort.close();
     m_desiredUnyciclePositionPort.close();
+    m_stageProfilerPort.close();
 
     // close the connection with robot
     if (!m_robotControlHelper->close())
@@ -518,6 +842,7 @@ bool WalkingModule::close()
     m_IKSolver.reset(nullptr);
     m_FKSolver.reset(nullptr);
     m_stableDCMModel.reset(nullptr);
+    m_simplifiedModelPipeline.reset(nullptr);
     m_transformHelper.reset(nullptr);
 
     return true;
@@ -585,6 +910,14 @@ bool WalkingModule::updateModule()
 {
     std::lock_guard<std::mutex> guard(m_mutex);
 
+    // the temporaries of the previous tick are released
+    m_tickArena.reset();
+
+    // the inputs are read only while preparing and walking. In the other states only the state
+    // of the module is meaningful
+    if (m_recordInputs && m_robotState != WalkingFSM::Preparing && m_robotState != WalkingFSM::Walking)
+        recordInputs();
+
     if (m_robotState == WalkingFSM::Preparing)
     {
         if (!m_robotControlHelper->getFeedbacksRaw(m_feedbackAttempts, m_feedbackAttemptDelay))
@@ -593,6 +926,9 @@ bool WalkingModule::updateModule()
             return false;
         }
 
+        if (m_recordInputs)
+            recordInputs();
+
         bool motionDone = false;
         if (!m_robotControlHelper->checkMotionDone(motionDone))
         {
@@ -615,21 +951,32 @@ bool WalkingModule::updateModule()
                 return true;
             }
 
-            yarp::sig::Vector buffer(m_qDesired.size());
-            iDynTree::toYarp(m_qDesired, buffer);
-            // instantiate Integrator object
-
-            yarp::sig::Matrix jointLimits(m_robotControlHelper->getActuatedDoFs(), 2);
-            for (int i = 0; i < m_robotControlHelper->getActuatedDoFs(); i++)
+            // the QP-IK joint velocities are integrated within the joint limits
+            bool ok = m_velocityIntegral.initialize(m_dT,
+                                                    iDynTree::toEigen(m_robotControlHelper->getPositionLowerLimits()),
+                                                    iDynTree::toEigen(m_robotControlHelper->getPositionUpperLimits()));
+            if (ok && m_saturateJointVelocity)
+                ok = m_velocityIntegral.setVelocityLimits(iDynTree::toEigen(m_robotControlHelper->getVelocityLimits()));
+            if (ok && m_maxJointAcceleration > 0)
+                ok = m_velocityIntegral.setAccelerationLimits(
+                    Eigen::VectorXd::Constant(m_robotControlHelper->getActuatedDoFs(), m_maxJointAcceleration));
+            if (!ok)
             {
-                jointLimits(i, 0) = m_robotControlHelper->getPositionLowerLimits()(i);
-                jointLimits(i, 1) = m_robotControlHelper->getPositionUpperLimits()(i);
+                yError() << "[WalkingModule::updateModule] Unable to initialize the joint integrator.";
+                return false;
             }
-            m_velocityIntegral = std::make_unique<iCub::ctrl::Integrator>(m_dT, buffer, jointLimits);
+            m_velocityIntegral.reset(iDynTree::toEigen(m_qDesired));
 
             // reset the models
-            m_walkingZMPController->reset(m_DCMPositionDesired.front());
-            m_stableDCMModel->reset(m_DCMPositionDesired.front());
+            if (m_useSimplifiedModelPipeline)
+            {
+                m_simplifiedModelPipeline->reset(iDynTree::toEigen(m_DCMPositionDesired.front()));
+            }
+            else
+            {
+                m_walkingZMPController->reset(m_DCMPositionDesired.front());
+                m_stableDCMModel->reset(m_DCMPositionDesired.front());
+            }
 
             // reset the retargeting
             if (!m_robotControlHelper->getFeedbacks(m_feedbackAttempts, m_feedbackAttemptDelay))
@@ -644,30 +991,25 @@ bool WalkingModule::updateModule()
                 return false;
             }
 
-            // reset the retargeting client with the desired robot data
+            // reset the retargeting client with the desired robot data. The measured state of
+            // the FK solver is not modified
             iDynTree::VectorDynSize zero(m_qDesired.size());
             zero.zero();
-            // reset the internal robot state of the kindyn object
-            if (!m_FKSolver->setInternalRobotState(m_qDesired, zero))
+            if (!m_FKSolver->setDesiredRobotState(m_qDesired, zero))
             {
                 yError() << "[WalkingModule::updateModule] Unable to set the robot state before resetting the retargeting client.";
                 return false;
             }
 
-            if (!m_retargetingClient->reset(*m_FKSolver))
+            m_FKSolver->useKinematicState(WalkingFK::KinematicState::Desired);
+            const bool retargetingReset = m_retargetingClient->reset(*m_FKSolver);
+            m_FKSolver->useKinematicState(WalkingFK::KinematicState::Measured);
+            if (!retargetingReset)
             {
                 yError() << "[WalkingModule::updateModule] Unable to reset the retargeting client.";
                 return false;
             }
 
-            // reset the internal robot state of the kindyn object
-            if (!m_FKSolver->setInternalRobotState(m_robotControlHelper->getJointPosition(),
-                                                   m_robotControlHelper->getJointVelocity()))
-            {
-                yError() << "[WalkingModule::updateModule] Unable to set the robot state after resetting the retargeting client.";
-                return false;
-            }
-
             m_firstRun = true;
 
             if (m_useRootLinkForHeight)
@@ -687,15 +1029,40 @@ bool WalkingModule::updateModule()
     }
     else if (m_robotState == WalkingFSM::Walking)
     {
+        // only the control thread is checked, the tasks run by the workers are counted by the
+        // stage profiler
+        StdUtilities::AllocationTracker::ScopedForbid noAllocation(m_forbidAllocationsWhileWalking);
+
         iDynTree::Vector2 measuredZMP;
 
         bool resetTrajectory = false;
 
         m_profiler->setInitTime("Total");
+        const auto tickBeginning = std::chrono::steady_clock::now();
+        auto totalTimer = m_stageProfiler.scopedTimer(TotalStage);
+        auto plannerTimer = m_stageProfiler.scopedTimer(PlannerStage);
 
         // check desired planner input
         yarp::sig::Vector *desiredUnicyclePosition = nullptr;
-        desiredUnicyclePosition = m_desiredUnyciclePositionPort.read(false);
+        if (m_replayInputs)
+        {
+            // the goal was set by setReplayedInputs(). It is copied in a buffer allocated by
+            // configure() since the scaling is applied in place
+            if (m_isGoalReceived)
+            {
+                m_replayedGoal.resize(m_receivedGoal.size());
+                std::copy_n(m_receivedGoal.data(), m_receivedGoal.size(), m_replayedGoal.data());
+                desiredUnicyclePosition = &m_replayedGoal;
+            }
+        }
+        else
+        {
+            desiredUnicyclePosition = m_desiredUnyciclePositionPort.read(false);
+            m_isGoalReceived = desiredUnicyclePosition != nullptr;
+            if (m_isGoalReceived && m_recordInputs)
+                m_receivedGoal = *desiredUnicyclePosition;
+        }
+
         if (desiredUnicyclePosition != nullptr)
         {
             applyGoalScaling(*desiredUnicyclePosition);
@@ -741,7 +1108,17 @@ bool WalkingModule::updateModule()
 
             if (m_newTrajectoryMergeCounter == 2)
             {
-                if (!updateTrajectories(m_newTrajectoryMergeCounter))
+                // with the kinematic plant the time is simulated and it may run faster than the
+                // planner thread, so the trajectory is awaited through the delay of the clock
+                if (m_robotControlHelper->isKinematicPlantUsed())
+                {
+                    const double waitStep = 1e-4;
+                    for (double waited = 0; waited < 1.0 && !m_trajectoryGenerator->isTrajectoryComputed();
+                         waited += waitStep)
+                        yarp::os::Time::delay(waitStep);
+                }
+
+                if (!updateTrajectories(m_newTrajectoryMergeCounter, &m_tickArena))
                 {
                     yError() << "[WalkingModule::updateModule] Error while updating trajectories. They were not computed yet.";
                     return false;
@@ -752,6 +1129,7 @@ bool WalkingModule::updateModule()
 
             m_newTrajectoryMergeCounter--;
         }
+        plannerTimer.stop();
 
         if (m_robotControlHelper->getPIDHandler().usingGainScheduling())
         {
@@ -763,32 +1141,31 @@ bool WalkingModule::updateModule()
         }
 
         m_profiler->setInitTime("Feedback");
+        auto feedbackTimer = m_stageProfiler.scopedTimer(FeedbackStage);
 
-        // get feedbacks and evaluate useful quantities
-        if (!m_robotControlHelper->getFeedbacks(m_feedbackAttempts, m_feedbackAttemptDelay))
+        // get the feedbacks from the robot and from the retargeting client
+        if (!m_feedbackTasks.run())
         {
             yError() << "[WalkingModule::updateModule] Unable to get the feedback.";
             return false;
         }
 
+        feedbackTimer.stop();
         m_profiler->setEndTime("Feedback");
 
-        auto retargetingPhase = m_isStancePhase.front() ? RetargetingClient::Phase::Stance : RetargetingClient::Phase::Walking;
-        m_retargetingClient->setPhase(retargetingPhase);
-
-        if (!m_retargetingClient->getFeedback())
-        {
-            yError() << "[WalkingModule::updateModule] Unable to get the feedback from the retargeting client.";
-            return false;
-        }
+        if (m_recordInputs)
+            recordInputs();
 
+        auto fkTimer = m_stageProfiler.scopedTimer(FKStage);
         if (!updateFKSolver())
         {
             yError() << "[WalkingModule::updateModule] Unable to update the FK solver.";
             return false;
         }
+        fkTimer.stop();
 
         // compute the global CoP
+        auto copTimer = m_stageProfiler.scopedTimer(CoPStage);
         if (!computeGlobalCoP(iDynTree::toEigen(measuredZMP)))
         {
             yError() << "[WalkingModule::updateModule] Unable to compute the global CoP.";
@@ -803,100 +1180,116 @@ bool WalkingModule::updateModule()
             m_zmpOffset = yawRotation * m_zmpOffsetLocal;
             iDynTree::toEigen(measuredZMP) += iDynTree::toEigen(m_zmpOffset).head<2>();
         }
+        copTimer.stop();
 
-        // evaluate 3D-LIPM reference signal
-        m_stableDCMModel->setInput(m_DCMPositionDesired.front());
-        if (!m_stableDCMModel->integrateModel())
+        iDynTree::Vector2 desiredZMP;
+        iDynTree::Vector2 outputZMPCoMControllerPosition, outputZMPCoMControllerVelocity;
+        auto dcmControllerTimer = m_stageProfiler.scopedTimer(DCMControllerStage);
+        if (m_useSimplifiedModelPipeline)
         {
-            yError() << "[WalkingModule::updateModule] Unable to propagate the 3D-LIPM.";
-            return false;
-        }
+            // 3D-LIPM, DCM controller and ZMP-CoM controller
+            m_simplifiedModelPipeline->integrateReference(iDynTree::toEigen(m_DCMPositionDesired.front()));
+            m_simplifiedModelPipeline->evaluateDCMControl(iDynTree::toEigen(m_DCMPositionDesired.front()),
+                                                          iDynTree::toEigen(m_DCMVelocityDesired.front()),
+                                                          iDynTree::toEigen(m_FKSolver->getDCM()));
+
+            if (m_skipDCMController)
+                desiredZMP = m_desiredZMP.front();
+            else
+                iDynTree::toEigen(desiredZMP) = m_simplifiedModelPipeline->getDesiredZMP();
+            dcmControllerTimer.stop();
+
+            auto zmpControllerTimer = m_stageProfiler.scopedTimer(ZMPControllerStage);
+            m_simplifiedModelPipeline->evaluateZMPControl(m_isStancePhase.front(),
+                                                          iDynTree::toEigen(desiredZMP),
+                                                          iDynTree::toEigen(measuredZMP),
+                                                          iDynTree::toEigen(m_FKSolver->getCoMPosition()));
 
-        // DCM controller
-        if (m_useMPC)
+            iDynTree::toEigen(outputZMPCoMControllerPosition) = m_simplifiedModelPipeline->getDesiredCoMPosition();
+            iDynTree::toEigen(outputZMPCoMControllerVelocity) = m_simplifiedModelPipeline->getDesiredCoMVelocity();
+        }
+        else
         {
-            // Model predictive controller
-            m_profiler->setInitTime("MPC");
-            if (!m_walkingController->setConvexHullConstraint(m_leftTrajectory, m_rightTrajectory,
-                                                              m_leftInContact, m_rightInContact))
+            // evaluate 3D-LIPM reference signal
+            m_stableDCMModel->setInput(m_DCMPositionDesired.front());
+            if (!m_stableDCMModel->integrateModel())
             {
-                yError() << "[WalkingModule::updateModule] unable to evaluate the convex hull.";
+                yError() << "[WalkingModule::updateModule] Unable to propagate the 3D-LIPM.";
                 return false;
             }
 
-            if (!m_walkingController->setFeedback(m_FKSolver->getDCM()))
+            // DCM controller
+            if (m_useMPC && !m_mpcDegraded)
             {
-                yError() << "[WalkingModule::updateModule] unable to set the feedback.";
-                return false;
+                // Model predictive controller (if mpc_sampling_time is greater than the
+                // sampling_time the problem is solved in a separate thread and the output is interpolated)
+                m_profiler->setInitTime("MPC");
+                if (!m_walkingController->setInput(m_leftTrajectory, m_rightTrajectory,
+                                                   m_leftInContact, m_rightInContact,
+                                                   m_FKSolver->getDCM(), m_DCMPositionDesired,
+                                                   resetTrajectory))
+                {
+                    yError() << "[WalkingModule::updateModule] Unable to evaluate the MPC output.";
+                    return false;
+                }
+                m_profiler->setEndTime("MPC");
             }
-
-            if (!m_walkingController->setReferenceSignal(m_DCMPositionDesired, resetTrajectory))
+            else
             {
-                yError() << "[WalkingModule::updateModule] unable to set the reference Signal.";
-                return false;
-            }
+                m_walkingDCMReactiveController->setFeedback(m_FKSolver->getDCM());
+                m_walkingDCMReactiveController->setReferenceSignal(m_DCMPositionDesired.front(),
+                                                                   m_DCMVelocityDesired.front());
 
-            if (!m_walkingController->solve())
-            {
-                yError() << "[WalkingModule::updateModule] Unable to solve the problem.";
-                return false;
+                if (!m_walkingDCMReactiveController->evaluateControl())
+                {
+                    yError() << "[WalkingModule::updateModule] Unable to evaluate the DCM control output.";
+                    return false;
+                }
             }
 
-            m_profiler->setEndTime("MPC");
-        }
-        else
-        {
-            m_walkingDCMReactiveController->setFeedback(m_FKSolver->getDCM());
-            m_walkingDCMReactiveController->setReferenceSignal(m_DCMPositionDesired.front(),
-                                                               m_DCMVelocityDesired.front());
+            dcmControllerTimer.stop();
 
-            if (!m_walkingDCMReactiveController->evaluateControl())
+            // inner COM-ZMP controller
+            // if the the norm of desired DCM velocity is lower than a threshold then the robot
+            // is stopped
+            auto zmpControllerTimer = m_stageProfiler.scopedTimer(ZMPControllerStage);
+            m_walkingZMPController->setPhase(m_isStancePhase.front());
+
+            if (m_skipDCMController)
             {
-                yError() << "[WalkingModule::updateModule] Unable to evaluate the DCM control output.";
-                return false;
+                desiredZMP = m_desiredZMP.front();
             }
-        }
-
-        // inner COM-ZMP controller
-        // if the the norm of desired DCM velocity is lower than a threshold then the robot
-        // is stopped
-        m_walkingZMPController->setPhase(m_isStancePhase.front());
-
-        iDynTree::Vector2 desiredZMP;
-        if (m_skipDCMController)
-        {
-            desiredZMP = m_desiredZMP.front();
-        }
-        else
-        {
-            if (m_useMPC)
-                desiredZMP = m_walkingController->getControllerOutput();
             else
-                desiredZMP = m_walkingDCMReactiveController->getControllerOutput();
-        }
+            {
+                if (m_useMPC && !m_mpcDegraded)
+                    desiredZMP = m_walkingController->getControllerOutput();
+                else
+                    desiredZMP = m_walkingDCMReactiveController->getControllerOutput();
+            }
 
-        // set feedback and the desired signal
+            // set feedback and the desired signal
 
-        m_walkingZMPController->setFeedback(measuredZMP, m_FKSolver->getCoMPosition());
-        m_walkingZMPController->setReferenceSignal(desiredZMP, m_stableDCMModel->getCoMPosition(),
-                                                   m_stableDCMModel->getCoMVelocity());
+            m_walkingZMPController->setFeedback(measuredZMP, m_FKSolver->getCoMPosition());
+            m_walkingZMPController->setReferenceSignal(desiredZMP, m_stableDCMModel->getCoMPosition(),
+                                                       m_stableDCMModel->getCoMVelocity());
 
-        if (!m_walkingZMPController->evaluateControl())
-        {
-            yError() << "[WalkingModule::updateModule] Unable to evaluate the ZMP control output.";
-            return false;
-        }
+            if (!m_walkingZMPController->evaluateControl())
+            {
+                yError() << "[WalkingModule::updateModule] Unable to evaluate the ZMP control output.";
+                return false;
+            }
 
-        iDynTree::Vector2 outputZMPCoMControllerPosition, outputZMPCoMControllerVelocity;
-        if (!m_walkingZMPController->getControllerOutput(outputZMPCoMControllerPosition,
-                                                         outputZMPCoMControllerVelocity))
-        {
-            yError() << "[WalkingModule::updateModule] Unable to get the ZMP controller output.";
-            return false;
+            if (!m_walkingZMPController->getControllerOutput(outputZMPCoMControllerPosition,
+                                                             outputZMPCoMControllerVelocity))
+            {
+                yError() << "[WalkingModule::updateModule] Unable to get the ZMP controller output.";
+                return false;
+            }
         }
 
         // inverse kinematics
         m_profiler->setInitTime("IK");
+        auto ikTimer = m_stageProfiler.scopedTimer(IKStage);
 
         iDynTree::Position desiredCoMPosition;
         desiredCoMPosition(0) = outputZMPCoMControllerPosition(0);
@@ -919,8 +1312,8 @@ bool WalkingModule::updateModule()
                          << "ZMP measured: " << measuredZMP.toString()
                          << "Desired ZMP" << desiredZMP.toString()
                          << "measured com position" << m_FKSolver->getCoMPosition().toString()
-                         << "desired com position" << m_stableDCMModel->getCoMPosition().toString()
-                         << "desired com velocity" << m_stableDCMModel->getCoMVelocity().toString();
+                         << "desired com position" << getLIPMCoMPosition().toString()
+                         << "desired com velocity" << getLIPMCoMVelocity().toString();
                 return false;
             }
         }
@@ -934,13 +1327,12 @@ bool WalkingModule::updateModule()
 
         if (m_useQPIK)
         {
-            // integrate dq because velocity control mode seems not available
-            yarp::sig::Vector bufferVelocity(m_robotControlHelper->getActuatedDoFs());
-            yarp::sig::Vector bufferPosition(m_robotControlHelper->getActuatedDoFs());
-
-            if (!m_FKSolver->setInternalRobotState(m_qDesired, m_dqDesired))
+            // the QP-IK uses the desired state, the measured one remains cached. If ik_sampling_time
+            // is greater than the sampling_time the problem is solved in a separate thread and the
+            // joint velocities are interpolated
+            if (!m_FKSolver->setDesiredRobotState(m_qDesired, m_dqDesired))
             {
-                yError() << "[WalkingModule::updateModule] Unable to set the internal robot state.";
+                yError() << "[WalkingModule::updateModule] Unable to set the desired robot state.";
                 return false;
             }
 
@@ -956,17 +1348,8 @@ bool WalkingModule::updateModule()
                 return false;
             }
 
-            iDynTree::toYarp(m_dqDesired, bufferVelocity);
-
-            bufferPosition = m_velocityIntegral->integrate(bufferVelocity);
-            iDynTree::toiDynTree(bufferPosition, m_qDesired);
-
-            if (!m_FKSolver->setInternalRobotState(m_robotControlHelper->getJointPosition(),
-                                                   m_robotControlHelper->getJointVelocity()))
-            {
-                yError() << "[WalkingModule::updateModule] Unable to set the internal robot state.";
-                return false;
-            }
+            // integrate dq because velocity control mode seems not available
+            iDynTree::toEigen(m_qDesired) = m_velocityIntegral.integrate(iDynTree::toEigen(m_dqDesired));
         }
         else
         {
@@ -992,155 +1375,36 @@ bool WalkingModule::updateModule()
                 }
             }
         }
+        ikTimer.stop();
         m_profiler->setEndTime("IK");
 
-        if (m_transformHelper)
-        {
-            if (!m_transformHelper->setBaseTransform(m_FKSolver->getRootLinkToWorldTransform()))
-            {
-                yWarning() << "[WalkingModule::updateModule] Unable to publish the base transform.";
-            }
+        // publish the transforms and send the data to the logger while the joint references are set
+        m_loggedMeasuredZMP = measuredZMP;
+        m_loggedDesiredCoMPosition = desiredCoMPosition;
 
-            if (!m_transformHelper->setJoystickTransform(m_trajectoryGenerator->getUnicyclePose()))
-            {
-                yWarning() << "[WalkingModule::updateModule] Unable to publish the joystick transform.";
-            }
-
-            auto kinDynPointer = m_FKSolver->getKinDyn();
-
-            for (const auto& frame : m_framesToStream)
-            {
-                if (!m_transformHelper->setTransform(frame.second, kinDynPointer->getWorldTransform(frame.first)))
-                {
-                    yWarning() << "[WalkingModule::updateModule] Unable to publish the transform of" << frame.second;
-                }
-            }
+        // the tasks only read the transforms of the frame set
+        m_FKSolver->evaluateFrameSet();
+        if (!m_publishTasks.start())
+        {
+            yError() << "[WalkingModule::updateModule] Unable to start the publishing tasks.";
+            return false;
         }
 
+        auto commandTimer = m_stageProfiler.scopedTimer(CommandStage);
         if (!m_robotControlHelper->setDirectPositionReferences(m_qDesired))
         {
             yError() << "[WalkingModule::updateModule] Error while setting the reference position to iCub.";
+            m_publishTasks.wait();
             return false;
         }
+        commandTimer.stop();
 
-        // send data to the logger
-        if (m_dumpData)
+        if (!m_publishTasks.wait())
         {
-            iDynTree::Vector2 desiredZMP;
-            if (m_useMPC)
-                desiredZMP = m_walkingController->getControllerOutput();
-            else
-                desiredZMP = m_walkingDCMReactiveController->getControllerOutput();
-
-            iDynTree::Vector3 measuredCoM = m_FKSolver->getCoMPosition();
-
-            if (m_useRootLinkForHeight)
-            {
-                measuredCoM(2) = m_FKSolver->getRootLinkToWorldTransform().getPosition()(2);
-            }
-
-            auto leftFoot = m_FKSolver->getLeftFootToWorldTransform();
-            auto rightFoot = m_FKSolver->getRightFootToWorldTransform();
-
-            m_vectorsCollectionServer.prepareData();
-            m_vectorsCollectionServer.clearData();
-
-            // DCM
-            m_vectorsCollectionServer.populateData("dcm::position::measured", m_FKSolver->getDCM());
-            m_vectorsCollectionServer.populateData("dcm::position::desired", m_DCMPositionDesired.front());
-            m_vectorsCollectionServer.populateData("dcm::velocity::desired", m_DCMVelocityDesired.front());
-
-            // ZMP
-            m_vectorsCollectionServer.populateData("zmp::measured", measuredZMP);
-            m_vectorsCollectionServer.populateData("zmp::desired", desiredZMP);
-
-            // "zmp_des_planner_x", "zmp_des_planner_y",
-            const iDynTree::Vector2 &desiredZMPPlanner = m_desiredZMP.front();
-            m_vectorsCollectionServer.populateData("zmp::desired_planner", desiredZMPPlanner);
-
-            // COM
-            m_vectorsCollectionServer.populateData("com::position::measured", measuredCoM);
-
-            // Manual definition of this value to add also the planned CoM height
-            std::vector<double> CoMPositionDesired(3);
-            CoMPositionDesired[0] = m_stableDCMModel->getCoMPosition().data()[0];
-            CoMPositionDesired[1] = m_stableDCMModel->getCoMPosition().data()[1];
-            CoMPositionDesired[2] = m_retargetingClient->comHeight() + m_comHeightOffset;
-
-            m_vectorsCollectionServer.populateData("com::position::desired", CoMPositionDesired);
-            m_vectorsCollectionServer.populateData("com::position::CoM_ZMP_controller", desiredCoMPosition);
-
-            // Manual definition of this value to add also the planned CoM height velocity
-            std::vector<double> CoMVelocityDesired(3);
-            CoMVelocityDesired[0] = m_stableDCMModel->getCoMVelocity().data()[0];
-            CoMVelocityDesired[1] = m_stableDCMModel->getCoMVelocity().data()[1];
-            CoMVelocityDesired[2] = m_retargetingClient->comHeightVelocity();
-
-            m_vectorsCollectionServer.populateData("com::velocity::desired", CoMVelocityDesired);
-
-            // Left foot position
-            m_vectorsCollectionServer.populateData("left_foot::position::measured", leftFoot.getPosition());
-            m_vectorsCollectionServer.populateData("left_foot::position::desired", m_leftTrajectory.front().getPosition());
-
-            // Left foot orientation
-            const iDynTree::Vector3 leftFootOrientationMeasured = leftFoot.getRotation().asRPY();
-            m_vectorsCollectionServer.populateData("left_foot::orientation::measured", leftFootOrientationMeasured);
-
-            const iDynTree::Vector3 leftFootOrientationDesired = m_leftTrajectory.front().getRotation().asRPY();
-            m_vectorsCollectionServer.populateData("left_foot::orientation::desired", leftFootOrientationDesired);
-
-            // "lf_des_dx", "lf_des_dy", "lf_des_dz",
-            // "lf_des_droll", "lf_des_dpitch", "lf_des_dyaw",
-            m_vectorsCollectionServer.populateData("left_foot::linear_velocity::desired", m_leftTwistTrajectory.front().getLinearVec3());
-            m_vectorsCollectionServer.populateData("left_foot::angular_velocity::desired", m_leftTwistTrajectory.front().getAngularVec3());
-
-            // "lf_force_x", "lf_force_y", "lf_force_z",
-            // "lf_force_roll", "lf_force_pitch", "lf_force_yaw",
-            m_vectorsCollectionServer.populateData("left_foot::linear_force::measured", m_robotControlHelper->getLeftWrench().getLinearVec3());
-            m_vectorsCollectionServer.populateData("left_foot::angular_torque::measured", m_robotControlHelper->getLeftWrench().getAngularVec3());
-
-            // Right foot position
-            m_vectorsCollectionServer.populateData("right_foot::position::measured", rightFoot.getPosition());
-            m_vectorsCollectionServer.populateData("right_foot::position::desired", m_rightTrajectory.front().getPosition());
-
-            // Right foot orientation
-            const iDynTree::Vector3 rightFootOrientationMeasured = rightFoot.getRotation().asRPY();
-            m_vectorsCollectionServer.populateData("right_foot::orientation::measured", rightFootOrientationMeasured);
-            const iDynTree::Vector3 rightFootOrientationDesired = m_rightTrajectory.front().getRotation().asRPY();
-            m_vectorsCollectionServer.populateData("right_foot::orientation::desired", rightFootOrientationDesired);
-
-            // "rf_des_dx", "rf_des_dy", "rf_des_dz",
-            // "rf_des_droll", "rf_des_dpitch", "rf_des_dyaw",
-            m_vectorsCollectionServer.populateData("right_foot::linear_velocity::desired", m_rightTwistTrajectory.front().getLinearVec3());
-            m_vectorsCollectionServer.populateData("right_foot::angular_velocity::desired", m_rightTwistTrajectory.front().getAngularVec3());
-
-            // "rf_force_x", "rf_force_y", "rf_force_z",
-            // "rf_force_roll", "rf_force_pitch", "rf_force_yaw",
-            m_vectorsCollectionServer.populateData("right_foot::linear_force::measured", m_robotControlHelper->getRightWrench().getLinearVec3());
-            m_vectorsCollectionServer.populateData("right_foot::angular_torque::measured", m_robotControlHelper->getRightWrench().getAngularVec3());
-
-            // Joint
-            m_vectorsCollectionServer.populateData("joints_state::positions::measured", m_robotControlHelper->getJointPosition());
-            m_vectorsCollectionServer.populateData("joints_state::positions::desired", m_qDesired);
-            m_vectorsCollectionServer.populateData("joints_state::positions::retargeting", m_retargetingClient->jointPositions());
-            m_vectorsCollectionServer.populateData("joints_state::positions::retargeting_raw", m_retargetingClient->rawJointPositions());
-            m_vectorsCollectionServer.populateData("joints_state::velocities::measured", m_robotControlHelper->getJointVelocity());
-            m_vectorsCollectionServer.populateData("joints_state::velocities::retargeting", m_retargetingClient->jointVelocities());
-
-            // root link information
-            m_vectorsCollectionServer.populateData("root_link::position::measured", m_FKSolver->getRootLinkToWorldTransform().getPosition());
-            m_vectorsCollectionServer.populateData("root_link::orientation::measured", m_FKSolver->getRootLinkToWorldTransform().getRotation().asRPY());
-            m_vectorsCollectionServer.populateData("root_link::linear_velocity::measured", m_FKSolver->getRootLinkVelocity().getLinearVec3());
-            m_vectorsCollectionServer.populateData("root_link::angular_velocity::measured", m_FKSolver->getRootLinkVelocity().getAngularVec3());
-
-            // collect the stance foot information
-            const double isLeftFootFixed = m_isLeftFixedFrame.front() ? 1.0 : 0.0;
-            m_vectorsCollectionServer.populateData("stance_foot::is_left", std::array<double, 1>{isLeftFootFixed});
-
-            m_vectorsCollectionServer.sendData();
+            yError() << "[WalkingModule::updateModule] Unable to publish the data.";
+            return false;
         }
 
-
         propagateTime();
 
         // advance all the signals
@@ -1156,6 +1420,12 @@ bool WalkingModule::updateModule()
 
         m_firstRun = false;
 
+        if (m_useDeadlineWatchdog)
+        {
+            const std::chrono::duration<double> tickDuration = std::chrono::steady_clock::now() - tickBeginning;
+            updateDeadlineWatchdog(tickDuration.count());
+        }
+
         m_profiler->setEndTime("Total");
 
         // print timings
@@ -1166,6 +1436,276 @@ bool WalkingModule::updateModule()
     return true;
 }
 
+void WalkingModule::publishTransforms()
+{
+    if (m_transformHelper)
+    {
+        if (!m_transformHelper->setBaseTransform(m_FKSolver->getRootLinkToWorldTransform()))
+        {
+            yWarning() << "[WalkingModule::publishTransforms] Unable to publish the base transform.";
+        }
+
+        if (!m_transformHelper->setJoystickTransform(m_trajectoryGenerator->getUnicyclePose()))
+        {
+            yWarning() << "[WalkingModule::publishTransforms] Unable to publish the joystick transform.";
+        }
+
+        for (const auto& frame : m_framesToStream)
+        {
+            if (!m_transformHelper->setTransform(frame.second, m_FKSolver->getWorldTransform(frame.first)))
+            {
+                yWarning() << "[WalkingModule::publishTransforms] Unable to publish the transform of" << frame.second;
+            }
+        }
+    }
+}
+
+void WalkingModule::updateDeadlineWatchdog(const double& tickDuration)
+{
+    const size_t previousLevel = m_deadlineWatchdog.getLevel();
+    if (!m_deadlineWatchdog.update(tickDuration))
+        return;
+
+    const size_t level = m_deadlineWatchdog.getLevel();
+    yWarning() << "[WalkingModule::updateDeadlineWatchdog]" << m_deadlineWatchdog.getOverruns()
+               << "ticks overran the period. The degradation level changed from" << previousLevel
+               << "to" << level << "(last tick:" << tickDuration << "s, maximum:"
+               << m_deadlineWatchdog.getMaxDuration() << "s).";
+
+    if (previousLevel < NoLoggingLevel && level >= NoLoggingLevel && m_dumpData)
+        yWarning() << "[WalkingModule::updateDeadlineWatchdog] The data are not logged.";
+    else if (previousLevel >= NoLoggingLevel && level < NoLoggingLevel && m_dumpData)
+        yWarning() << "[WalkingModule::updateDeadlineWatchdog] The data are logged again.";
+
+    if (previousLevel < NoTransformsLevel && level >= NoTransformsLevel)
+        yWarning() << "[WalkingModule::updateDeadlineWatchdog] The transforms are not published.";
+    else if (previousLevel >= NoTransformsLevel && level < NoTransformsLevel)
+        yWarning() << "[WalkingModule::updateDeadlineWatchdog] The transforms are published again.";
+
+    // the MPC is not used until the walking is started again
+    if (level >= ReactiveControllerLevel && m_useMPC && !m_mpcDegraded)
+    {
+        m_mpcDegraded = true;
+        yWarning() << "[WalkingModule::updateDeadlineWatchdog] Switching from the MPC to the DCM reactive controller.";
+    }
+
+    if (level >= PauseLevel)
+    {
+        m_robotState = WalkingFSM::Paused;
+        yWarning() << "[WalkingModule::updateDeadlineWatchdog] The walking is paused. Call startWalking to walk again.";
+    }
+}
+
+void WalkingModule::addInputChannel(const std::string& name, const std::vector<std::string>& metadata,
+                                    const LoggedChannelType& type)
+{
+    LoggedChannel channel;
+    channel.name = name;
+    channel.metadata = metadata;
+    channel.type = type;
+    channel.offset = m_inputRecordSize;
+    channel.size = type == LoggedChannelType::Rotation ? 9 : metadata.size();
+
+    m_inputRecordSize += channel.size;
+    m_inputChannels.push_back(std::move(channel));
+}
+
+void WalkingModule::recordInputs()
+{
+    double* record = m_inputRecorder.acquire();
+    if (record == nullptr)
+    {
+        yError() << "[WalkingModule::recordInputs] Unable to write in the input recorder. The recorder is disabled.";
+        m_recordInputs = false;
+        return;
+    }
+
+    auto write = [this, record](const InputChannel& channel, const double* data,
+                                const size_t& size, const size_t& shift) {
+        std::memcpy(record + m_inputChannels[channel].offset + shift, data, size * sizeof(double));
+    };
+
+    record[0] = yarp::os::Time::now();
+    record[m_inputChannels[StateInput].offset] = static_cast<double>(m_robotState);
+
+    // robot feedback. The linear and angular parts of the iDynTree spatial vectors are not
+    // consecutive in memory
+    const size_t actuatedDoFs = m_robotControlHelper->getActuatedDoFs();
+    write(JointPositionsInput, m_robotControlHelper->getJointPosition().data(), actuatedDoFs, 0);
+    write(JointVelocitiesInput, m_robotControlHelper->getJointVelocity().data(), actuatedDoFs, 0);
+    write(LeftWrenchInput, m_robotControlHelper->getLeftWrench().getLinearVec3().data(), 3, 0);
+    write(LeftWrenchInput, m_robotControlHelper->getLeftWrench().getAngularVec3().data(), 3, 3);
+    write(RightWrenchInput, m_robotControlHelper->getRightWrench().getLinearVec3().data(), 3, 0);
+    write(RightWrenchInput, m_robotControlHelper->getRightWrench().getAngularVec3().data(), 3, 3);
+    write(BasePositionInput, m_robotControlHelper->getBaseTransform().getPosition().data(), 3, 0);
+    write(BaseOrientationInput, m_robotControlHelper->getBaseTransform().getRotation().data(), 9, 0);
+    write(BaseTwistInput, m_robotControlHelper->getBaseTwist().getLinearVec3().data(), 3, 0);
+    write(BaseTwistInput, m_robotControlHelper->getBaseTwist().getAngularVec3().data(), 3, 3);
+
+    // outputs of the retargeting client
+    write(LeftHandPositionInput, m_retargetingClient->leftHandTransform().getPosition().data(), 3, 0);
+    write(LeftHandOrientationInput, m_retargetingClient->leftHandTransform().getRotation().data(), 9, 0);
+    write(RightHandPositionInput, m_retargetingClient->rightHandTransform().getPosition().data(), 3, 0);
+    write(RightHandOrientationInput, m_retargetingClient->rightHandTransform().getRotation().data(), 9, 0);
+    write(RetargetingJointPositionsInput, m_retargetingClient->jointPositions().data(), actuatedDoFs, 0);
+    write(RetargetingJointVelocitiesInput, m_retargetingClient->jointVelocities().data(), actuatedDoFs, 0);
+    write(RetargetingRawJointPositionsInput, m_retargetingClient->rawJointPositions().data(), actuatedDoFs, 0);
+    const double comHeight[2] = {m_retargetingClient->comHeight(), m_retargetingClient->comHeightVelocity()};
+    write(CoMHeightInput, comHeight, 2, 0);
+
+    // goal received in the current tick (the elements exceeding the channel are not recorded)
+    const size_t goalSize = m_isGoalReceived ? std::min(m_receivedGoal.size(), m_inputChannels[GoalInput].size) : 0;
+    record[m_inputChannels[GoalSizeInput].offset] = static_cast<double>(goalSize);
+    std::fill_n(record + m_inputChannels[GoalInput].offset, m_inputChannels[GoalInput].size, 0.0);
+    write(GoalInput, m_receivedGoal.data(), goalSize, 0);
+    m_isGoalReceived = false;
+
+    m_inputRecorder.commit();
+}
+
+void WalkingModule::publishStageProfiler()
+{
+    if (++m_stageProfilerCounter < m_stageProfilerPeriod)
+        return;
+
+    m_stageProfilerCounter = 0;
+
+    yarp::os::Bottle& bottle = m_stageProfilerPort.prepare();
+    bottle.clear();
+    for (size_t i = 0; i < m_stageProfiler.numberOfStages(); i++)
+    {
+        const StdUtilities::StageProfiler::Statistics statistics = m_stageProfiler.getStatistics(i);
+        yarp::os::Bottle& stage = bottle.addList();
+        stage.addString(statistics.name);
+        stage.addInt64(static_cast<std::int64_t>(statistics.count));
+        stage.addFloat64(statistics.mean);
+        stage.addFloat64(statistics.p50);
+        stage.addFloat64(statistics.p99);
+        stage.addFloat64(statistics.p999);
+        stage.addFloat64(statistics.max);
+        stage.addFloat64(statistics.allocations);
+        stage.addInt64(static_cast<std::int64_t>(statistics.maxAllocations));
+    }
+
+    // the arena is not used while the data are published
+    yarp::os::Bottle& arena = bottle.addList();
+    arena.addString("tick_arena");
+    arena.addInt64(static_cast<std::int64_t>(m_tickArena.getPeakBytes()));
+    arena.addInt64(static_cast<std::int64_t>(m_tickArena.getCapacity()));
+    arena.addInt64(static_cast<std::int64_t>(m_tickArena.getOverflows()));
+
+    const WalkingIK::AccuracyStatistics& accuracy = m_IKSolver->getAccuracyStatistics();
+    yarp::os::Bottle& ikAccuracy = bottle.addList();
+    ikAccuracy.addString("ik_accuracy");
+    ikAccuracy.addInt64(static_cast<std::int64_t>(accuracy.samples));
+    ikAccuracy.addFloat64(accuracy.lastCoMError);
+    ikAccuracy.addFloat64(accuracy.maxCoMError);
+    ikAccuracy.addFloat64(accuracy.lastFootError);
+    ikAccuracy.addFloat64(accuracy.maxFootError);
+
+    if (m_BLFIKSolver)
+    {
+        const BLFIK::SolverStatistics& qpStatistics = m_BLFIKSolver->getSolverStatistics();
+        yarp::os::Bottle& qpIK = bottle.addList();
+        qpIK.addString("qp_ik");
+        qpIK.addInt64(static_cast<std::int64_t>(qpStatistics.solves));
+        qpIK.addInt64(static_cast<std::int64_t>(qpStatistics.failures));
+        qpIK.addInt64(static_cast<std::int64_t>(qpStatistics.weightUpdates));
+        qpIK.addInt64(static_cast<std::int64_t>(qpStatistics.skippedWeightUpdates));
+    }
+
+    yarp::os::Bottle& velocityLatency = bottle.addList();
+    velocityLatency.addString("joint_velocity_latency");
+    velocityLatency.addFloat64(m_robotControlHelper->getJointVelocityLatency());
+    m_stageProfilerPort.write();
+}
+
+void WalkingModule::sendLoggerData()
+{
+    // the data are copied in the ring buffer of the logger. The conversions and the YARP
+    // communication are performed by the background thread of the logger
+    if (!m_logger.beginRecord())
+    {
+        return;
+    }
+
+    const iDynTree::Vector2& desiredZMP = getDCMControllerOutput();
+
+    iDynTree::Vector3 measuredCoM = m_FKSolver->getCoMPosition();
+
+    if (m_useRootLinkForHeight)
+    {
+        measuredCoM(2) = m_FKSolver->getRootLinkToWorldTransform().getPosition()(2);
+    }
+
+    const iDynTree::Transform& leftFoot = m_FKSolver->getLeftFootToWorldTransform();
+    const iDynTree::Transform& rightFoot = m_FKSolver->getRightFootToWorldTransform();
+
+    // DCM
+    m_logger.push(m_FKSolver->getDCM());
+    m_logger.push(m_DCMPositionDesired.front());
+    m_logger.push(m_DCMVelocityDesired.front());
+
+    // ZMP
+    m_logger.push(m_loggedMeasuredZMP);
+    m_logger.push(desiredZMP);
+    m_logger.push(m_desiredZMP.front());
+
+    // COM
+    m_logger.push(measuredCoM);
+
+    // Manual definition of this value to add also the planned CoM height
+    const iDynTree::Vector2& lipmCoMPosition = getLIPMCoMPosition();
+    m_logger.push(std::array<double, 3>{lipmCoMPosition(0), lipmCoMPosition(1),
+                                        m_retargetingClient->comHeight() + m_comHeightOffset});
+    m_logger.push(m_loggedDesiredCoMPosition);
+
+    // Manual definition of this value to add also the planned CoM height velocity
+    const iDynTree::Vector2& lipmCoMVelocity = getLIPMCoMVelocity();
+    m_logger.push(std::array<double, 3>{lipmCoMVelocity(0), lipmCoMVelocity(1),
+                                        m_retargetingClient->comHeightVelocity()});
+
+    // Left foot
+    m_logger.push(leftFoot.getPosition());
+    m_logger.push(m_leftTrajectory.front().getPosition());
+    m_logger.push(leftFoot.getRotation());
+    m_logger.push(m_leftTrajectory.front().getRotation());
+    m_logger.push(m_leftTwistTrajectory.front().getLinearVec3());
+    m_logger.push(m_leftTwistTrajectory.front().getAngularVec3());
+    m_logger.push(m_robotControlHelper->getLeftWrench().getLinearVec3());
+    m_logger.push(m_robotControlHelper->getLeftWrench().getAngularVec3());
+
+    // Right foot
+    m_logger.push(rightFoot.getPosition());
+    m_logger.push(m_rightTrajectory.front().getPosition());
+    m_logger.push(rightFoot.getRotation());
+    m_logger.push(m_rightTrajectory.front().getRotation());
+    m_logger.push(m_rightTwistTrajectory.front().getLinearVec3());
+    m_logger.push(m_rightTwistTrajectory.front().getAngularVec3());
+    m_logger.push(m_robotControlHelper->getRightWrench().getLinearVec3());
+    m_logger.push(m_robotControlHelper->getRightWrench().getAngularVec3());
+
+    // Joint
+    m_logger.push(m_robotControlHelper->getJointPosition());
+    m_logger.push(m_qDesired);
+    m_logger.push(m_retargetingClient->jointPositions());
+    m_logger.push(m_retargetingClient->rawJointPositions());
+    m_logger.push(m_robotControlHelper->getJointVelocity());
+    m_logger.push(m_retargetingClient->jointVelocities());
+
+    // root link information
+    const iDynTree::Transform& rootLinkTransform = m_FKSolver->getRootLinkToWorldTransform();
+    m_logger.push(rootLinkTransform.getPosition());
+    m_logger.push(rootLinkTransform.getRotation());
+    m_logger.push(m_FKSolver->getRootLinkVelocity().getLinearVec3());
+    m_logger.push(m_FKSolver->getRootLinkVelocity().getAngularVec3());
+
+    // collect the stance foot information
+    m_logger.push(m_isLeftFixedFrame.front() ? 1.0 : 0.0);
+
+    m_logger.endRecord();
+}
+
 iDynTree::Rotation WalkingModule::computeAverageYawRotationFromPlannedFeet() const
 {
     const double yawLeft = m_leftTrajectory.front().getRotation().asRPY()(2);
@@ -1229,6 +1769,10 @@ bool WalkingModule::prepareRobot(bool onTheFly)
         }
     }
 
+    // the degradation of the previous walking is cleared
+    m_deadlineWatchdog.reset();
+    m_mpcDegraded = false;
+
     // reset the gains
     if (m_robotControlHelper->getPIDHandler().usingGainScheduling())
     {
@@ -1300,7 +1844,7 @@ bool WalkingModule::generateFirstTrajectories(const iDynTree::Transform &leftToR
         return false;
     }
 
-    if (!updateTrajectories(0))
+    if (!updateTrajectories(0, std::pmr::get_default_resource()))
     {
         yError() << "[WalkingModule::generateFirstTrajectories] Unable to update the trajectory.";
         return false;
@@ -1337,7 +1881,7 @@ bool WalkingModule::generateFirstTrajectories()
         }
     }
 
-    if (!updateTrajectories(0))
+    if (!updateTrajectories(0, std::pmr::get_default_resource()))
     {
         yError() << "[WalkingModule::generateFirstTrajectories] Unable to update the trajectory.";
         return false;
@@ -1391,7 +1935,7 @@ bool WalkingModule::askNewTrajectories(const double &initTime, const bool &isLef
     return true;
 }
 
-bool WalkingModule::updateTrajectories(const size_t &mergePoint)
+bool WalkingModule::updateTrajectories(const size_t &mergePoint, std::pmr::memory_resource* memoryResource)
 {
     if (!(m_trajectoryGenerator->isTrajectoryComputed()))
     {
@@ -1403,9 +1947,10 @@ bool WalkingModule::updateTrajectories(const size_t &mergePoint)
     std::vector<iDynTree::Transform> rightTrajectory;
     std::vector<iDynTree::Twist> leftTwistTrajectory;
     std::vector<iDynTree::Twist> rightTwistTrajectory;
-    std::vector<iDynTree::Vector2> DCMPositionDesired;
-    std::vector<iDynTree::Vector2> DCMVelocityDesired;
-    std::vector<iDynTree::Vector2> desiredZMP;
+    // the trajectories evaluated by the DCM generator are copied in the given memory resource
+    std::pmr::vector<iDynTree::Vector2> DCMPositionDesired(memoryResource);
+    std::pmr::vector<iDynTree::Vector2> DCMVelocityDesired(memoryResource);
+    std::pmr::vector<iDynTree::Vector2> desiredZMP(memoryResource);
     std::vector<bool> rightInContact;
     std::vector<bool> leftInContact;
     std::vector<double> comHeightTrajectory;
@@ -1550,6 +2095,16 @@ bool WalkingModule::startWalking()
     }
     m_zmpOffsetLocal = m_zmpOffset;
 
+    // the logging, the transforms and the MPC are restored. The MPC disabled by the watchdog
+    // restarts from scratch since its last solution is outdated
+    if (m_mpcDegraded)
+    {
+        m_walkingController->reset();
+        m_mpcDegraded = false;
+        yInfo() << "[WalkingModule::startWalking] Switching back to the MPC.";
+    }
+    m_deadlineWatchdog.reset();
+
     m_robotState = WalkingFSM::Walking;
 
     yInfo() << "[WalkingModule::startWalking] Started!";
@@ -1638,3 +2193,169 @@ bool WalkingModule::stopWalking()
     m_robotState = WalkingFSM::Stopped;
     return true;
 }
+
+bool WalkingModule::setLoggerChannelDecimation(const std::string& channel, const std::int32_t decimation)
+{
+    if (!m_dumpData)
+    {
+        yError() << "[WalkingModule::setLoggerChannelDecimation] The logger is not enabled.";
+        return false;
+    }
+
+    return m_logger.setChannelDecimation(channel, decimation);
+}
+
+bool WalkingModule::enableLoggerChannel(const std::string& channel, const bool enable)
+{
+    if (!m_dumpData)
+    {
+        yError() << "[WalkingModule::enableLoggerChannel] The logger is not enabled.";
+        return false;
+    }
+
+    return m_logger.enableChannel(channel, enable);
+}
+
+bool WalkingModule::triggerLogger()
+{
+    if (!m_dumpData)
+    {
+        yError() << "[WalkingModule::triggerLogger] The logger is not enabled.";
+        return false;
+    }
+
+    return m_logger.trigger();
+}
+
+std::string WalkingModule::getStageProfilerReport()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    std::string report = m_stageProfiler.getReport() + "tick arena: peak " + std::to_string(m_tickArena.getPeakBytes())
+        + " of " + std::to_string(m_tickArena.getCapacity()) + " bytes, "
+        + std::to_string(m_tickArena.getOverflows()) + " overflows\n";
+
+    // the IK solver does not exist after close()
+    if (m_IKSolver)
+    {
+        const WalkingIK::AccuracyStatistics& accuracy = m_IKSolver->getAccuracyStatistics();
+        report += "ik accuracy: " + std::to_string(accuracy.samples) + " samples, max CoM error "
+            + std::to_string(accuracy.maxCoMError) + " m, max foot error "
+            + std::to_string(accuracy.maxFootError) + " m\n";
+    }
+    if (m_BLFIKSolver)
+    {
+        const BLFIK::SolverStatistics& qpStatistics = m_BLFIKSolver->getSolverStatistics();
+        report += "qp ik: " + std::to_string(qpStatistics.solves) + " solves, "
+            + std::to_string(qpStatistics.failures) + " failures, "
+            + std::to_string(qpStatistics.skippedWeightUpdates) + " with constant weights\n";
+    }
+    if (m_robotControlHelper)
+        report += "joint velocity latency: " + std::to_string(m_robotControlHelper->getJointVelocityLatency()) + " s\n";
+    return report;
+}
+
+bool WalkingModule::resetStageProfiler()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    m_stageProfiler.reset();
+    m_tickArena.resetStatistics();
+    if (m_IKSolver)
+        m_IKSolver->resetAccuracyStatistics();
+    if (m_BLFIKSolver)
+        m_BLFIKSolver->resetSolverStatistics();
+    return true;
+}
+
+bool WalkingModule::isPrepared()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_robotState == WalkingFSM::Prepared;
+}
+
+bool WalkingModule::isWalking()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_robotState == WalkingFSM::Walking;
+}
+
+const StdUtilities::StageProfiler& WalkingModule::getStageProfiler() const
+{
+    return m_stageProfiler;
+}
+
+const StdUtilities::TickArena& WalkingModule::getTickArena() const
+{
+    return m_tickArena;
+}
+
+const std::vector<LoggedChannel>& WalkingModule::getInputChannels() const
+{
+    return m_inputChannels;
+}
+
+bool WalkingModule::setReplayedInputs(const double* record)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    if (m_robotControlHelper == nullptr || m_retargetingClient == nullptr)
+    {
+        yError() << "[WalkingModule::setReplayedInputs] The module is not configured.";
+        return false;
+    }
+
+    auto span = [this, record](const InputChannel& channel) {
+        return iDynTree::make_span(record + m_inputChannels[channel].offset, m_inputChannels[channel].size);
+    };
+    auto vector3 = [this, record](const InputChannel& channel, const size_t& shift) {
+        return iDynTree::Vector3(record + m_inputChannels[channel].offset + shift, 3);
+    };
+    auto transform = [this, record](const InputChannel& position, const InputChannel& orientation) {
+        return iDynTree::Transform(iDynTree::Rotation(record + m_inputChannels[orientation].offset, 3, 3),
+                                   iDynTree::Position(record + m_inputChannels[position].offset, 3));
+    };
+
+    iDynTree::Wrench leftWrench, rightWrench;
+    leftWrench.setLinearVec3(vector3(LeftWrenchInput, 0));
+    leftWrench.setAngularVec3(vector3(LeftWrenchInput, 3));
+    rightWrench.setLinearVec3(vector3(RightWrenchInput, 0));
+    rightWrench.setAngularVec3(vector3(RightWrenchInput, 3));
+    iDynTree::Twist baseTwist;
+    baseTwist.setLinearVec3(vector3(BaseTwistInput, 0));
+    baseTwist.setAngularVec3(vector3(BaseTwistInput, 3));
+
+    if (!m_robotControlHelper->setReplayedFeedback(span(JointPositionsInput), span(JointVelocitiesInput),
+                                                   leftWrench, rightWrench,
+                                                   transform(BasePositionInput, BaseOrientationInput),
+                                                   baseTwist))
+    {
+        yError() << "[WalkingModule::setReplayedInputs] Unable to set the feedback of the robot.";
+        return false;
+    }
+
+    const double* comHeight = record + m_inputChannels[CoMHeightInput].offset;
+    if (!m_retargetingClient->setReplayedFeedback(transform(LeftHandPositionInput, LeftHandOrientationInput),
+                                                  transform(RightHandPositionInput, RightHandOrientationInput),
+                                                  span(RetargetingJointPositionsInput),
+                                                  span(RetargetingJointVelocitiesInput),
+                                                  span(RetargetingRawJointPositionsInput),
+                                                  comHeight[0], comHeight[1]))
+    {
+        yError() << "[WalkingModule::setReplayedInputs] Unable to set the feedback of the retargeting client.";
+        return false;
+    }
+
+    const size_t goalSize = static_cast<size_t>(record[m_inputChannels[GoalSizeInput].offset]);
+    if (goalSize > m_inputChannels[GoalInput].size)
+    {
+        yError() << "[WalkingModule::setReplayedInputs] The size of the goal is not valid.";
+        return false;
+    }
+    m_isGoalReceived = goalSize > 0;
+    m_receivedGoal.resize(goalSize);
+    std::copy_n(record + m_inputChannels[GoalInput].offset, goalSize, m_receivedGoal.data());
+
+    m_replayInputs = true;
+    return true;
+}
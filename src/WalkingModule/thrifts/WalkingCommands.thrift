@@ -41,4 +41,39 @@ service WalkingCommands
      * @return true/false in case of success/failure;
      */
     bool stopWalking();
+
+    /**
+     * Set the decimation of the channels sent by the logger.
+     * @param channel name of the channel or prefix of a group of channels (e.g. joints_state);
+     * @param decimation the channels are sent once every decimation steps.
+     * @return true/false in case of success/failure;
+     */
+    bool setLoggerChannelDecimation(1:string channel, 2:i32 decimation);
+
+    /**
+     * Enable or disable the channels sent by the logger.
+     * @param channel name of the channel or prefix of a group of channels (e.g. joints_state);
+     * @param enable true if the channels have to be sent.
+     * @return true/false in case of success/failure;
+     */
+    bool enableLoggerChannel(1:string channel, 2:bool enable);
+
+    /**
+     * Send the last seconds of logged data (the logger has to be in trigger mode).
+     * @return true/false in case of success/failure;
+     */
+    bool triggerLogger();
+
+    /**
+     * Get the statistics of the stages of the control loop, i.e. the number of samples, the
+     * mean, the 50th, 99th and 99.9th percentiles and the maximum duration (in milliseconds).
+     * @return a table containing the statistics of each stage;
+     */
+    string getStageProfilerReport();
+
+    /**
+     * Reset the statistics of the stages of the control loop.
+     * @return true/false in case of success/failure;
+     */
+    bool resetStageProfiler();
 }
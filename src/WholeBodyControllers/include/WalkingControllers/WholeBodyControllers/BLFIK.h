@@ -17,7 +17,11 @@
 #include <BipedalLocomotion/ParametersHandler/IParametersHandler.h>
 #include <BipedalLocomotion/System/VariablesHandler.h>
 
+#include <Eigen/Dense>
+
+#include <cstddef>
 #include <memory>
+#include <string>
 
 namespace WalkingControllers
 {
@@ -25,6 +29,17 @@ namespace WalkingControllers
 class BLFIK
 {
 public:
+    /**
+     * Statistics of the solutions of the QP.
+     */
+    struct SolverStatistics
+    {
+        std::size_t solves{0}; /**< Number of calls to solve(). */
+        std::size_t failures{0}; /**< Number of solutions that failed. */
+        std::size_t weightUpdates{0}; /**< Number of solutions in which the task weights changed. */
+        std::size_t skippedWeightUpdates{0}; /**< Number of solutions with constant task weights. */
+    };
+
     bool initialize(std::weak_ptr<const BipedalLocomotion::ParametersHandler::IParametersHandler> handler,
                     std::shared_ptr<iDynTree::KinDynComputations> kinDyn);
 
@@ -46,7 +61,23 @@ public:
     bool setTorsoSetPoint(const iDynTree::Rotation& rotation);
     const iDynTree::VectorDynSize& getDesiredJointVelocity() const;
 
+    /**
+     * Get the statistics of the solutions since the initialization or the last reset.
+     */
+    const SolverStatistics& getSolverStatistics() const;
+
+    /**
+     * Reset the statistics of the solutions.
+     */
+    void resetSolverStatistics();
+
 private:
+    /**
+     * Advance the weight providers of the tasks.
+     * @return true if the weights changed since the previous solution.
+     */
+    bool advanceWeights();
+
     std::shared_ptr<BipedalLocomotion::ContinuousDynamicalSystem::MultiStateWeightProvider>
         m_torsoWeight;
     std::shared_ptr<BipedalLocomotion::ContinuousDynamicalSystem::MultiStateWeightProvider>
@@ -66,6 +97,16 @@ private:
     std::shared_ptr<BipedalLocomotion::IK::JointTrackingTask> m_jointRegularizationTask;
 
     iDynTree::VectorDynSize m_jointVelocity;
+
+    // the weight providers are advanced only after a change of phase, i.e. until their output
+    // is constant. In the meanwhile the weights of the QP do not change
+    std::string m_phase;
+    bool m_weightsSettled{false};
+    Eigen::VectorXd m_torsoWeightValue;
+    Eigen::VectorXd m_jointRegularizationWeightValue;
+    Eigen::VectorXd m_jointRetargetingWeightValue;
+    SolverStatistics m_statistics;
+
     bool m_usejointRetargeting{false};
     bool m_useRootLinkForHeight{false};
     bool m_useFeedforwardTermForJointRetargeting{false};
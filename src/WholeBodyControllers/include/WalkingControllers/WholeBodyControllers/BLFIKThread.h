@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_WHOLE_BODY_CONTROLLERS_BLF_IK_THREAD
+#define WALKING_CONTROLLERS_WHOLE_BODY_CONTROLLERS_BLF_IK_THREAD
+
+// std
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// iDynTree
+#include <iDynTree/KinDynComputations.h>
+#include <iDynTree/Transform.h>
+#include <iDynTree/Twist.h>
+#include <iDynTree/VectorDynSize.h>
+#include <iDynTree/VectorFixSize.h>
+
+// BipedalLocomotion
+#include <BipedalLocomotion/ParametersHandler/IParametersHandler.h>
+#include <BipedalLocomotion/System/TimeProfiler.h>
+
+#include <WalkingControllers/WholeBodyControllers/BLFIK.h>
+
+namespace WalkingControllers
+{
+
+/**
+ * BLFIKThread runs the QP inverse kinematics at a rate lower than the one of the walking module.
+ * The problem is solved every ik_sampling_time / sampling_time calls of solve() in a separate
+ * thread, on a copy of the kinematic state of the robot taken when the set points are sent. The
+ * joint velocities are linearly interpolated between two consecutive solutions and they are
+ * integrated by the walking module at its own rate.
+ * If ik_sampling_time is equal to sampling_time the problem is solved in the calling thread on the
+ * kinematics passed to initialize().
+ */
+class BLFIKThread
+{
+    /**
+     * Set points of the tasks and state of the robot used by a solution.
+     */
+    struct Input
+    {
+        std::string phase;
+        iDynTree::Rotation torsoRotation;
+        iDynTree::Transform leftFootTransform;
+        iDynTree::Twist leftFootVelocity;
+        iDynTree::Transform rightFootTransform;
+        iDynTree::Twist rightFootVelocity;
+        iDynTree::Position comPosition;
+        iDynTree::Vector3 comVelocity;
+        iDynTree::Position rootPosition;
+        iDynTree::Vector3 rootVelocity;
+        iDynTree::VectorDynSize retargetingJointPositions;
+        iDynTree::VectorDynSize retargetingJointVelocities;
+
+        std::string floatingBase;
+        iDynTree::Transform baseTransform;
+        iDynTree::Twist baseVelocity;
+        iDynTree::VectorDynSize jointPositions;
+        iDynTree::VectorDynSize jointVelocities;
+        iDynTree::Vector3 gravity;
+    };
+
+    BLFIK m_ik; /**< QP inverse kinematics. */
+    std::shared_ptr<iDynTree::KinDynComputations> m_kinDyn; /**< Kinematics of the walking module. */
+    std::shared_ptr<iDynTree::KinDynComputations> m_threadKinDyn; /**< Kinematics used by the thread. */
+
+    int m_decimation{1}; /**< Number of fast steps for each IK step. */
+    int m_ticksSinceInput{0}; /**< Number of fast steps since the last input sent to the thread. */
+    int m_ticksSinceSolution{0}; /**< Number of fast steps since the last solution. */
+
+    bool m_hasSolution{false}; /**< True if at least one solution is available. */
+    bool m_newInputAvailable{false}; /**< True if a new input has to be processed by the thread. */
+    bool m_newSolutionAvailable{false}; /**< True if the thread computed a new solution. */
+    bool m_solverFailed{false}; /**< True if the thread was not able to solve the problem. */
+    bool m_resetStatistics{false}; /**< True if the statistics have to be reset by the thread. */
+    bool m_isClosing{false}; /**< True if the thread has to be closed. */
+
+    Input m_nextInput; /**< Input filled by the set points of the walking module. */
+    Input m_input; /**< Input shared with the thread. */
+    Input m_threadInput; /**< Input used by the thread. */
+
+    iDynTree::VectorDynSize m_solution; /**< Last solution computed by the thread. */
+    iDynTree::VectorDynSize m_previousOutput; /**< Output at the time the last solution was received. */
+    iDynTree::VectorDynSize m_latestOutput; /**< Last solution used by the fast loop. */
+    iDynTree::VectorDynSize m_output; /**< Interpolated output. */
+    BLFIK::SolverStatistics m_statistics; /**< Statistics of the solutions computed by the thread. */
+
+    std::unique_ptr<BipedalLocomotion::System::TimeProfiler> m_profiler; /**< Profiler of the IK rate. */
+
+    std::thread m_ikThread; /**< Thread running the inverse kinematics. */
+    std::condition_variable m_conditionVariable; /**< Synchronizer. */
+    std::mutex m_mutex; /**< Mutex protecting the input and output buffers. */
+    std::mutex m_ikMutex; /**< Mutex protecting the inverse kinematics. */
+
+    /**
+     * Main thread method.
+     */
+    void computeThread();
+
+    /**
+     * Solve the inverse kinematics using the content of the input buffer.
+     * @return true/false in case of success/failure.
+     */
+    bool solveInput();
+
+public:
+    /**
+     * Destructor.
+     */
+    ~BLFIKThread();
+
+    /**
+     * Initialize the inverse kinematics.
+     * @param handler parameters of BLFIK. It must contain the sampling_time of the walking module
+     * and optionally the ik_sampling_time;
+     * @param kinDyn kinematics of the robot whose state is set by the walking module.
+     * @return true/false in case of success/failure.
+     */
+    bool initialize(std::weak_ptr<const BipedalLocomotion::ParametersHandler::IParametersHandler> handler,
+                    std::shared_ptr<iDynTree::KinDynComputations> kinDyn);
+
+    bool setPhase(const std::string& phase);
+
+    bool setLeftFootSetPoint(const iDynTree::Transform& desiredTransform,
+                             const iDynTree::Twist& desiredVelocity);
+
+    bool setRightFootSetPoint(const iDynTree::Transform& desiredTransform,
+                              const iDynTree::Twist& desiredVelocity);
+
+    bool setRetargetingJointSetPoint(const iDynTree::VectorDynSize& jointPositions,
+                                     const iDynTree::VectorDynSize& jointVelocities);
+    bool setRegularizationJointSetPoint(const iDynTree::VectorDynSize& jointPosition);
+    bool setCoMSetPoint(const iDynTree::Position& position, const iDynTree::Vector3& velocity);
+    bool setRootSetPoint(const iDynTree::Position& position, const iDynTree::Vector3& velocity);
+    bool setTorsoSetPoint(const iDynTree::Rotation& rotation);
+
+    /**
+     * Solve the inverse kinematics. It has to be called at each step of the walking module, after
+     * the set points and the state of the kinematics are set.
+     * @return true/false in case of success/failure.
+     */
+    bool solve();
+
+    /**
+     * Get the (interpolated) joint velocities.
+     */
+    const iDynTree::VectorDynSize& getDesiredJointVelocity() const;
+
+    /**
+     * Get the statistics of the solutions since the initialization or the last reset.
+     */
+    BLFIK::SolverStatistics getSolverStatistics();
+
+    /**
+     * Reset the statistics of the solutions.
+     */
+    void resetSolverStatistics();
+
+    /**
+     * Discard the solutions, the next one is computed in the calling thread.
+     */
+    void reset();
+};
+
+} // namespace WalkingControllers
+
+#endif // WALKING_CONTROLLERS_WHOLE_BODY_CONTROLLERS_BLF_IK_THREAD
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_WHOLE_BODY_CONTROLLERS_DAMPED_LEAST_SQUARES_IK_H
+#define WALKING_CONTROLLERS_WHOLE_BODY_CONTROLLERS_DAMPED_LEAST_SQUARES_IK_H
+
+// std
+#include <string>
+#include <vector>
+
+// Eigen
+#include <Eigen/Dense>
+
+// iDynTree
+#include <iDynTree/KinDynComputations.h>
+#include <iDynTree/MatrixDynSize.h>
+#include <iDynTree/Model.h>
+#include <iDynTree/Transform.h>
+#include <iDynTree/VectorDynSize.h>
+
+namespace WalkingControllers
+{
+
+    /**
+     * DampedLeastSquaresIK solves the walking inverse kinematics problem of WalkingIK with a
+     * Levenberg-Marquardt (damped least-squares) iteration. The left foot is the fixed base and
+     * the tasks are:
+     * - the pose of the right foot and the position of the CoM (weighted with the constraints
+     *   weight, since they are constraints in the IPOPT formulation);
+     * - the rotation of the additional frame (optional);
+     * - the regularization of the joint positions.
+     *
+     * The Jacobians are the analytic ones of KinDynComputations, the joint limits are enforced
+     * clamping the joint positions at each iteration and the number of iterations is bounded.
+     * All the memory is allocated by initialize().
+     */
+    class DampedLeastSquaresIK
+    {
+    public:
+
+        /**
+         * Parameters of the solver.
+         */
+        struct Parameters
+        {
+            int maxIterations{20}; /**< Maximum number of iterations of a solve. */
+            double tolerance{1e-5}; /**< Norm of the error of the constraints at the convergence. */
+            double damping{1e-3}; /**< Initial damping of the Levenberg-Marquardt iteration. */
+            double constraintsWeight{1e3}; /**< Weight of the right foot and CoM tasks. */
+        };
+
+    private:
+
+        iDynTree::KinDynComputations m_kinDyn; /**< Kinematics of the full model. */
+        Parameters m_parameters; /**< Parameters of the solver. */
+
+        iDynTree::FrameIndex m_rightFootIndex; /**< Index of the right foot frame. */
+        iDynTree::FrameIndex m_additionalFrameIndex{iDynTree::FRAME_INVALID_INDEX}; /**< Index of the additional frame. */
+        iDynTree::Transform m_baseTransform; /**< Transform between the left foot frame and its link. */
+
+        std::vector<int> m_jointsOffset; /**< DoF of the full model of each optimized joint. */
+        Eigen::VectorXd m_lowerLimits; /**< Lower limits of the optimized joints. */
+        Eigen::VectorXd m_upperLimits; /**< Upper limits of the optimized joints. */
+
+        iDynTree::VectorDynSize m_fullPositions; /**< Joint positions of the full model. */
+        iDynTree::VectorDynSize m_fullVelocities; /**< Joint velocities of the full model (zero). */
+        iDynTree::Twist m_baseVelocity; /**< Velocity of the base (zero). */
+        iDynTree::Vector3 m_gravity; /**< Gravity acceleration. */
+
+        iDynTree::MatrixDynSize m_frameJacobian; /**< Free floating Jacobian of a frame. */
+        iDynTree::MatrixDynSize m_comJacobian; /**< Free floating Jacobian of the CoM. */
+        Eigen::MatrixXd m_jacobian; /**< Jacobian of the tasks w.r.t. the optimized joints. */
+        Eigen::MatrixXd m_weightedJacobian; /**< Jacobian multiplied by the weights of the tasks. */
+        Eigen::VectorXd m_weights; /**< Weights of the tasks. */
+        Eigen::VectorXd m_error; /**< Error of the tasks. */
+        Eigen::VectorXd m_weightedError; /**< Error multiplied by the weights of the tasks. */
+        Eigen::MatrixXd m_normalMatrix; /**< Weighted normal matrix of the Jacobian. */
+        Eigen::MatrixXd m_hessian; /**< Hessian of the Levenberg-Marquardt step. */
+        Eigen::VectorXd m_gradient; /**< Gradient of the Levenberg-Marquardt step. */
+        Eigen::LDLT<Eigen::MatrixXd> m_decomposition; /**< Decomposition of the Hessian. */
+        Eigen::VectorXd m_positions; /**< Current joint positions. */
+        Eigen::VectorXd m_candidate; /**< Joint positions after the step. */
+        Eigen::VectorXd m_step; /**< Step of the joint positions. */
+
+        int m_iterations{0}; /**< Iterations of the last solve. */
+        double m_constraintsError{0}; /**< Norm of the error of the constraints of the last solve. */
+
+        /**
+         * Set the joint positions of the kinematic model.
+         * @param positions joint positions of the optimized joints.
+         */
+        void setPositions(const Eigen::Ref<const Eigen::VectorXd>& positions);
+
+        /**
+         * Evaluate the error of the tasks for the current joint positions.
+         * @param desiredRightTransform desired pose of the right foot;
+         * @param desiredCoMPosition desired position of the CoM;
+         * @param desiredAdditionalRotation desired rotation of the additional frame;
+         * @param regularization desired joint positions;
+         * @param regularizationWeight weight of the joint regularization.
+         * @return the cost of the current joint positions.
+         */
+        double evaluateError(const iDynTree::Transform& desiredRightTransform,
+                             const iDynTree::Position& desiredCoMPosition,
+                             const iDynTree::Rotation& desiredAdditionalRotation,
+                             const Eigen::Ref<const Eigen::VectorXd>& regularization,
+                             const double& regularizationWeight);
+
+        /**
+         * Evaluate the Jacobian of the tasks for the current joint positions.
+         */
+        void evaluateJacobian();
+
+    public:
+
+        /**
+         * Initialize the solver.
+         * @param model model of the robot;
+         * @param joints names of the optimized joints, in the order of the solution;
+         * @param leftFootFrame name of the left foot frame (the fixed base);
+         * @param rightFootFrame name of the right foot frame;
+         * @param additionalFrame name of the additional frame (empty if not used);
+         * @param parameters parameters of the solver.
+         * @return true/false in case of success/failure.
+         */
+        bool initialize(const iDynTree::Model& model,
+                        const std::vector<std::string>& joints,
+                        const std::string& leftFootFrame,
+                        const std::string& rightFootFrame,
+                        const std::string& additionalFrame,
+                        const Parameters& parameters);
+
+        /**
+         * Solve the inverse kinematics. All the quantities are expressed in the left foot frame.
+         * @param desiredRightTransform desired pose of the right foot;
+         * @param desiredCoMPosition desired position of the CoM;
+         * @param desiredAdditionalRotation desired rotation of the additional frame;
+         * @param additionalRotationWeight weight of the rotation of the additional frame;
+         * @param feedback joint positions of the full model (used for the joints not optimized);
+         * @param regularization desired positions of the optimized joints;
+         * @param regularizationWeight weight of the joint regularization;
+         * @param guess initial guess of the optimized joints;
+         * @param solution positions of the optimized joints (the best solution found also if the
+         * solver did not converge).
+         * @return true if the tolerance on the constraints was reached, false otherwise.
+         */
+        bool solve(const iDynTree::Transform& desiredRightTransform,
+                   const iDynTree::Position& desiredCoMPosition,
+                   const iDynTree::Rotation& desiredAdditionalRotation,
+                   const double& additionalRotationWeight,
+                   const iDynTree::VectorDynSize& feedback,
+                   const iDynTree::VectorDynSize& regularization,
+                   const double& regularizationWeight,
+                   const iDynTree::VectorDynSize& guess,
+                   iDynTree::VectorDynSize& solution);
+
+        /**
+         * Get the number of iterations of the last solve.
+         */
+        int getIterations() const;
+
+        /**
+         * Get the norm of the error of the right foot and CoM tasks at the end of the last solve.
+         */
+        double getConstraintsError() const;
+
+        /**
+         * Return true if the last solve reached the tolerance on the constraints.
+         */
+        bool isConverged() const;
+    };
+};
+
+#endif
@@ -7,8 +7,14 @@
 // iDynTree
 #include <iDynTree/KinDynComputations.h>
 #include <iDynTree/InverseKinematics.h>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
 
+#include <WalkingControllers/WholeBodyControllers/DampedLeastSquaresIK.h>
+#include <WalkingControllers/WholeBodyControllers/LegIK.h>
+
 namespace yarp {
     namespace os {
         class Searchable;
@@ -32,12 +38,32 @@ namespace WalkingControllers
      * \f[
      *
      * \f]
+     * The problem is solved by IPOPT (solver_name is the name of its linear solver) or, if
+     * solver_name is "dls", by the damped least-squares solver DampedLeastSquaresIK.
+     * If leg_ik_warm_start is enabled, the right leg joints of the initial guess are computed in
+     * closed form (LegIK) so that the guess already satisfies the right foot constraint.
      */
     class WalkingIK
     {
+    public:
+
+        /**
+         * Errors of the solutions checked by the accuracy monitor.
+         */
+        struct AccuracyStatistics
+        {
+            std::uint64_t samples{0}; /**< Number of checked solutions. */
+            double lastCoMError{0}; /**< Norm of the CoM position error of the last checked solution [m]. */
+            double maxCoMError{0}; /**< Maximum norm of the CoM position error [m]. */
+            double lastFootError{0}; /**< Norm of the right foot position error of the last checked solution [m]. */
+            double maxFootError{0}; /**< Maximum norm of the right foot position error [m]. */
+        };
+
+    private:
 
         bool m_verbose;
         iDynTree::InverseKinematics m_ik;
+        std::unique_ptr<DampedLeastSquaresIK> m_dlsSolver; /**< Damped least-squares solver (nullptr if IPOPT is used). */
 
         std::string m_lFootFrame;
         std::string m_rFootFrame;
@@ -60,10 +86,50 @@ namespace WalkingControllers
 
         bool m_prepared;
 
+        int m_accuracyMonitorPeriod{0}; /**< The accuracy is checked every m_accuracyMonitorPeriod solutions (0 disables the check). */
+        int m_accuracyMonitorCounter{0}; /**< Solutions since the last check. */
+        AccuracyStatistics m_accuracyStatistics; /**< Errors of the checked solutions. */
+
+        bool m_useLegWarmStart{false}; /**< True if the right leg of the guess is computed by m_legIK. */
+        LegIK m_legIK; /**< Closed-form IK of the right leg. */
+        iDynTree::FrameIndex m_legIKPelvisFrameIndex{iDynTree::FRAME_INVALID_INDEX}; /**< Frame of the reduced model w.r.t. which the leg is solved. */
+        std::array<int, 6> m_rightLegDOFs; /**< DoFs of the reduced model of the right leg joints. */
+        Eigen::Matrix<double, 6, 1> m_legReference; /**< Right leg joints of the guess. */
+        Eigen::Matrix<double, 6, 1> m_legSolution; /**< Right leg joints computed by m_legIK. */
+
         double m_additionalRotationWeight, m_jointRegularizationWeight;
 
         bool prepareIK();
 
+        /**
+         * Initialize the damped least-squares solver.
+         * @param ikOption the options for the IK.
+         * @return true on success, false otherwise
+         */
+        bool initializeDLSSolver(yarp::os::Searchable& ikOption);
+
+        /**
+         * Evaluate the kinematics of the last solution and update the accuracy statistics.
+         * @param desiredRightTransform desired right foot transform (in the left foot frame);
+         * @param desiredCoMPosition desired CoM position (in the left foot frame).
+         */
+        void monitorAccuracy(const iDynTree::Transform& desiredRightTransform,
+                             const iDynTree::Position& desiredCoMPosition);
+
+        /**
+         * Initialize the closed-form IK of the right leg.
+         * @param ikOption the options for the IK.
+         * @return true on success, false otherwise
+         */
+        bool initializeLegWarmStart(yarp::os::Searchable& ikOption);
+
+        /**
+         * Replace the right leg joints of the guess with the ones that reach the desired right
+         * foot transform, keeping the pelvis of the guess.
+         * @param desiredRightTransform desired right foot transform (in the left foot frame).
+         */
+        void warmStartRightLeg(const iDynTree::Transform& desiredRightTransform);
+
     public:
 
         /**
@@ -140,6 +206,17 @@ namespace WalkingControllers
         bool setDesiredJointsWeight(double weight);
 
         double desiredJointWeight();
+
+        /**
+         * Get the errors of the solutions checked by the accuracy monitor
+         * (accuracy_monitor_period).
+         */
+        const AccuracyStatistics& getAccuracyStatistics() const;
+
+        /**
+         * Reset the statistics of the accuracy monitor.
+         */
+        void resetAccuracyStatistics();
     };
 };
 
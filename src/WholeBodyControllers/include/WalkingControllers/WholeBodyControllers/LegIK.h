@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_WHOLE_BODY_CONTROLLERS_LEG_IK_H
+#define WALKING_CONTROLLERS_WHOLE_BODY_CONTROLLERS_LEG_IK_H
+
+// std
+#include <array>
+#include <string>
+#include <vector>
+
+// Eigen
+#include <Eigen/Dense>
+
+// iDynTree
+#include <iDynTree/Model.h>
+#include <iDynTree/Transform.h>
+
+namespace WalkingControllers
+{
+
+    /**
+     * LegIK computes in closed form the joint positions of a 6-DoF leg given the pose of the foot
+     * with respect to the pelvis. The leg is described by the product of exponentials of its
+     * joints (taken from the model in the zero configuration) and it has to be composed of:
+     * - three hip joints whose axes intersect in a point (the hip center);
+     * - a knee joint;
+     * - two ankle joints whose axes intersect in a point (the ankle center).
+     *
+     * This is the structure of the legs of iCub and ergoCub. The knee angle is obtained from the
+     * distance between the hip and the ankle centers, the ankle and the hip angles from the
+     * Paden-Kahan subproblems. Among the (up to eight) solutions the one that satisfies the joint
+     * limits and is closest to a reference configuration is returned.
+     */
+    class LegIK
+    {
+        /**
+         * Joint of the leg, expressed in the pelvis frame in the zero configuration.
+         */
+        struct Joint
+        {
+            Eigen::Vector3d axis; /**< Unit direction of the axis. */
+            Eigen::Vector3d point; /**< Point of the axis. */
+            double lowerLimit; /**< Lower position limit. */
+            double upperLimit; /**< Upper position limit. */
+        };
+
+        std::array<Joint, 6> m_joints; /**< Joints of the leg, from the hip to the ankle. */
+        Eigen::Isometry3d m_zeroTransform; /**< Pose of the foot in the zero configuration. */
+        Eigen::Vector3d m_hipCenter; /**< Intersection of the hip axes. */
+        Eigen::Vector3d m_ankleCenter; /**< Intersection of the ankle axes. */
+        double m_tolerance{1e-4}; /**< Tolerance of the geometry and of the solution. */
+        bool m_isInitialized{false}; /**< True if the solver is initialized. */
+
+        /**
+         * Rigid transformation of a joint.
+         * @param joint index of the joint;
+         * @param angle joint position.
+         * @return the transformation.
+         */
+        Eigen::Isometry3d jointTransform(const std::size_t& joint, const double& angle) const;
+
+    public:
+
+        /**
+         * Initialize the solver.
+         * @param model model of the robot;
+         * @param pelvisFrame name of the frame with respect to which the foot pose is expressed;
+         * @param footFrame name of the foot frame;
+         * @param joints names of the six joints of the leg, from the hip to the ankle;
+         * @param tolerance maximum distance between the axes that are supposed to intersect [m].
+         * @return true/false in case of success/failure (e.g. the leg has not the required
+         * structure).
+         */
+        bool initialize(const iDynTree::Model& model,
+                        const std::string& pelvisFrame,
+                        const std::string& footFrame,
+                        const std::vector<std::string>& joints,
+                        const double& tolerance = 1e-4);
+
+        /**
+         * Compute the joint positions of the leg.
+         * @param pelvisToFoot desired pose of the foot with respect to the pelvis (pelvis_H_foot);
+         * @param reference reference joint positions, used to choose among the solutions;
+         * @param solution joint positions of the leg.
+         * @return true if a solution within the joint limits reaches the pose, false otherwise.
+         */
+        bool solve(const iDynTree::Transform& pelvisToFoot,
+                   const Eigen::Ref<const Eigen::VectorXd>& reference,
+                   Eigen::Ref<Eigen::VectorXd> solution) const;
+
+        /**
+         * Compute the pose of the foot with respect to the pelvis.
+         * @param positions joint positions of the leg.
+         * @return pelvis_H_foot.
+         */
+        iDynTree::Transform forwardKinematics(const Eigen::Ref<const Eigen::VectorXd>& positions) const;
+    };
+};
+
+#endif
@@ -22,6 +22,23 @@
 
 using namespace WalkingControllers;
 
+namespace
+{
+// variation of the weights below which the weight providers are considered settled
+constexpr double weightTolerance = 1e-10;
+
+bool updateWeight(
+    const BipedalLocomotion::ContinuousDynamicalSystem::MultiStateWeightProvider& provider,
+    Eigen::VectorXd& value)
+{
+    const Eigen::VectorXd& output = provider.getOutput();
+    const bool changed = value.size() != output.size()
+                         || (output - value).lpNorm<Eigen::Infinity>() > weightTolerance;
+    value = output;
+    return changed;
+}
+} // namespace
+
 bool BLFIK::initialize(
     std::weak_ptr<const BipedalLocomotion::ParametersHandler::IParametersHandler> handler,
     std::shared_ptr<iDynTree::KinDynComputations> kinDyn)
@@ -124,10 +141,20 @@ bool BLFIK::initialize(
 
     m_jointVelocity.resize(kinDyn->getNrOfDegreesOfFreedom());
 
+    m_phase.clear();
+    m_weightsSettled = false;
+    m_torsoWeightValue = m_torsoWeight->getOutput();
+    m_jointRegularizationWeightValue = m_jointRegularizationWeight->getOutput();
+    if (m_usejointRetargeting)
+    {
+        m_jointRetargetingWeightValue = m_jointRetargetingWeight->getOutput();
+    }
+    resetSolverStatistics();
+
     return ok;
 }
 
-bool BLFIK::solve()
+bool BLFIK::advanceWeights()
 {
     bool ok = m_torsoWeight->advance();
     ok = ok && m_jointRegularizationWeight->advance();
@@ -136,12 +163,44 @@ bool BLFIK::solve()
         ok = ok && m_jointRetargetingWeight->advance();
     }
 
+    if (!ok)
+    {
+        BipedalLocomotion::log()->error("[BLFIK::advanceWeights] Unable to advance the weights.");
+        return false;
+    }
+
+    // all the weights are updated, hence the operator | is used
+    bool changed = updateWeight(*m_torsoWeight, m_torsoWeightValue);
+    changed = updateWeight(*m_jointRegularizationWeight, m_jointRegularizationWeightValue) | changed;
+    if (m_usejointRetargeting)
+    {
+        changed = updateWeight(*m_jointRetargetingWeight, m_jointRetargetingWeightValue) | changed;
+    }
+
+    m_weightsSettled = !changed;
+    return true;
+}
+
+bool BLFIK::solve()
+{
+    m_statistics.solves++;
+
+    // once settled, the weights read by the QP are the same of the previous solution
+    bool ok = m_weightsSettled || advanceWeights();
+    if (m_weightsSettled)
+        m_statistics.skippedWeightUpdates++;
+    else
+        m_statistics.weightUpdates++;
+
     ok = ok && m_qpIK.advance();
     ok = ok && m_qpIK.isOutputValid();
 
     if (ok)
     {
         iDynTree::toEigen(m_jointVelocity) = m_qpIK.getOutput().jointVelocity;
+    } else
+    {
+        m_statistics.failures++;
     }
 
     return ok;
@@ -149,12 +208,22 @@ bool BLFIK::solve()
 
 bool BLFIK::setPhase(const std::string& phase)
 {
+    // the phase is set at each tick, the weight providers are restarted only when it changes
+    if (phase == m_phase)
+        return true;
+
     bool ok = m_torsoWeight->setState(phase);
     ok = ok && m_jointRegularizationWeight->setState(phase);
 
     if (m_usejointRetargeting)
         ok = ok && m_jointRetargetingWeight->setState(phase);
 
+    if (ok)
+    {
+        m_phase = phase;
+        m_weightsSettled = false;
+    }
+
     return ok;
 }
 
@@ -219,3 +288,13 @@ const iDynTree::VectorDynSize& BLFIK::getDesiredJointVelocity() const
 {
     return m_jointVelocity;
 }
+
+const BLFIK::SolverStatistics& BLFIK::getSolverStatistics() const
+{
+    return m_statistics;
+}
+
+void BLFIK::resetSolverStatistics()
+{
+    m_statistics = SolverStatistics();
+}
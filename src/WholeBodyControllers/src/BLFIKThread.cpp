@@ -0,0 +1,378 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <BipedalLocomotion/TextLogging/Logger.h>
+
+#include <WalkingControllers/WholeBodyControllers/BLFIKThread.h>
+
+#include <iDynTree/EigenHelpers.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace WalkingControllers;
+
+BLFIKThread::~BLFIKThread()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_isClosing = true;
+        m_conditionVariable.notify_one();
+    }
+
+    if (m_ikThread.joinable())
+    {
+        m_ikThread.join();
+        m_ikThread = std::thread();
+    }
+}
+
+bool BLFIKThread::initialize(
+    std::weak_ptr<const BipedalLocomotion::ParametersHandler::IParametersHandler> handler,
+    std::shared_ptr<iDynTree::KinDynComputations> kinDyn)
+{
+    constexpr auto prefix = "[BLFIKThread::initialize]";
+
+    auto ptr = handler.lock();
+    if (ptr == nullptr || kinDyn == nullptr)
+    {
+        BipedalLocomotion::log()->error("{} Invalid parameter handler or kinematics.", prefix);
+        return false;
+    }
+
+    double samplingTime;
+    if (!ptr->getParameter("sampling_time", samplingTime))
+    {
+        BipedalLocomotion::log()->error("{} Unable to get the sampling_time.", prefix);
+        return false;
+    }
+
+    double ikSamplingTime = samplingTime;
+    ptr->getParameter("ik_sampling_time", ikSamplingTime);
+    m_decimation = static_cast<int>(std::round(ikSamplingTime / samplingTime));
+    if (m_decimation < 1 || std::abs(m_decimation * samplingTime - ikSamplingTime) > 1e-6)
+    {
+        BipedalLocomotion::log()->error("{} The ik_sampling_time has to be a multiple of the "
+                                        "sampling_time.",
+                                        prefix);
+        return false;
+    }
+
+    m_kinDyn = kinDyn;
+
+    // single rate, the problem is solved on the kinematics of the walking module
+    if (m_decimation == 1)
+        return m_ik.initialize(handler, m_kinDyn);
+
+    // the thread has its own copy of the kinematics, its state is the one of the walking module
+    // when the set points are sent
+    m_threadKinDyn = std::make_shared<iDynTree::KinDynComputations>();
+    if (!m_threadKinDyn->loadRobotModel(m_kinDyn->model())
+        || !m_threadKinDyn->setFrameVelocityRepresentation(m_kinDyn->getFrameVelocityRepresentation())
+        || !m_threadKinDyn->setFloatingBase(m_kinDyn->getFloatingBase()))
+    {
+        BipedalLocomotion::log()->error("{} Unable to copy the kinematics.", prefix);
+        return false;
+    }
+
+    if (!m_ik.initialize(handler, m_threadKinDyn))
+    {
+        BipedalLocomotion::log()->error("{} Unable to initialize the inverse kinematics.", prefix);
+        return false;
+    }
+
+    // the retargeting set points have the size of the joints of the model, hence copying the
+    // inputs does not allocate memory
+    const std::size_t dofs = m_kinDyn->getNrOfDegreesOfFreedom();
+    for (Input* input : {&m_nextInput, &m_input, &m_threadInput})
+    {
+        input->retargetingJointPositions.resize(dofs);
+        input->retargetingJointVelocities.resize(dofs);
+        input->jointPositions.resize(dofs);
+        input->jointVelocities.resize(dofs);
+    }
+    m_solution.resize(dofs);
+    m_previousOutput.resize(dofs);
+    m_latestOutput.resize(dofs);
+    m_output.resize(dofs);
+    m_output.zero();
+
+    m_profiler = std::make_unique<BipedalLocomotion::System::TimeProfiler>();
+    m_profiler->setPeriod(static_cast<int>(std::round(1 / ikSamplingTime)));
+    m_profiler->addTimer("IK-thread");
+
+    // start the thread
+    m_ikThread = std::thread(&BLFIKThread::computeThread, this);
+
+    BipedalLocomotion::log()->info("{} The IK runs every {} steps.", prefix, m_decimation);
+
+    return true;
+}
+
+void BLFIKThread::computeThread()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_conditionVariable.wait(lock, [this] { return m_newInputAvailable || m_isClosing; });
+            if (m_isClosing)
+                return;
+        }
+
+        // the errors are reported to the walking module by solve()
+        solveInput();
+    }
+}
+
+bool BLFIKThread::solveInput()
+{
+    std::lock_guard<std::mutex> ikGuard(m_ikMutex);
+
+    bool resetStatistics;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (!m_newInputAvailable)
+            return true;
+
+        // the vectors are already allocated, the copy does not allocate memory
+        m_threadInput = m_input;
+        resetStatistics = m_resetStatistics;
+
+        m_newInputAvailable = false;
+        m_resetStatistics = false;
+    }
+
+    if (resetStatistics)
+        m_ik.resetSolverStatistics();
+
+    m_profiler->setInitTime("IK-thread");
+
+    const Input& input = m_threadInput;
+    bool ok = true;
+    if (input.floatingBase != m_threadKinDyn->getFloatingBase())
+        ok = m_threadKinDyn->setFloatingBase(input.floatingBase);
+
+    ok = ok
+         && m_threadKinDyn->setRobotState(input.baseTransform,
+                                          input.jointPositions,
+                                          input.baseVelocity,
+                                          input.jointVelocities,
+                                          input.gravity);
+    ok = ok && m_ik.setPhase(input.phase);
+    ok = ok && m_ik.setTorsoSetPoint(input.torsoRotation);
+    ok = ok && m_ik.setLeftFootSetPoint(input.leftFootTransform, input.leftFootVelocity);
+    ok = ok && m_ik.setRightFootSetPoint(input.rightFootTransform, input.rightFootVelocity);
+    ok = ok && m_ik.setCoMSetPoint(input.comPosition, input.comVelocity);
+    ok = ok
+         && m_ik.setRetargetingJointSetPoint(input.retargetingJointPositions,
+                                             input.retargetingJointVelocities);
+    ok = ok && m_ik.setRootSetPoint(input.rootPosition, input.rootVelocity);
+    ok = ok && m_ik.solve();
+
+    m_profiler->setEndTime("IK-thread");
+    m_profiler->profiling();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_statistics = m_ik.getSolverStatistics();
+    if (!ok)
+    {
+        m_solverFailed = true;
+        return false;
+    }
+
+    m_solution = m_ik.getDesiredJointVelocity();
+    m_newSolutionAvailable = true;
+    m_hasSolution = true;
+    return true;
+}
+
+bool BLFIKThread::setPhase(const std::string& phase)
+{
+    if (m_decimation == 1)
+        return m_ik.setPhase(phase);
+
+    m_nextInput.phase = phase;
+    return true;
+}
+
+bool BLFIKThread::setLeftFootSetPoint(const iDynTree::Transform& desiredTransform,
+                                      const iDynTree::Twist& desiredVelocity)
+{
+    if (m_decimation == 1)
+        return m_ik.setLeftFootSetPoint(desiredTransform, desiredVelocity);
+
+    m_nextInput.leftFootTransform = desiredTransform;
+    m_nextInput.leftFootVelocity = desiredVelocity;
+    return true;
+}
+
+bool BLFIKThread::setRightFootSetPoint(const iDynTree::Transform& desiredTransform,
+                                       const iDynTree::Twist& desiredVelocity)
+{
+    if (m_decimation == 1)
+        return m_ik.setRightFootSetPoint(desiredTransform, desiredVelocity);
+
+    m_nextInput.rightFootTransform = desiredTransform;
+    m_nextInput.rightFootVelocity = desiredVelocity;
+    return true;
+}
+
+bool BLFIKThread::setRetargetingJointSetPoint(const iDynTree::VectorDynSize& jointPositions,
+                                              const iDynTree::VectorDynSize& jointVelocities)
+{
+    if (m_decimation == 1)
+        return m_ik.setRetargetingJointSetPoint(jointPositions, jointVelocities);
+
+    m_nextInput.retargetingJointPositions = jointPositions;
+    m_nextInput.retargetingJointVelocities = jointVelocities;
+    return true;
+}
+
+bool BLFIKThread::setRegularizationJointSetPoint(const iDynTree::VectorDynSize& jointPosition)
+{
+    // the regularization is set when the robot is prepared, it is not part of the input
+    std::lock_guard<std::mutex> ikGuard(m_ikMutex);
+    return m_ik.setRegularizationJointSetPoint(jointPosition);
+}
+
+bool BLFIKThread::setCoMSetPoint(const iDynTree::Position& position,
+                                 const iDynTree::Vector3& velocity)
+{
+    if (m_decimation == 1)
+        return m_ik.setCoMSetPoint(position, velocity);
+
+    m_nextInput.comPosition = position;
+    m_nextInput.comVelocity = velocity;
+    return true;
+}
+
+bool BLFIKThread::setRootSetPoint(const iDynTree::Position& position,
+                                  const iDynTree::Vector3& velocity)
+{
+    if (m_decimation == 1)
+        return m_ik.setRootSetPoint(position, velocity);
+
+    m_nextInput.rootPosition = position;
+    m_nextInput.rootVelocity = velocity;
+    return true;
+}
+
+bool BLFIKThread::setTorsoSetPoint(const iDynTree::Rotation& rotation)
+{
+    if (m_decimation == 1)
+        return m_ik.setTorsoSetPoint(rotation);
+
+    m_nextInput.torsoRotation = rotation;
+    return true;
+}
+
+bool BLFIKThread::solve()
+{
+    // single rate, the problem is solved in the calling thread
+    if (m_decimation == 1)
+        return m_ik.solve();
+
+    if (m_ticksSinceInput == 0)
+    {
+        // the state of the robot is copied since the kinematics of the walking module changes
+        // while the thread is solving the problem
+        m_nextInput.floatingBase = m_kinDyn->getFloatingBase();
+        m_kinDyn->getRobotState(m_nextInput.baseTransform,
+                                m_nextInput.jointPositions,
+                                m_nextInput.baseVelocity,
+                                m_nextInput.jointVelocities,
+                                m_nextInput.gravity);
+    }
+
+    bool firstSolution;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (m_solverFailed)
+        {
+            BipedalLocomotion::log()->error("[BLFIKThread::solve] Unable to solve the problem.");
+            return false;
+        }
+
+        if (m_ticksSinceInput == 0)
+        {
+            m_input = m_nextInput;
+            m_newInputAvailable = true;
+        }
+        m_ticksSinceInput = (m_ticksSinceInput + 1) % m_decimation;
+
+        firstSolution = !m_hasSolution;
+    }
+
+    if (firstSolution)
+    {
+        // the first solution is evaluated in the calling thread
+        if (!solveInput())
+        {
+            BipedalLocomotion::log()->error("[BLFIKThread::solve] Unable to solve the problem.");
+            return false;
+        }
+    } else
+        m_conditionVariable.notify_one();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_newSolutionAvailable)
+    {
+        m_previousOutput = firstSolution ? m_solution : m_output;
+        m_latestOutput = m_solution;
+        m_ticksSinceSolution = 0;
+        m_newSolutionAvailable = false;
+    }
+
+    // interpolate the joint velocities
+    m_ticksSinceSolution++;
+    const double alpha = std::min(1.0, static_cast<double>(m_ticksSinceSolution) / m_decimation);
+    iDynTree::toEigen(m_output) = (1 - alpha) * iDynTree::toEigen(m_previousOutput)
+                                  + alpha * iDynTree::toEigen(m_latestOutput);
+
+    return true;
+}
+
+const iDynTree::VectorDynSize& BLFIKThread::getDesiredJointVelocity() const
+{
+    if (m_decimation == 1)
+        return m_ik.getDesiredJointVelocity();
+
+    return m_output;
+}
+
+BLFIK::SolverStatistics BLFIKThread::getSolverStatistics()
+{
+    if (m_decimation == 1)
+        return m_ik.getSolverStatistics();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_statistics;
+}
+
+void BLFIKThread::resetSolverStatistics()
+{
+    if (m_decimation == 1)
+    {
+        m_ik.resetSolverStatistics();
+        return;
+    }
+
+    // the statistics of the solver are reset by the thread before the next solution
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_statistics = BLFIK::SolverStatistics();
+    m_resetStatistics = true;
+}
+
+void BLFIKThread::reset()
+{
+    std::lock_guard<std::mutex> ikGuard(m_ikMutex);
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    m_hasSolution = false;
+    m_newInputAvailable = false;
+    m_newSolutionAvailable = false;
+    m_solverFailed = false;
+    m_ticksSinceInput = 0;
+    m_ticksSinceSolution = 0;
+}
@@ -0,0 +1,291 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <algorithm>
+#include <limits>
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+// Eigen
+#include <Eigen/Geometry>
+
+// iDynTree
+#include <iDynTree/EigenHelpers.h>
+
+#include <WalkingControllers/WholeBodyControllers/DampedLeastSquaresIK.h>
+
+using namespace WalkingControllers;
+
+namespace
+{
+    constexpr int constraintsSize = 9; /**< Rows of the right foot and CoM tasks. */
+    constexpr double minDamping = 1e-9; /**< Minimum damping of the Levenberg-Marquardt iteration. */
+    constexpr double maxDamping = 1e9; /**< Maximum damping of the Levenberg-Marquardt iteration. */
+
+    /**
+     * Rotation error expressed in the world frame, i.e. log(desired * current^T).
+     * @param desired desired rotation;
+     * @param current current rotation;
+     * @param error the rotation error.
+     */
+    void rotationError(const iDynTree::Rotation& desired, const iDynTree::Rotation& current,
+                       Eigen::Ref<Eigen::VectorXd> error)
+    {
+        const Eigen::Matrix3d errorRotation = iDynTree::toEigen(desired) * iDynTree::toEigen(current).transpose();
+        const Eigen::AngleAxisd angleAxis(errorRotation);
+        error = angleAxis.angle() * angleAxis.axis();
+    }
+}
+
+bool DampedLeastSquaresIK::initialize(const iDynTree::Model& model,
+                                      const std::vector<std::string>& joints,
+                                      const std::string& leftFootFrame,
+                                      const std::string& rightFootFrame,
+                                      const std::string& additionalFrame,
+                                      const Parameters& parameters)
+{
+    if(parameters.maxIterations <= 0 || parameters.tolerance <= 0 || parameters.damping <= 0
+       || parameters.constraintsWeight <= 0)
+    {
+        yError() << "[DampedLeastSquaresIK::initialize] The parameters of the solver have to be positive.";
+        return false;
+    }
+    m_parameters = parameters;
+
+    if(!m_kinDyn.loadRobotModel(model))
+    {
+        yError() << "[DampedLeastSquaresIK::initialize] Unable to load the model.";
+        return false;
+    }
+    m_kinDyn.setFrameVelocityRepresentation(iDynTree::MIXED_REPRESENTATION);
+
+    // the left foot is the fixed base and its frame is the world frame
+    const iDynTree::FrameIndex leftFootIndex = model.getFrameIndex(leftFootFrame);
+    if(leftFootIndex == iDynTree::FRAME_INVALID_INDEX)
+    {
+        yError() << "[DampedLeastSquaresIK::initialize] Unable to find the frame named: " << leftFootFrame;
+        return false;
+    }
+    if(!m_kinDyn.setFloatingBase(model.getLinkName(model.getFrameLink(leftFootIndex))))
+    {
+        yError() << "[DampedLeastSquaresIK::initialize] Unable to set the floating base.";
+        return false;
+    }
+    m_baseTransform = model.getFrameTransform(leftFootIndex).inverse();
+
+    m_rightFootIndex = model.getFrameIndex(rightFootFrame);
+    if(m_rightFootIndex == iDynTree::FRAME_INVALID_INDEX)
+    {
+        yError() << "[DampedLeastSquaresIK::initialize] Unable to find the frame named: " << rightFootFrame;
+        return false;
+    }
+
+    m_additionalFrameIndex = iDynTree::FRAME_INVALID_INDEX;
+    if(!additionalFrame.empty())
+    {
+        m_additionalFrameIndex = model.getFrameIndex(additionalFrame);
+        if(m_additionalFrameIndex == iDynTree::FRAME_INVALID_INDEX)
+        {
+            yError() << "[DampedLeastSquaresIK::initialize] Unable to find the frame named: " << additionalFrame;
+            return false;
+        }
+    }
+
+    const int numberOfJoints = joints.size();
+    m_jointsOffset.resize(numberOfJoints);
+    m_lowerLimits.resize(numberOfJoints);
+    m_upperLimits.resize(numberOfJoints);
+    for(int i = 0; i < numberOfJoints; i++)
+    {
+        const iDynTree::JointIndex jointIndex = model.getJointIndex(joints[i]);
+        if(jointIndex == iDynTree::JOINT_INVALID_INDEX
+           || model.getJoint(jointIndex)->getNrOfDOFs() != 1)
+        {
+            yError() << "[DampedLeastSquaresIK::initialize] The joint " << joints[i]
+                     << " is not a joint with one degree of freedom of the model.";
+            return false;
+        }
+
+        iDynTree::IJointConstPtr joint = model.getJoint(jointIndex);
+        m_jointsOffset[i] = joint->getDOFsOffset();
+        m_lowerLimits(i) = -std::numeric_limits<double>::infinity();
+        m_upperLimits(i) = std::numeric_limits<double>::infinity();
+        if(joint->hasPosLimits())
+            joint->getPosLimits(0, m_lowerLimits(i), m_upperLimits(i));
+    }
+
+    m_fullPositions.resize(model.getNrOfDOFs());
+    m_fullPositions.zero();
+    m_fullVelocities.resize(model.getNrOfDOFs());
+    m_fullVelocities.zero();
+    m_baseVelocity.zero();
+    m_gravity.zero();
+
+    const int numberOfTasks = constraintsSize + (m_additionalFrameIndex != iDynTree::FRAME_INVALID_INDEX ? 3 : 0);
+    m_frameJacobian.resize(6, model.getNrOfDOFs() + 6);
+    m_comJacobian.resize(3, model.getNrOfDOFs() + 6);
+    m_jacobian.resize(numberOfTasks, numberOfJoints);
+    m_weightedJacobian.resize(numberOfTasks, numberOfJoints);
+    m_weights.setConstant(numberOfTasks, m_parameters.constraintsWeight);
+    m_error.setZero(numberOfTasks);
+    m_weightedError.resize(numberOfTasks);
+    m_normalMatrix.resize(numberOfJoints, numberOfJoints);
+    m_hessian.resize(numberOfJoints, numberOfJoints);
+    m_gradient.resize(numberOfJoints);
+    m_decomposition = Eigen::LDLT<Eigen::MatrixXd>(numberOfJoints);
+    m_positions.setZero(numberOfJoints);
+    m_candidate.resize(numberOfJoints);
+    m_step.resize(numberOfJoints);
+
+    return true;
+}
+
+void DampedLeastSquaresIK::setPositions(const Eigen::Ref<const Eigen::VectorXd>& positions)
+{
+    for(int i = 0; i < positions.size(); i++)
+        m_fullPositions(m_jointsOffset[i]) = positions(i);
+
+    m_kinDyn.setRobotState(m_baseTransform, m_fullPositions, m_baseVelocity, m_fullVelocities, m_gravity);
+}
+
+double DampedLeastSquaresIK::evaluateError(const iDynTree::Transform& desiredRightTransform,
+                                           const iDynTree::Position& desiredCoMPosition,
+                                           const iDynTree::Rotation& desiredAdditionalRotation,
+                                           const Eigen::Ref<const Eigen::VectorXd>& regularization,
+                                           const double& regularizationWeight)
+{
+    const iDynTree::Transform rightTransform = m_kinDyn.getWorldTransform(m_rightFootIndex);
+    m_error.head<3>() = iDynTree::toEigen(desiredRightTransform.getPosition())
+        - iDynTree::toEigen(rightTransform.getPosition());
+    rotationError(desiredRightTransform.getRotation(), rightTransform.getRotation(), m_error.segment<3>(3));
+
+    m_error.segment<3>(6) = iDynTree::toEigen(desiredCoMPosition)
+        - iDynTree::toEigen(m_kinDyn.getCenterOfMassPosition());
+
+    if(m_additionalFrameIndex != iDynTree::FRAME_INVALID_INDEX)
+        rotationError(desiredAdditionalRotation,
+                      m_kinDyn.getWorldTransform(m_additionalFrameIndex).getRotation(),
+                      m_error.tail<3>());
+
+    m_weightedError = m_weights.cwiseProduct(m_error);
+    return m_error.dot(m_weightedError)
+        + regularizationWeight * (m_candidate - regularization).squaredNorm();
+}
+
+void DampedLeastSquaresIK::evaluateJacobian()
+{
+    // the base is fixed, only the columns of the optimized joints are used
+    m_kinDyn.getFrameFreeFloatingJacobian(m_rightFootIndex, m_frameJacobian);
+    m_kinDyn.getCenterOfMassJacobian(m_comJacobian);
+    for(int i = 0; i < m_jacobian.cols(); i++)
+    {
+        m_jacobian.block<6, 1>(0, i) = iDynTree::toEigen(m_frameJacobian).col(m_jointsOffset[i] + 6);
+        m_jacobian.block<3, 1>(6, i) = iDynTree::toEigen(m_comJacobian).col(m_jointsOffset[i] + 6);
+    }
+
+    if(m_additionalFrameIndex != iDynTree::FRAME_INVALID_INDEX)
+    {
+        m_kinDyn.getFrameFreeFloatingJacobian(m_additionalFrameIndex, m_frameJacobian);
+        for(int i = 0; i < m_jacobian.cols(); i++)
+            m_jacobian.block<3, 1>(constraintsSize, i)
+                = iDynTree::toEigen(m_frameJacobian).block<3, 1>(3, m_jointsOffset[i] + 6);
+    }
+}
+
+bool DampedLeastSquaresIK::solve(const iDynTree::Transform& desiredRightTransform,
+                                 const iDynTree::Position& desiredCoMPosition,
+                                 const iDynTree::Rotation& desiredAdditionalRotation,
+                                 const double& additionalRotationWeight,
+                                 const iDynTree::VectorDynSize& feedback,
+                                 const iDynTree::VectorDynSize& regularization,
+                                 const double& regularizationWeight,
+                                 const iDynTree::VectorDynSize& guess,
+                                 iDynTree::VectorDynSize& solution)
+{
+    if(feedback.size() != m_fullPositions.size() || regularization.size() != m_positions.size()
+       || guess.size() != m_positions.size() || solution.size() != m_positions.size())
+    {
+        yError() << "[DampedLeastSquaresIK::solve] The size of the vectors does not match the number of joints.";
+        return false;
+    }
+
+    m_fullPositions = feedback;
+    if(m_additionalFrameIndex != iDynTree::FRAME_INVALID_INDEX)
+        m_weights.tail<3>().setConstant(additionalRotationWeight);
+
+    const auto desiredPositions = iDynTree::toEigen(regularization);
+
+    // the solver is warm started from the guess
+    m_candidate = iDynTree::toEigen(guess).cwiseMax(m_lowerLimits).cwiseMin(m_upperLimits);
+    setPositions(m_candidate);
+    double cost = evaluateError(desiredRightTransform, desiredCoMPosition, desiredAdditionalRotation,
+                                desiredPositions, regularizationWeight);
+    m_positions = m_candidate;
+    m_constraintsError = m_error.head<constraintsSize>().norm();
+
+    double damping = m_parameters.damping;
+    bool isJacobianUpdated = false;
+    m_iterations = 0;
+    while(m_iterations < m_parameters.maxIterations && m_constraintsError > m_parameters.tolerance)
+    {
+        m_iterations++;
+
+        // the Jacobian and the gradient are evaluated only if the previous step was accepted
+        if(!isJacobianUpdated)
+        {
+            evaluateJacobian();
+            m_weightedJacobian = m_weights.asDiagonal() * m_jacobian;
+            m_normalMatrix.noalias() = m_jacobian.transpose() * m_weightedJacobian;
+            m_gradient.noalias() = m_jacobian.transpose() * m_weightedError;
+            m_gradient -= regularizationWeight * (m_positions - desiredPositions);
+            isJacobianUpdated = true;
+        }
+
+        m_hessian = m_normalMatrix;
+        m_hessian.diagonal().array() += regularizationWeight + damping;
+        m_decomposition.compute(m_hessian);
+        m_step = m_decomposition.solve(m_gradient);
+
+        // the joint limits are enforced clamping the step
+        m_candidate = (m_positions + m_step).cwiseMax(m_lowerLimits).cwiseMin(m_upperLimits);
+        setPositions(m_candidate);
+        const double candidateCost = evaluateError(desiredRightTransform, desiredCoMPosition,
+                                                   desiredAdditionalRotation, desiredPositions,
+                                                   regularizationWeight);
+
+        if(candidateCost < cost)
+        {
+            cost = candidateCost;
+            m_positions = m_candidate;
+            m_constraintsError = m_error.head<constraintsSize>().norm();
+            damping = std::max(damping * 0.1, minDamping);
+            isJacobianUpdated = false;
+        }
+        else
+        {
+            damping = std::min(damping * 10.0, maxDamping);
+        }
+    }
+
+    // as the iDynTree inverse kinematics, the solve fails if the tolerance is not reached. The
+    // best solution found is returned anyway
+    iDynTree::toEigen(solution) = m_positions;
+    return isConverged();
+}
+
+int DampedLeastSquaresIK::getIterations() const
+{
+    return m_iterations;
+}
+
+double DampedLeastSquaresIK::getConstraintsError() const
+{
+    return m_constraintsError;
+}
+
+bool DampedLeastSquaresIK::isConverged() const
+{
+    return m_constraintsError <= m_parameters.tolerance;
+}
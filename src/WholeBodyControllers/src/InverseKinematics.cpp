@@ -20,6 +20,9 @@
 // Eigen
 #include <Eigen/Core>
 
+// std
+#include <algorithm>
+
 #include <WalkingControllers/WholeBodyControllers/InverseKinematics.h>
 
 using namespace WalkingControllers;
@@ -45,6 +48,15 @@ bool WalkingIK::initialize(yarp::os::Searchable& ikOption, const iDynTree::Model
     solverVerbosity = ikOption.check("solver-verbosity",yarp::os::Value(0)).asInt32();
     maxCpuTime = ikOption.check("max-cpu-time",yarp::os::Value(0.2)).asFloat64();
     m_jointRegularizationWeight = ikOption.check("joint_regularization_weight", yarp::os::Value(0.5)).asFloat64();
+    // in verbose mode the errors are printed after each solution
+    m_accuracyMonitorPeriod = ikOption.check("accuracy_monitor_period", yarp::os::Value(m_verbose ? 1 : 0)).asInt32();
+    if(m_accuracyMonitorPeriod < 0)
+    {
+        yError() << "WalkingIK: accuracy_monitor_period is supposed to be non negative.";
+        return false;
+    }
+    m_accuracyMonitorCounter = 0;
+    resetAccuracyStatistics();
     std::string lFootFrame = ikOption.check("left_foot_frame", yarp::os::Value("l_sole")).asString();
     std::string rFootFrame = ikOption.check("right_foot_frame", yarp::os::Value("r_sole")).asString();
     std::string solverName = ikOption.check("solver_name", yarp::os::Value("mumps")).asString();
@@ -150,9 +162,26 @@ bool WalkingIK::initialize(yarp::os::Searchable& ikOption, const iDynTree::Model
         return false;
     }
 
+    if(solverName == "dls")
+    {
+        if(!initializeDLSSolver(ikOption))
+        {
+            yError() << "WalkingIK: Unable to initialize the damped least-squares solver.";
+            return false;
+        }
+    }
+    else
+        m_ik.setLinearSolverName(solverName);
+
     m_ik.setMaxCPUTime(maxCpuTime);
     m_ik.setVerbosity(solverVerbosity);
-    m_ik.setLinearSolverName(solverName);
+
+    m_useLegWarmStart = ikOption.check("leg_ik_warm_start", yarp::os::Value(false)).asBool();
+    if(m_useLegWarmStart && !initializeLegWarmStart(ikOption))
+    {
+        yError() << "WalkingIK: Unable to initialize the closed-form IK of the right leg.";
+        return false;
+    }
 
     if (m_verbose)
     {
@@ -165,6 +194,88 @@ bool WalkingIK::initialize(yarp::os::Searchable& ikOption, const iDynTree::Model
 }
 
 
+bool WalkingIK::initializeDLSSolver(yarp::os::Searchable& ikOption)
+{
+    DampedLeastSquaresIK::Parameters parameters;
+    parameters.maxIterations = ikOption.check("dls_max_iterations", yarp::os::Value(parameters.maxIterations)).asInt32();
+    parameters.tolerance = ikOption.check("dls_tolerance", yarp::os::Value(parameters.tolerance)).asFloat64();
+    parameters.damping = ikOption.check("dls_damping", yarp::os::Value(parameters.damping)).asFloat64();
+    parameters.constraintsWeight = ikOption.check("dls_constraints_weight",
+                                                  yarp::os::Value(parameters.constraintsWeight)).asFloat64();
+
+    // the joints of the reduced model, in the order of the solution
+    const iDynTree::Model& reducedModel = m_ik.reducedModel();
+    std::vector<std::string> joints(reducedModel.getNrOfDOFs());
+    for (iDynTree::JointIndex jointIdx = 0; jointIdx < static_cast<int>(reducedModel.getNrOfJoints()); ++jointIdx)
+    {
+        iDynTree::IJointConstPtr joint = reducedModel.getJoint(jointIdx);
+        if (joint->getNrOfDOFs() == 1)
+            joints[joint->getDOFsOffset()] = reducedModel.getJointName(jointIdx);
+    }
+
+    m_dlsSolver = std::make_unique<DampedLeastSquaresIK>();
+    return m_dlsSolver->initialize(m_ik.fullModel(), joints, m_lFootFrame, m_rFootFrame,
+                                   m_additionalFrame, parameters);
+}
+
+bool WalkingIK::initializeLegWarmStart(yarp::os::Searchable& ikOption)
+{
+    const std::string pelvisFrame = ikOption.check("leg_ik_pelvis_frame", yarp::os::Value("root_link")).asString();
+    yarp::os::Value rightLegJoints = ikOption.find("right_leg_joints");
+    std::vector<std::string> joints{"r_hip_pitch", "r_hip_roll", "r_hip_yaw", "r_knee", "r_ankle_pitch", "r_ankle_roll"};
+    if(!rightLegJoints.isNull())
+    {
+        if(!rightLegJoints.isList() || rightLegJoints.asList()->size() != 6)
+        {
+            yError() << "WalkingIK: right_leg_joints is supposed to be a list of six joints.";
+            return false;
+        }
+        for(size_t i = 0; i < joints.size(); i++)
+            joints[i] = rightLegJoints.asList()->get(i).asString();
+    }
+
+    const iDynTree::Model& reducedModel = m_ik.reducedModel();
+    for(size_t i = 0; i < joints.size(); i++)
+    {
+        iDynTree::JointIndex jointIndex = reducedModel.getJointIndex(joints[i]);
+        if(jointIndex == iDynTree::JOINT_INVALID_INDEX)
+        {
+            yError() << "WalkingIK: The joint" << joints[i] << "is not one of the joints of the IK.";
+            return false;
+        }
+        m_rightLegDOFs[i] = reducedModel.getJoint(jointIndex)->getDOFsOffset();
+    }
+
+    m_legIKPelvisFrameIndex = reducedModel.getFrameIndex(pelvisFrame);
+    if(m_legIKPelvisFrameIndex == iDynTree::FRAME_INVALID_INDEX)
+    {
+        yError() << "WalkingIK: Unable to find the frame named" << pelvisFrame;
+        return false;
+    }
+
+    return m_legIK.initialize(reducedModel, pelvisFrame, m_rFootFrame, joints);
+}
+
+void WalkingIK::warmStartRightLeg(const iDynTree::Transform& desiredRightTransform)
+{
+    // the pelvis of the guess (the left foot is the world frame)
+    lchecker.setRobotState(m_baseTransform, m_guess, dummyBaseVel, dummyVel, dummygrav);
+    const iDynTree::Transform pelvisToFoot = lchecker.getWorldTransform(m_legIKPelvisFrameIndex).inverse() * desiredRightTransform;
+
+    for(size_t i = 0; i < m_rightLegDOFs.size(); i++)
+        m_legReference(i) = m_guess(m_rightLegDOFs[i]);
+
+    if(!m_legIK.solve(pelvisToFoot, m_legReference, m_legSolution))
+    {
+        if (m_verbose)
+            yInfo() << "WalkingIK: The right foot is not reachable from the pelvis of the guess.";
+        return;
+    }
+
+    for(size_t i = 0; i < m_rightLegDOFs.size(); i++)
+        m_guess(m_rightLegDOFs[i]) = m_legSolution(i);
+}
+
 bool WalkingIK::setModel(const iDynTree::Model& model, const std::vector< std::string >& consideredJoints)
 {
     if(!(m_ik.setModel(model,consideredJoints)))
@@ -360,10 +471,9 @@ bool WalkingIK::computeIK(const iDynTree::Transform& leftTransform, const iDynTr
         yInfo() << desiredRightTransform.toString();
     }
 
-    m_ik.updateTarget(m_rFootFrame, desiredRightTransform);
-
+    iDynTree::Rotation additionalRotation = iDynTree::Rotation::Identity();
     if(m_additionalFrame.size() != 0){
-        m_ik.updateRotationTarget(m_additionalFrame, leftTransform.getRotation().inverse() * m_inertial_R_world.inverse() * m_additionalRotation, m_additionalRotationWeight);
+        additionalRotation = leftTransform.getRotation().inverse() * m_inertial_R_world.inverse() * m_additionalRotation;
     }
 
     desiredCoMPosition = leftTransform.inverse() * comPosition;
@@ -374,35 +484,78 @@ bool WalkingIK::computeIK(const iDynTree::Transform& leftTransform, const iDynTr
         yInfo() << desiredCoMPosition.toString();
     }
 
-    m_ik.setCOMTarget(desiredCoMPosition, 100.0);
+    if(m_useLegWarmStart)
+        warmStartRightLeg(desiredRightTransform);
 
-    ok = m_ik.setCurrentRobotConfiguration(m_baseTransform,m_feedback);
-    if(!ok){
-        yError() << "WalkingIK: Error while setting the feedback.";
-        return false;
-    }
+    if(m_dlsSolver)
+    {
+        ok = m_dlsSolver->solve(desiredRightTransform, desiredCoMPosition, additionalRotation,
+                                m_additionalRotationWeight, m_feedback, m_jointRegularization,
+                                m_jointRegularizationWeight, m_guess, m_qResult);
+        if(!ok){
+            yError() << "WalkingIK: Failed in finding a solution.";
+            return false;
+        }
 
-    ok = m_ik.setReducedInitialCondition(&m_baseTransform, &m_guess);
-    if(!ok){
-        yError() << "WalkingIK: Error while setting the guess.";
-        return false;
+        if (m_verbose) {
+            yInfo() << "Iterations: " << m_dlsSolver->getIterations();
+            yInfo() << "Constraints error: " << m_dlsSolver->getConstraintsError();
+        }
     }
+    else
+    {
+        m_ik.updateTarget(m_rFootFrame, desiredRightTransform);
 
-    ok = m_ik.setDesiredReducedJointConfiguration(m_jointRegularization, m_jointRegularizationWeight);
-    if(!ok){
-        yError() << "WalkingIK: Error while setting the desired joint configuration.";
-        return false;
-    }
+        if(m_additionalFrame.size() != 0){
+            m_ik.updateRotationTarget(m_additionalFrame, additionalRotation, m_additionalRotationWeight);
+        }
 
-    ok = m_ik.solve();
+        m_ik.setCOMTarget(desiredCoMPosition, 100.0);
 
-    if(!ok){
-        yError() << "WalkingIK: Failed in finding a solution.";
-        return false;
+        ok = m_ik.setCurrentRobotConfiguration(m_baseTransform,m_feedback);
+        if(!ok){
+            yError() << "WalkingIK: Error while setting the feedback.";
+            return false;
+        }
+
+        ok = m_ik.setReducedInitialCondition(&m_baseTransform, &m_guess);
+        if(!ok){
+            yError() << "WalkingIK: Error while setting the guess.";
+            return false;
+        }
+
+        ok = m_ik.setDesiredReducedJointConfiguration(m_jointRegularization, m_jointRegularizationWeight);
+        if(!ok){
+            yError() << "WalkingIK: Error while setting the desired joint configuration.";
+            return false;
+        }
+
+        ok = m_ik.solve();
+
+        if(!ok){
+            yError() << "WalkingIK: Failed in finding a solution.";
+            return false;
+        }
+
+        m_ik.getReducedSolution(baseTransform, m_qResult);
+    }
+
+    // the accuracy of the solution is checked only every m_accuracyMonitorPeriod solutions
+    if(m_accuracyMonitorPeriod > 0 && ++m_accuracyMonitorCounter >= m_accuracyMonitorPeriod)
+    {
+        m_accuracyMonitorCounter = 0;
+        monitorAccuracy(desiredRightTransform, desiredCoMPosition);
     }
 
-    m_ik.getReducedSolution(baseTransform, m_qResult);
+    result = m_qResult;
+    m_guess = m_qResult;
+
+    return true;
+}
 
+void WalkingIK::monitorAccuracy(const iDynTree::Transform& desiredRightTransform,
+                                const iDynTree::Position& desiredCoMPosition)
+{
     lchecker.setRobotState(m_baseTransform, m_qResult, dummyBaseVel, dummyVel,dummygrav);
 
     iDynTree::Position comError = desiredCoMPosition - lchecker.getCenterOfMassPosition();
@@ -413,10 +566,21 @@ bool WalkingIK::computeIK(const iDynTree::Transform& leftTransform, const iDynTr
         yInfo() << "Foot position error: "<<footError.toString();
     }
 
-    result = m_qResult;
-    m_guess = m_qResult;
+    m_accuracyStatistics.samples++;
+    m_accuracyStatistics.lastCoMError = iDynTree::toEigen(comError).norm();
+    m_accuracyStatistics.lastFootError = iDynTree::toEigen(footError).norm();
+    m_accuracyStatistics.maxCoMError = std::max(m_accuracyStatistics.maxCoMError, m_accuracyStatistics.lastCoMError);
+    m_accuracyStatistics.maxFootError = std::max(m_accuracyStatistics.maxFootError, m_accuracyStatistics.lastFootError);
+}
 
-    return true;
+const WalkingIK::AccuracyStatistics& WalkingIK::getAccuracyStatistics() const
+{
+    return m_accuracyStatistics;
+}
+
+void WalkingIK::resetAccuracyStatistics()
+{
+    m_accuracyStatistics = AccuracyStatistics();
 }
 
 const std::string WalkingIK::getLeftFootFrame() const
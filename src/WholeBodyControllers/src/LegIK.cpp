@@ -0,0 +1,354 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+// Eigen
+#include <Eigen/Geometry>
+
+// iDynTree
+#include <iDynTree/EigenHelpers.h>
+#include <iDynTree/KinDynComputations.h>
+#include <iDynTree/MatrixDynSize.h>
+#include <iDynTree/VectorDynSize.h>
+
+#include <WalkingControllers/WholeBodyControllers/LegIK.h>
+
+using namespace WalkingControllers;
+
+namespace
+{
+    constexpr std::size_t kneeJoint = 3; /**< Index of the knee in the leg. */
+
+    /**
+     * Paden-Kahan subproblem 1: angle of the rotation about an axis that moves p to q.
+     * @param axis direction of the axis;
+     * @param point point of the axis;
+     * @param p initial point;
+     * @param q final point.
+     * @return the rotation angle.
+     */
+    double rotationAngle(const Eigen::Vector3d& axis, const Eigen::Vector3d& point,
+                         const Eigen::Vector3d& p, const Eigen::Vector3d& q)
+    {
+        const Eigen::Vector3d u = p - point;
+        const Eigen::Vector3d v = q - point;
+        const Eigen::Vector3d uProjection = u - axis * axis.dot(u);
+        const Eigen::Vector3d vProjection = v - axis * axis.dot(v);
+        return std::atan2(axis.dot(uProjection.cross(vProjection)), uProjection.dot(vProjection));
+    }
+
+    /**
+     * Paden-Kahan subproblem 2: angles of two rotations about intersecting axes such that
+     * exp(first * angle1) * exp(second * angle2) * p = q.
+     * @param first direction of the first axis;
+     * @param second direction of the second axis;
+     * @param point intersection of the axes;
+     * @param p initial point;
+     * @param q final point;
+     * @param angles the two solutions (angle1, angle2). If the problem has no solution the
+     * closest one is returned twice.
+     */
+    void twoRotationsAngles(const Eigen::Vector3d& first, const Eigen::Vector3d& second,
+                            const Eigen::Vector3d& point, const Eigen::Vector3d& p,
+                            const Eigen::Vector3d& q, std::array<Eigen::Vector2d, 2>& angles)
+    {
+        const Eigen::Vector3d u = p - point;
+        const Eigen::Vector3d v = q - point;
+        const double cosine = first.dot(second);
+        const double denominator = cosine * cosine - 1;
+        const double alpha = (cosine * second.dot(u) - first.dot(v)) / denominator;
+        const double beta = (cosine * first.dot(v) - second.dot(u)) / denominator;
+        const Eigen::Vector3d cross = first.cross(second);
+        const double gammaSquared = (u.squaredNorm() - alpha * alpha - beta * beta
+                                     - 2 * alpha * beta * cosine) / cross.squaredNorm();
+        const double gamma = std::sqrt(std::max(gammaSquared, 0.0));
+
+        for (std::size_t i = 0; i < 2; i++)
+        {
+            const Eigen::Vector3d intermediate = point + alpha * first + beta * second
+                + (i == 0 ? gamma : -gamma) * cross;
+            angles[i](0) = rotationAngle(first, point, intermediate, q);
+            angles[i](1) = rotationAngle(second, point, p, intermediate);
+        }
+    }
+
+    /**
+     * Paden-Kahan subproblem 3: angles of the rotation about an axis such that the distance
+     * between the rotated p and q is equal to distance.
+     * @param axis direction of the axis;
+     * @param point point of the axis;
+     * @param p initial point;
+     * @param q reference point;
+     * @param distance desired distance;
+     * @param angles the two solutions. If the problem has no solution the closest one is
+     * returned twice.
+     */
+    void distanceAngles(const Eigen::Vector3d& axis, const Eigen::Vector3d& point,
+                        const Eigen::Vector3d& p, const Eigen::Vector3d& q,
+                        const double& distance, Eigen::Vector2d& angles)
+    {
+        const Eigen::Vector3d u = p - point;
+        const Eigen::Vector3d v = q - point;
+        const Eigen::Vector3d uProjection = u - axis * axis.dot(u);
+        const Eigen::Vector3d vProjection = v - axis * axis.dot(v);
+        const double axialDistance = axis.dot(p - q);
+        const double projectedDistanceSquared = distance * distance - axialDistance * axialDistance;
+
+        const double angle = std::atan2(axis.dot(uProjection.cross(vProjection)), uProjection.dot(vProjection));
+        const double cosine = (uProjection.squaredNorm() + vProjection.squaredNorm() - projectedDistanceSquared)
+            / (2 * uProjection.norm() * vProjection.norm());
+        const double offset = std::acos(std::min(std::max(cosine, -1.0), 1.0));
+        angles(0) = angle + offset;
+        angles(1) = angle - offset;
+    }
+
+    /**
+     * Closest point to a set of lines.
+     * @param joints the joints whose axes are the lines;
+     * @param first index of the first joint;
+     * @param last index of the last joint;
+     * @param tolerance maximum distance between the point and the lines.
+     * @param center the point.
+     * @return true if the distance of the point from all the lines is smaller than the tolerance.
+     */
+    template <typename Joints>
+    bool intersection(const Joints& joints, const std::size_t& first, const std::size_t& last,
+                      const double& tolerance, Eigen::Vector3d& center)
+    {
+        Eigen::Matrix3d matrix = Eigen::Matrix3d::Zero();
+        Eigen::Vector3d vector = Eigen::Vector3d::Zero();
+        for (std::size_t i = first; i <= last; i++)
+        {
+            const Eigen::Matrix3d projection = Eigen::Matrix3d::Identity() - joints[i].axis * joints[i].axis.transpose();
+            matrix += projection;
+            vector += projection * joints[i].point;
+        }
+        center = matrix.colPivHouseholderQr().solve(vector);
+
+        for (std::size_t i = first; i <= last; i++)
+        {
+            const Eigen::Vector3d distance = center - joints[i].point;
+            if ((distance - joints[i].axis * joints[i].axis.dot(distance)).norm() > tolerance)
+                return false;
+        }
+        return true;
+    }
+}
+
+Eigen::Isometry3d LegIK::jointTransform(const std::size_t& joint, const double& angle) const
+{
+    Eigen::Isometry3d transform = Eigen::Isometry3d::Identity();
+    transform.linear() = Eigen::AngleAxisd(angle, m_joints[joint].axis).toRotationMatrix();
+    transform.translation() = m_joints[joint].point - transform.linear() * m_joints[joint].point;
+    return transform;
+}
+
+bool LegIK::initialize(const iDynTree::Model& model,
+                       const std::string& pelvisFrame,
+                       const std::string& footFrame,
+                       const std::vector<std::string>& joints,
+                       const double& tolerance)
+{
+    m_isInitialized = false;
+    m_tolerance = tolerance;
+
+    if (joints.size() != m_joints.size())
+    {
+        yError() << "[LegIK::initialize] The leg is supposed to have six joints.";
+        return false;
+    }
+
+    const iDynTree::FrameIndex pelvisIndex = model.getFrameIndex(pelvisFrame);
+    const iDynTree::FrameIndex footIndex = model.getFrameIndex(footFrame);
+    if (pelvisIndex == iDynTree::FRAME_INVALID_INDEX || footIndex == iDynTree::FRAME_INVALID_INDEX)
+    {
+        yError() << "[LegIK::initialize] Unable to find the frames " << pelvisFrame << " and " << footFrame;
+        return false;
+    }
+
+    // the axes are taken from the Jacobian of the foot in the zero configuration, with the
+    // pelvis frame as world frame
+    iDynTree::KinDynComputations kinDyn;
+    if (!kinDyn.loadRobotModel(model)
+        || !kinDyn.setFloatingBase(model.getLinkName(model.getFrameLink(pelvisIndex))))
+    {
+        yError() << "[LegIK::initialize] Unable to load the model.";
+        return false;
+    }
+    kinDyn.setFrameVelocityRepresentation(iDynTree::MIXED_REPRESENTATION);
+
+    iDynTree::VectorDynSize zero(model.getNrOfDOFs());
+    zero.zero();
+    iDynTree::Vector3 gravity;
+    gravity.zero();
+    kinDyn.setRobotState(model.getFrameTransform(pelvisIndex).inverse(), zero, iDynTree::Twist::Zero(),
+                         zero, gravity);
+
+    iDynTree::MatrixDynSize jacobian(6, model.getNrOfDOFs() + 6);
+    kinDyn.getFrameFreeFloatingJacobian(footIndex, jacobian);
+    const iDynTree::Transform footTransform = kinDyn.getWorldTransform(footIndex);
+    const Eigen::Vector3d footPosition = iDynTree::toEigen(footTransform.getPosition());
+
+    for (std::size_t i = 0; i < m_joints.size(); i++)
+    {
+        const iDynTree::JointIndex jointIndex = model.getJointIndex(joints[i]);
+        if (jointIndex == iDynTree::JOINT_INVALID_INDEX || model.getJoint(jointIndex)->getNrOfDOFs() != 1)
+        {
+            yError() << "[LegIK::initialize] The joint " << joints[i]
+                     << " is not a joint with one degree of freedom of the model.";
+            return false;
+        }
+
+        iDynTree::IJointConstPtr joint = model.getJoint(jointIndex);
+        const int column = joint->getDOFsOffset() + 6;
+        const Eigen::Vector3d angular = iDynTree::toEigen(jacobian).block<3, 1>(3, column);
+        const Eigen::Vector3d linear = iDynTree::toEigen(jacobian).block<3, 1>(0, column);
+
+        // the angular velocity of a revolute joint that moves the foot has unit norm
+        if (std::abs(angular.norm() - 1.0) > 1e-6)
+        {
+            yError() << "[LegIK::initialize] The joint " << joints[i] << " is not a revolute joint between "
+                     << pelvisFrame << " and " << footFrame;
+            return false;
+        }
+
+        m_joints[i].axis = angular;
+        m_joints[i].point = footPosition + angular.cross(linear);
+        m_joints[i].lowerLimit = -std::numeric_limits<double>::infinity();
+        m_joints[i].upperLimit = std::numeric_limits<double>::infinity();
+        if (joint->hasPosLimits())
+            joint->getPosLimits(0, m_joints[i].lowerLimit, m_joints[i].upperLimit);
+    }
+
+    if (m_joints[0].axis.cross(m_joints[1].axis).norm() < 1e-6
+        || m_joints[4].axis.cross(m_joints[5].axis).norm() < 1e-6)
+    {
+        yError() << "[LegIK::initialize] The first two hip axes and the ankle axes cannot be parallel.";
+        return false;
+    }
+
+    if (!intersection(m_joints, 0, 2, m_tolerance, m_hipCenter)
+        || !intersection(m_joints, 4, 5, m_tolerance, m_ankleCenter))
+    {
+        yError() << "[LegIK::initialize] The hip axes and the ankle axes are supposed to intersect.";
+        return false;
+    }
+
+    m_zeroTransform = Eigen::Isometry3d::Identity();
+    m_zeroTransform.linear() = iDynTree::toEigen(footTransform.getRotation());
+    m_zeroTransform.translation() = footPosition;
+
+    m_isInitialized = true;
+    return true;
+}
+
+iDynTree::Transform LegIK::forwardKinematics(const Eigen::Ref<const Eigen::VectorXd>& positions) const
+{
+    Eigen::Isometry3d transform = Eigen::Isometry3d::Identity();
+    for (std::size_t i = 0; i < m_joints.size(); i++)
+        transform = transform * jointTransform(i, positions(i));
+    transform = transform * m_zeroTransform;
+
+    iDynTree::Transform pelvisToFoot;
+    iDynTree::Rotation rotation;
+    iDynTree::toEigen(rotation) = transform.linear();
+    iDynTree::Position position;
+    iDynTree::toEigen(position) = transform.translation();
+    pelvisToFoot.setRotation(rotation);
+    pelvisToFoot.setPosition(position);
+    return pelvisToFoot;
+}
+
+bool LegIK::solve(const iDynTree::Transform& pelvisToFoot,
+                  const Eigen::Ref<const Eigen::VectorXd>& reference,
+                  Eigen::Ref<Eigen::VectorXd> solution) const
+{
+    if (!m_isInitialized || reference.size() != 6 || solution.size() != 6)
+    {
+        yError() << "[LegIK::solve] The solver is not initialized or the size of the vectors is not six.";
+        return false;
+    }
+
+    Eigen::Isometry3d desired = Eigen::Isometry3d::Identity();
+    desired.linear() = iDynTree::toEigen(pelvisToFoot.getRotation());
+    desired.translation() = iDynTree::toEigen(pelvisToFoot.getPosition());
+
+    // product of the exponentials of the joints
+    const Eigen::Isometry3d joints = desired * m_zeroTransform.inverse();
+    const Eigen::Isometry3d jointsInverse = joints.inverse();
+
+    // the hip and the ankle rotations do not change the distance between the hip and the ankle
+    Eigen::Vector2d kneeAngles;
+    distanceAngles(m_joints[kneeJoint].axis, m_joints[kneeJoint].point, m_ankleCenter, m_hipCenter,
+                   (joints * m_ankleCenter - m_hipCenter).norm(), kneeAngles);
+
+    const Eigen::Vector3d hipAxisPoint = m_hipCenter + m_joints[2].axis;
+    const Eigen::Vector3d hipNormalPoint = m_hipCenter + m_joints[2].axis.unitOrthogonal();
+
+    Eigen::Matrix<double, 6, 1> candidate;
+    double bestDistance = std::numeric_limits<double>::infinity();
+    std::array<Eigen::Vector2d, 2> ankleAngles;
+    std::array<Eigen::Vector2d, 2> hipAngles;
+    for (std::size_t knee = 0; knee < 2; knee++)
+    {
+        candidate(3) = kneeAngles(knee);
+
+        // the inverse of the ankle rotations moves the hip center as the inverse of the joints
+        twoRotationsAngles(m_joints[5].axis, m_joints[4].axis, m_ankleCenter,
+                           jointTransform(kneeJoint, -candidate(3)) * m_hipCenter,
+                           jointsInverse * m_hipCenter, ankleAngles);
+
+        for (std::size_t ankle = 0; ankle < 2; ankle++)
+        {
+            candidate(5) = -ankleAngles[ankle](0);
+            candidate(4) = -ankleAngles[ankle](1);
+
+            // rotation of the hip
+            const Eigen::Isometry3d hip = joints * (jointTransform(3, candidate(3)) * jointTransform(4, candidate(4))
+                                                    * jointTransform(5, candidate(5))).inverse();
+            twoRotationsAngles(m_joints[0].axis, m_joints[1].axis, m_hipCenter, hipAxisPoint,
+                               hip * hipAxisPoint, hipAngles);
+
+            for (std::size_t hipSolution = 0; hipSolution < 2; hipSolution++)
+            {
+                candidate(0) = hipAngles[hipSolution](0);
+                candidate(1) = hipAngles[hipSolution](1);
+                const Eigen::Isometry3d firstHipJoints = jointTransform(0, candidate(0)) * jointTransform(1, candidate(1));
+                candidate(2) = rotationAngle(m_joints[2].axis, m_hipCenter, hipNormalPoint,
+                                             firstHipJoints.inverse() * (hip * hipNormalPoint));
+
+                // the angles are moved to the closest turn of the reference
+                bool isValid = true;
+                for (std::size_t i = 0; i < 6; i++)
+                {
+                    candidate(i) += 2 * M_PI * std::round((reference(i) - candidate(i)) / (2 * M_PI));
+                    isValid = isValid && candidate(i) >= m_joints[i].lowerLimit - m_tolerance
+                        && candidate(i) <= m_joints[i].upperLimit + m_tolerance;
+                }
+
+                const double distance = (candidate - reference).norm();
+                if (!isValid || distance >= bestDistance)
+                    continue;
+
+                // the candidate has to reach the desired pose (the target may be out of reach)
+                const iDynTree::Transform reached = forwardKinematics(candidate);
+                const double positionError = (iDynTree::toEigen(reached.getPosition()) - desired.translation()).norm();
+                const Eigen::AngleAxisd rotationError(iDynTree::toEigen(reached.getRotation()).transpose() * desired.linear());
+                if (positionError > 10 * m_tolerance || std::abs(rotationError.angle()) > 10 * m_tolerance)
+                    continue;
+
+                bestDistance = distance;
+                solution = candidate;
+            }
+        }
+    }
+
+    return bestDistance < std::numeric_limits<double>::infinity();
+}
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <WalkingControllers/StdUtilities/AllocationTracker.h>
+#include <WalkingControllers/StdUtilities/StageProfiler.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace WalkingControllers::StdUtilities;
+
+TEST_CASE("Check AllocationTracker", "[AllocationTracker]") {
+  // the interposer is compiled in the test
+  REQUIRE(AllocationTracker::isEnabled());
+  AllocationTracker::setPolicy(AllocationTracker::Policy::Count);
+
+  AllocationTracker::Counters before = AllocationTracker::getCounters();
+  auto value = std::make_unique<double>(1.0);
+  std::vector<double> vector(100);
+  AllocationTracker::Counters after = AllocationTracker::getCounters();
+  REQUIRE(after.allocations - before.allocations == 2);
+  REQUIRE(after.bytes - before.bytes >= sizeof(double) * 101);
+
+#if defined(__GLIBC__)
+  // with glibc also the C allocation functions are counted
+  before = AllocationTracker::getCounters();
+  char* copy = strdup("walking");
+  after = AllocationTracker::getCounters();
+  std::free(copy);
+  REQUIRE(after.allocations - before.allocations == 1);
+#endif
+
+  // the allocations of the other threads are not counted
+  before = AllocationTracker::getCounters();
+  std::thread worker([] {
+    std::vector<double> workerVector(100);
+  });
+  const AllocationTracker::Counters beforeJoin = AllocationTracker::getCounters();
+  worker.join();
+  REQUIRE(AllocationTracker::getCounters().allocations == beforeJoin.allocations);
+
+  // allocations in a no-allocation scope
+  const std::uint64_t violations = AllocationTracker::getViolations();
+  {
+    AllocationTracker::ScopedForbid noAllocation;
+    vector.resize(50);
+    vector.resize(1000);
+    {
+      AllocationTracker::ScopedAllow allow;
+      vector.resize(2000);
+    }
+  }
+  {
+    AllocationTracker::ScopedForbid inactive(false);
+    vector.resize(3000);
+  }
+  REQUIRE(AllocationTracker::getViolations() - violations == 1);
+}
+
+TEST_CASE("Check StageProfiler allocations", "[AllocationTracker]") {
+  StageProfiler profiler;
+  const size_t allocating = profiler.addStage("allocating");
+  const size_t notAllocating = profiler.addStage("not_allocating");
+
+  std::vector<std::unique_ptr<int>> pointers;
+  pointers.reserve(10);
+  for (int i = 0; i < 4; i++) {
+    {
+      auto timer = profiler.scopedTimer(allocating);
+      pointers.push_back(std::make_unique<int>(i));
+      if (i == 3)
+        pointers.push_back(std::make_unique<int>(i));
+    }
+    {
+      auto timer = profiler.scopedTimer(notAllocating);
+      pointers.back().reset();
+    }
+  }
+
+  StageProfiler::Statistics statistics = profiler.getStatistics(allocating);
+  REQUIRE(statistics.allocations == 5.0 / 4.0);
+  REQUIRE(statistics.maxAllocations == 2);
+
+  statistics = profiler.getStatistics(notAllocating);
+  REQUIRE(statistics.allocations == 0);
+  REQUIRE(statistics.maxAllocations == 0);
+
+  profiler.reset();
+  REQUIRE(profiler.getStatistics(allocating).maxAllocations == 0);
+}
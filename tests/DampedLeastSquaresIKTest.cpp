@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <string>
+#include <vector>
+
+// iDynTree
+#include <iDynTree/EigenHelpers.h>
+#include <iDynTree/KinDynComputations.h>
+#include <iDynTree/Model.h>
+
+#include <WalkingControllers/WholeBodyControllers/DampedLeastSquaresIK.h>
+#include <catch2/catch_test_macros.hpp>
+
+#include "LegsModel.h"
+
+using namespace WalkingControllers;
+
+TEST_CASE("Check DampedLeastSquaresIK", "[DampedLeastSquaresIK]") {
+  std::vector<std::string> joints;
+  const iDynTree::Model model = legsModel(joints);
+
+  DampedLeastSquaresIK::Parameters parameters;
+  parameters.maxIterations = 50;
+  DampedLeastSquaresIK solver;
+  REQUIRE(solver.initialize(model, joints, "l_sole", "r_sole", "", parameters));
+
+  // the targets are the ones of a reachable configuration (legs bent, right foot forward)
+  iDynTree::VectorDynSize target(model.getNrOfDOFs());
+  target.zero();
+  target(1) = 0.2; target(2) = -0.4; target(3) = 0.2;
+  target(8) = -0.3; target(9) = 0.4; target(10) = -0.1;
+
+  iDynTree::KinDynComputations kinDyn;
+  REQUIRE(kinDyn.loadRobotModel(model));
+  iDynTree::VectorDynSize zero(model.getNrOfDOFs());
+  zero.zero();
+  iDynTree::Vector3 gravity;
+  gravity.zero();
+  REQUIRE(kinDyn.setRobotState(iDynTree::Transform::Identity(), target, iDynTree::Twist::Zero(), zero, gravity));
+  const iDynTree::Transform desiredRightTransform = kinDyn.getWorldTransform("r_sole");
+  const iDynTree::Position desiredCoMPosition = kinDyn.getCenterOfMassPosition();
+
+  // the solver is warm started with the knees bent (the stretched legs are singular)
+  iDynTree::VectorDynSize guess(model.getNrOfDOFs());
+  guess.zero();
+  guess(1) = 0.1; guess(2) = -0.2; guess(3) = 0.1;
+  guess(8) = -0.1; guess(9) = 0.2; guess(10) = -0.1;
+
+  iDynTree::VectorDynSize solution(model.getNrOfDOFs());
+  REQUIRE(solver.solve(desiredRightTransform, desiredCoMPosition, iDynTree::Rotation::Identity(), 0.0,
+                       zero, zero, 1e-6, guess, solution));
+  REQUIRE(solver.isConverged());
+  REQUIRE(solver.getIterations() <= parameters.maxIterations);
+
+  REQUIRE(kinDyn.setRobotState(iDynTree::Transform::Identity(), solution, iDynTree::Twist::Zero(), zero, gravity));
+  const iDynTree::Transform rightTransform = kinDyn.getWorldTransform("r_sole");
+  REQUIRE((iDynTree::toEigen(rightTransform.getPosition())
+           - iDynTree::toEigen(desiredRightTransform.getPosition())).norm() < 1e-4);
+  REQUIRE((iDynTree::toEigen(kinDyn.getCenterOfMassPosition())
+           - iDynTree::toEigen(desiredCoMPosition)).norm() < 1e-4);
+
+  // an unreachable target is not reached and the solve fails, the joint limits are always satisfied
+  const iDynTree::Transform farRightTransform(iDynTree::Rotation::Identity(), iDynTree::Position(2.0, 0.0, 0.0));
+  REQUIRE_FALSE(solver.solve(farRightTransform, desiredCoMPosition, iDynTree::Rotation::Identity(), 0.0,
+                       zero, zero, 1e-6, solution, solution));
+  REQUIRE_FALSE(solver.isConverged());
+  REQUIRE(solver.getIterations() == parameters.maxIterations);
+  REQUIRE(iDynTree::toEigen(solution).cwiseAbs().maxCoeff() <= 1.5);
+
+  // the vectors have to match the number of joints
+  iDynTree::VectorDynSize wrongSize(3);
+  REQUIRE_FALSE(solver.solve(desiredRightTransform, desiredCoMPosition, iDynTree::Rotation::Identity(), 0.0,
+                             zero, zero, 1e-6, wrongSize, solution));
+}
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <WalkingControllers/StdUtilities/DeadlineWatchdog.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace WalkingControllers::StdUtilities;
+
+TEST_CASE("Check DeadlineWatchdog", "[DeadlineWatchdog]") {
+  DeadlineWatchdog watchdog;
+  REQUIRE_FALSE(watchdog.initialize(0.01, 1.0, 10, {3, 2}, 2));
+  REQUIRE_FALSE(watchdog.initialize(0.01, 1.0, 10, {2, 11}, 2));
+  REQUIRE(watchdog.initialize(0.01, 1.0, 10, {2, 4, 6}, 2));
+
+  // ticks shorter than the period do not change the level
+  for (int i = 0; i < 20; i++) {
+    REQUIRE_FALSE(watchdog.update(0.005));
+  }
+  REQUIRE(watchdog.getLevel() == 0);
+
+  // two overruns reach the first level
+  REQUIRE_FALSE(watchdog.update(0.02));
+  REQUIRE(watchdog.update(0.02));
+  REQUIRE(watchdog.getLevel() == 1);
+  REQUIRE(watchdog.getOverruns() == 2);
+
+  // the first level is left when the overruns exit from the window
+  for (int i = 0; i < 8; i++) {
+    REQUIRE_FALSE(watchdog.update(0.005));
+  }
+  REQUIRE(watchdog.update(0.005));
+  REQUIRE(watchdog.getLevel() == 0);
+
+  // the second level is sticky
+  for (int i = 0; i < 4; i++) {
+    watchdog.update(0.02);
+  }
+  REQUIRE(watchdog.getLevel() == 2);
+  for (int i = 0; i < 20; i++) {
+    REQUIRE_FALSE(watchdog.update(0.005));
+  }
+  REQUIRE(watchdog.getLevel() == 2);
+  REQUIRE(watchdog.getTotalOverruns() == 6);
+  REQUIRE(watchdog.getMaxDuration() == 0.02);
+
+  watchdog.reset();
+  REQUIRE(watchdog.getLevel() == 0);
+  REQUIRE(watchdog.getTotalOverruns() == 0);
+}
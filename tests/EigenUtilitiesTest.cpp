@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <WalkingControllers/EigenUtilities/BoundedIntegrator.h>
+#include <WalkingControllers/EigenUtilities/FilterBank.h>
+#include <WalkingControllers/EigenUtilities/Integrator.h>
+#include <WalkingControllers/EigenUtilities/MinimumJerkTrajectory.h>
+#include <WalkingControllers/EigenUtilities/VelocityEstimator.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace WalkingControllers::EigenUtilities;
+
+TEST_CASE("Check Integrator", "[Integrator]") {
+  Integrator<2> integrator;
+  REQUIRE_FALSE(integrator.initialize(0.0));
+
+  const double samplingTime = 0.01;
+  REQUIRE(integrator.initialize(samplingTime, Eigen::Vector2d(1.0, -1.0)));
+
+  // the integral of a constant signal is a ramp (the first step averages with a zero input)
+  const Eigen::Vector2d input(2.0, 3.0);
+  for (int i = 0; i < 100; i++)
+    integrator.integrate(input);
+
+  const Eigen::Vector2d expected =
+      Eigen::Vector2d(1.0, -1.0) + input * (100 - 0.5) * samplingTime;
+  REQUIRE(integrator.get().isApprox(expected));
+
+  integrator.reset(Eigen::Vector2d::Zero());
+  REQUIRE(integrator.get().isZero());
+}
+
+TEST_CASE("Check MinimumJerkTrajectory", "[MinimumJerkTrajectory]") {
+  MinimumJerkTrajectory<2> trajectory;
+  REQUIRE_FALSE(trajectory.initialize(0.01, 0.0));
+
+  const double samplingTime = 0.01;
+  const double smoothingTime = 1.0;
+  REQUIRE(trajectory.initialize(samplingTime, smoothingTime, Eigen::Vector2d::Zero()));
+
+  // the trajectory has to converge to the target
+  const Eigen::Vector2d target(1.0, -2.0);
+  for (int i = 0; i < 5 * smoothingTime / samplingTime; i++)
+    trajectory.computeNextValues(target);
+
+  REQUIRE((trajectory.getPosition() - target).norm() < 1e-3);
+  REQUIRE(trajectory.getVelocity().norm() < 1e-2);
+}
+
+TEST_CASE("Check BoundedIntegrator", "[BoundedIntegrator]") {
+  BoundedIntegrator<Eigen::Dynamic> integrator;
+  const Eigen::Vector3d lowerLimits(-1.0, -1.0, -1.0);
+  const Eigen::Vector3d upperLimits(1.0, 1.0, 0.5);
+  REQUIRE_FALSE(integrator.initialize(0.0, lowerLimits, upperLimits));
+  REQUIRE_FALSE(integrator.initialize(0.01, upperLimits, lowerLimits));
+
+  const double samplingTime = 0.01;
+  REQUIRE(integrator.initialize(samplingTime, lowerLimits, upperLimits));
+
+  // without saturations it is the trapezoidal integrator, the integral stays within the limits
+  integrator.reset(Eigen::Vector3d(0.0, 0.0, 0.4));
+  const Eigen::Vector3d input(0.5, -0.5, 1.0);
+  for (int i = 0; i < 100; i++)
+    integrator.integrate(input);
+
+  REQUIRE(integrator.get().head<2>().isApprox(input.head<2>() * (100 - 0.5) * samplingTime));
+  REQUIRE(integrator.get()(2) == upperLimits(2));
+
+  // the input is saturated and its variation is bounded
+  REQUIRE_FALSE(integrator.setVelocityLimits(Eigen::Vector2d(0.1, 0.1)));
+  REQUIRE(integrator.setVelocityLimits(Eigen::Vector3d(0.1, 0.1, 0.1)));
+  REQUIRE(integrator.setAccelerationLimits(Eigen::Vector3d(1.0, 1.0, 1.0)));
+  integrator.reset(Eigen::Vector3d::Zero());
+
+  const Eigen::Vector3d largeInput(5.0, -5.0, 0.05);
+  integrator.integrate(largeInput);
+  REQUIRE(integrator.getInput().isApprox(Eigen::Vector3d(0.01, -0.01, 0.01)));
+
+  for (int i = 0; i < 100; i++)
+    integrator.integrate(largeInput);
+  REQUIRE(integrator.getInput().isApprox(Eigen::Vector3d(0.1, -0.1, 0.05)));
+}
+
+TEST_CASE("Check FilterBank", "[FilterBank]") {
+  FilterBank bank;
+  std::size_t offset{0};
+  REQUIRE_FALSE(bank.addFirstOrderLowPass(2, 1.0, offset));
+
+  const double samplingTime = 0.01;
+  const double cutFrequency = 2.0;
+  REQUIRE(bank.initialize(samplingTime));
+  REQUIRE_FALSE(bank.addButterworthLowPass(2, 60.0, 2, offset));
+
+  std::size_t firstOrder{0}, butterworth{0}, biquad{0};
+  REQUIRE(bank.addFirstOrderLowPass(2, cutFrequency, firstOrder));
+  REQUIRE(bank.addButterworthLowPass(3, cutFrequency, 3, butterworth));
+  REQUIRE(bank.addBiquad(1, Eigen::Vector3d(2.0, 0.0, 0.0), Eigen::Vector3d(2.0, 0.0, 0.0), biquad));
+  REQUIRE(bank.getNumberOfChannels() == 6);
+  REQUIRE(butterworth == 2);
+  REQUIRE(biquad == 5);
+
+  // the reset initializes the filters at the steady state of the current input
+  const Eigen::VectorXd input = Eigen::VectorXd::LinSpaced(6, 1.0, 6.0);
+  bank.input(0, 6) = input;
+  bank.reset();
+  for (int i = 0; i < 10; i++)
+    bank.filter();
+  REQUIRE(bank.output(0, 6).isApprox(input));
+
+  // the delay of the first order filter is its time constant
+  REQUIRE(std::abs(bank.getGroupDelay(firstOrder) - 1 / (2 * M_PI * cutFrequency)) < 1e-9);
+  REQUIRE(bank.getGroupDelay(biquad) == 0);
+
+  // a sinusoid at ten times the cut frequency is attenuated by the order of the filter
+  bank.input(0, 6).setZero();
+  bank.reset();
+  double firstOrderPeak = 0, butterworthPeak = 0;
+  for (int i = 0; i < 200; i++)
+  {
+    bank.input(0, 6).setConstant(std::sin(2 * M_PI * 10 * cutFrequency * i * samplingTime));
+    bank.filter();
+    if (i >= 100)
+    {
+      firstOrderPeak = std::max(firstOrderPeak, bank.output(firstOrder, 2).cwiseAbs().maxCoeff());
+      butterworthPeak = std::max(butterworthPeak, bank.output(butterworth, 3).cwiseAbs().maxCoeff());
+    }
+  }
+  REQUIRE(firstOrderPeak < 0.15);
+  REQUIRE(butterworthPeak < 2e-3);
+  REQUIRE(bank.output(biquad, 1).isApprox(bank.input(biquad, 1)));
+
+  // the gain of the Butterworth filters at the cut frequency is 1 / sqrt(2). The amplitude of the
+  // output is computed on an integer number of periods of the steady state
+  FilterBank butterworthBank;
+  REQUIRE(butterworthBank.initialize(0.001));
+  std::size_t second{0}, third{0}, fourth{0};
+  REQUIRE(butterworthBank.addButterworthLowPass(1, 20.0, 2, second));
+  REQUIRE(butterworthBank.addButterworthLowPass(1, 20.0, 3, third));
+  REQUIRE(butterworthBank.addButterworthLowPass(1, 20.0, 4, fourth));
+  Eigen::Vector3d sinProjection = Eigen::Vector3d::Zero(), cosProjection = Eigen::Vector3d::Zero();
+  const int period = 50;
+  for (int i = 0; i < 100 * period; i++)
+  {
+    const double phase = 2 * M_PI * i / period;
+    butterworthBank.input(0, 3).setConstant(std::sin(phase));
+    butterworthBank.filter();
+    if (i >= 80 * period)
+    {
+      sinProjection += butterworthBank.output(0, 3) * std::sin(phase);
+      cosProjection += butterworthBank.output(0, 3) * std::cos(phase);
+    }
+  }
+  const Eigen::Vector3d gain = 2.0 / (20 * period) * (sinProjection.cwiseAbs2() + cosProjection.cwiseAbs2()).cwiseSqrt();
+  REQUIRE((gain.array() - 1 / std::sqrt(2.0)).abs().maxCoeff() < 1e-3);
+}
+
+TEST_CASE("Check VelocityEstimator", "[VelocityEstimator]") {
+  VelocityEstimator estimator;
+  REQUIRE_FALSE(estimator.initializeAdaptiveWindow(2, 0, 0.01));
+  REQUIRE_FALSE(estimator.initializeKalman(2, 1.0, 0.0));
+
+  const double samplingTime = 0.01;
+  const Eigen::Vector2d velocity(1.0, -2.0);
+  const Eigen::Vector2d initialPosition(0.5, 0.0);
+
+  // the ramp fits the whole window, the latency is half of the window
+  const int window = 10;
+  REQUIRE(estimator.initializeAdaptiveWindow(2, window, 1e-3));
+  estimator.reset(initialPosition, Eigen::Vector2d::Zero());
+  for (int i = 1; i <= 2 * window; i++)
+  {
+    const double time = i * samplingTime;
+    estimator.update(initialPosition + velocity * time, Eigen::Vector2d::Constant(time));
+  }
+  REQUIRE(estimator.get().isApprox(velocity));
+  REQUIRE(estimator.getLatency().isApprox(Eigen::Vector2d::Constant(window * samplingTime / 2)));
+
+  // a step shrinks the window to the samples after it
+  double time = 2 * window * samplingTime;
+  Eigen::Vector2d position = initialPosition + velocity * time + Eigen::Vector2d(0.1, 0.0);
+  for (int i = 1; i <= 3; i++)
+  {
+    time += samplingTime;
+    position += velocity * samplingTime;
+    estimator.update(position, Eigen::Vector2d::Constant(time));
+  }
+  REQUIRE(estimator.get().isApprox(velocity));
+  REQUIRE(std::abs(estimator.getLatency()(0) - samplingTime) < 1e-9);
+
+  // the repeated samples are not added to the window, also if only some channels advance
+  const Eigen::Vector2d estimate = estimator.get();
+  const Eigen::Vector2d latency = estimator.getLatency();
+  for (int i = 0; i < 2 * window; i++)
+    estimator.update(position, Eigen::Vector2d::Constant(time));
+  REQUIRE(estimator.get() == estimate);
+  REQUIRE(estimator.getLatency() == latency);
+  Eigen::Vector2d timestamps = Eigen::Vector2d::Constant(time);
+  for (int i = 0; i < 2 * window; i++)
+  {
+    timestamps(1) += samplingTime;
+    position(1) += velocity(1) * samplingTime;
+    estimator.update(position, timestamps);
+  }
+  REQUIRE(estimator.get()(0) == estimate(0));
+  REQUIRE(estimator.getLatency()(0) == latency(0));
+  REQUIRE(estimator.get().isApprox(velocity));
+  timestamps(0) += samplingTime;
+  position(0) += velocity(0) * samplingTime;
+  estimator.update(position, timestamps);
+  REQUIRE(estimator.get().isApprox(velocity));
+  REQUIRE(std::abs(estimator.getLatency()(0) - 1.5 * samplingTime) < 1e-9);
+
+  // the Kalman filter converges to the velocity of the ramp, a repeated sample is ignored
+  REQUIRE(estimator.initializeKalman(2, 1.0, 1e-3));
+  estimator.reset(initialPosition, Eigen::Vector2d::Zero());
+  for (int i = 1; i <= 500; i++)
+  {
+    time = i * samplingTime;
+    estimator.update(initialPosition + velocity * time, Eigen::Vector2d::Constant(time));
+  }
+  REQUIRE((estimator.get() - velocity).norm() < 1e-3);
+  REQUIRE((estimator.getLatency().array() > 0).all());
+
+  const Eigen::Vector2d kalmanEstimate = estimator.get();
+  estimator.update(Eigen::Vector2d::Zero(), Eigen::Vector2d::Constant(time));
+  REQUIRE(estimator.get() == kalmanEstimate);
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <cstdio>
+#include <vector>
+
+#include <WalkingControllers/WalkingLogger/FlightRecorder.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace WalkingControllers;
+
+TEST_CASE("Check FlightRecorder", "[FlightRecorder]") {
+  const std::string fileName = "FlightRecorderTest.wcfr";
+
+  std::vector<LoggedChannel> channels(2);
+  channels[0].name = "dcm::position::measured";
+  channels[0].metadata = {"x", "y"};
+  channels[0].offset = 1;
+  channels[0].size = 2;
+  channels[1].name = "root_link::orientation::measured";
+  channels[1].metadata = {"roll", "pitch", "yaw"};
+  channels[1].type = LoggedChannelType::Rotation;
+  channels[1].offset = 3;
+  channels[1].size = 9;
+  constexpr size_t recordSize = 12;
+
+  // the chunks contain only a few records, so the file grows several times
+  constexpr size_t numberOfRecords = 1000;
+  {
+    FlightRecorder recorder;
+    REQUIRE(recorder.open(fileName, channels, recordSize, 7));
+
+    std::vector<double> record(recordSize);
+    for (size_t i = 0; i < numberOfRecords; i++) {
+      for (size_t j = 0; j < recordSize; j++)
+        record[j] = i * recordSize + j;
+      REQUIRE(recorder.write(record.data()));
+    }
+    REQUIRE(recorder.getNumberOfRecords() == numberOfRecords);
+
+    // the file is read while the recorder is still open (e.g. after a crash)
+    FlightRecorderReader reader;
+    REQUIRE(reader.open(fileName));
+    REQUIRE(reader.getNumberOfRecords() == numberOfRecords);
+  }
+
+  FlightRecorderReader reader;
+  REQUIRE(reader.open(fileName));
+  REQUIRE(reader.getRecordSize() == recordSize);
+  REQUIRE(reader.getNumberOfRecords() == numberOfRecords);
+  REQUIRE(reader.getChannels().size() == 2);
+  REQUIRE(reader.getChannels()[0].name == channels[0].name);
+  REQUIRE(reader.getChannels()[0].metadata == channels[0].metadata);
+  REQUIRE(reader.getChannels()[1].type == LoggedChannelType::Rotation);
+  REQUIRE(reader.getChannels()[1].offset == 3);
+  REQUIRE(reader.getChannels()[1].size == 9);
+
+  bool dataMatch = true;
+  for (size_t i = 0; i < numberOfRecords; i++) {
+    const double* record = reader.getRecord(i);
+    for (size_t j = 0; j < recordSize; j++)
+      dataMatch = dataMatch && record[j] == i * recordSize + j;
+  }
+  REQUIRE(dataMatch);
+  REQUIRE(reader.getRecord(numberOfRecords) == nullptr);
+
+  reader.close();
+  std::remove(fileName.c_str());
+
+  REQUIRE_FALSE(reader.open(fileName));
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// std
+#include <string>
+#include <vector>
+
+// Eigen
+#include <Eigen/Dense>
+
+// iDynTree
+#include <iDynTree/EigenHelpers.h>
+#include <iDynTree/KinDynComputations.h>
+#include <iDynTree/Model.h>
+
+#include <WalkingControllers/WholeBodyControllers/LegIK.h>
+#include <catch2/catch_test_macros.hpp>
+
+#include "LegsModel.h"
+
+using namespace WalkingControllers;
+
+TEST_CASE("Check LegIK", "[LegIK]") {
+  std::vector<std::string> joints;
+  const iDynTree::Model model = legsModel(joints);
+  const std::vector<std::string> rightLeg(joints.begin() + 6, joints.end());
+
+  LegIK solver;
+  REQUIRE(solver.initialize(model, "pelvis", "r_sole", rightLeg));
+
+  // the left leg does not end in a foot attached to the pelvis
+  LegIK wrongSolver;
+  REQUIRE_FALSE(wrongSolver.initialize(model, "pelvis", "r_sole", std::vector<std::string>(joints.begin(), joints.begin() + 6)));
+
+  Eigen::VectorXd target(6);
+  target << 0.1, 0.05, -0.3, 0.6, -0.3, -0.05;
+
+  iDynTree::KinDynComputations kinDyn;
+  REQUIRE(kinDyn.loadRobotModel(model));
+  iDynTree::VectorDynSize positions(model.getNrOfDOFs());
+  positions.zero();
+  iDynTree::toEigen(positions).tail(6) = target;
+  iDynTree::VectorDynSize zero(model.getNrOfDOFs());
+  zero.zero();
+  iDynTree::Vector3 gravity;
+  gravity.zero();
+  REQUIRE(kinDyn.setRobotState(iDynTree::Transform::Identity(), positions, iDynTree::Twist::Zero(), zero, gravity));
+  const iDynTree::Transform pelvisToFoot = kinDyn.getRelativeTransform("pelvis", "r_sole");
+
+  // the forward kinematics of the solver is the one of the model
+  const iDynTree::Transform forwardKinematics = solver.forwardKinematics(target);
+  REQUIRE((iDynTree::toEigen(forwardKinematics.getPosition())
+           - iDynTree::toEigen(pelvisToFoot.getPosition())).norm() < 1e-9);
+  REQUIRE((iDynTree::toEigen(forwardKinematics.getRotation())
+           - iDynTree::toEigen(pelvisToFoot.getRotation())).norm() < 1e-9);
+
+  // the solution closest to the reference is the configuration that generated the target
+  Eigen::VectorXd reference = target + Eigen::VectorXd::Constant(6, 0.05);
+  Eigen::VectorXd solution(6);
+  REQUIRE(solver.solve(pelvisToFoot, reference, solution));
+  REQUIRE((solution - target).norm() < 1e-6);
+
+  // a foot out of reach is rejected
+  const iDynTree::Transform farFoot(iDynTree::Rotation::Identity(), iDynTree::Position(0.0, -0.07, -1.0));
+  REQUIRE_FALSE(solver.solve(farFoot, reference, solution));
+}
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WALKING_CONTROLLERS_TESTS_LEGS_MODEL_H
+#define WALKING_CONTROLLERS_TESTS_LEGS_MODEL_H
+
+// std
+#include <string>
+#include <vector>
+
+// iDynTree
+#include <iDynTree/Model.h>
+#include <iDynTree/RevoluteJoint.h>
+
+namespace
+{
+    /**
+     * Two legs with six joints each, the left foot is the root of the model.
+     */
+    iDynTree::Model legsModel(std::vector<std::string>& joints)
+    {
+        struct JointDescription
+        {
+            std::string name;
+            std::string parent;
+            std::string child;
+            iDynTree::Position offset;
+            iDynTree::Direction axis;
+        };
+
+        const iDynTree::Direction x(1, 0, 0), y(0, 1, 0), z(0, 0, 1);
+        const std::vector<JointDescription> description{
+            {"l_ankle_roll", "l_foot", "l_ankle", iDynTree::Position(0, 0, 0.05), x},
+            {"l_ankle_pitch", "l_ankle", "l_shank", iDynTree::Position::Zero(), y},
+            {"l_knee", "l_shank", "l_thigh", iDynTree::Position(0, 0, 0.4), y},
+            {"l_hip_pitch", "l_thigh", "l_hip_1", iDynTree::Position(0, 0, 0.4), y},
+            {"l_hip_roll", "l_hip_1", "l_hip_2", iDynTree::Position::Zero(), x},
+            {"l_hip_yaw", "l_hip_2", "pelvis", iDynTree::Position(0, -0.07, 0), z},
+            {"r_hip_yaw", "pelvis", "r_hip_2", iDynTree::Position(0, -0.07, 0), z},
+            {"r_hip_roll", "r_hip_2", "r_hip_1", iDynTree::Position::Zero(), x},
+            {"r_hip_pitch", "r_hip_1", "r_thigh", iDynTree::Position::Zero(), y},
+            {"r_knee", "r_thigh", "r_shank", iDynTree::Position(0, 0, -0.4), y},
+            {"r_ankle_pitch", "r_shank", "r_ankle", iDynTree::Position(0, 0, -0.4), y},
+            {"r_ankle_roll", "r_ankle", "r_foot", iDynTree::Position::Zero(), x}};
+
+        iDynTree::Model model;
+        iDynTree::Link link;
+        link.setInertia(iDynTree::SpatialInertia(1.0, iDynTree::Position::Zero(),
+                                                 iDynTree::RotationalInertiaRaw::Zero()));
+        model.addLink("l_foot", link);
+
+        joints.clear();
+        for (const auto& joint : description)
+        {
+            const iDynTree::LinkIndex child = model.addLink(joint.child, link);
+            iDynTree::RevoluteJoint revoluteJoint(model.getLinkIndex(joint.parent), child,
+                                                  iDynTree::Transform(iDynTree::Rotation::Identity(), joint.offset),
+                                                  iDynTree::Axis(joint.axis, iDynTree::Position::Zero()));
+            revoluteJoint.enablePosLimits(true);
+            revoluteJoint.setPosLimits(0, -1.5, 1.5);
+            model.addJoint(joint.name, &revoluteJoint);
+            joints.push_back(joint.name);
+        }
+
+        model.addAdditionalFrameToLink("l_foot", "l_sole", iDynTree::Transform::Identity());
+        model.addAdditionalFrameToLink("r_foot", "r_sole",
+                                       iDynTree::Transform(iDynTree::Rotation::Identity(),
+                                                           iDynTree::Position(0, 0, -0.05)));
+        return model;
+    }
+}
+
+#endif
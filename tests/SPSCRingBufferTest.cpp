@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <thread>
+
+#include <WalkingControllers/StdUtilities/SPSCRingBuffer.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace WalkingControllers::StdUtilities;
+
+TEST_CASE("Check SPSCRingBuffer", "[SPSCRingBuffer]") {
+  SPSCRingBuffer<double> ring;
+  REQUIRE_FALSE(ring.initialize(0, 3));
+  REQUIRE(ring.initialize(4, 3));
+  REQUIRE(ring.front() == nullptr);
+
+  // fill the buffer
+  for (int i = 0; i < 4; i++) {
+    double* record = ring.acquire();
+    REQUIRE(record != nullptr);
+    record[0] = i;
+    record[2] = -i;
+    ring.commit();
+  }
+  REQUIRE(ring.size() == 4);
+  REQUIRE(ring.acquire() == nullptr);
+
+  ring.pop();
+  REQUIRE(ring.acquire() != nullptr);
+  REQUIRE(ring.front()[0] == 1);
+  REQUIRE(ring.front()[2] == -1);
+
+  // a producer and a consumer running concurrently
+  REQUIRE(ring.initialize(8, 2));
+  constexpr int numberOfRecords = 10000;
+  std::thread producer([&] {
+    for (int i = 0; i < numberOfRecords; i++) {
+      double* record;
+      while ((record = ring.acquire()) == nullptr)
+        std::this_thread::yield();
+      record[0] = i;
+      record[1] = 2 * i;
+      ring.commit();
+    }
+  });
+
+  bool ordered = true;
+  for (int i = 0; i < numberOfRecords; i++) {
+    const double* record;
+    while ((record = ring.front()) == nullptr)
+      std::this_thread::yield();
+    ordered = ordered && record[0] == i && record[1] == 2 * i;
+    ring.pop();
+  }
+  producer.join();
+
+  REQUIRE(ordered);
+  REQUIRE(ring.size() == 0);
+}
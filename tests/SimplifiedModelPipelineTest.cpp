@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <cmath>
+
+#include <yarp/os/Property.h>
+
+#include <iDynTree/EigenHelpers.h>
+
+#include <WalkingControllers/SimplifiedModelControllers/DCMReactiveController.h>
+#include <WalkingControllers/SimplifiedModelControllers/SimplifiedModelPipeline.h>
+#include <WalkingControllers/SimplifiedModelControllers/ZMPController.h>
+#include <WalkingControllers/TrajectoryPlanner/StableDCMModel.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace WalkingControllers;
+
+TEST_CASE("Check SimplifiedModelPipeline", "[SimplifiedModelPipeline]") {
+  yarp::os::Property dcmConfig;
+  dcmConfig.put("kDCM", 1.5);
+  dcmConfig.put("com_height", 0.53);
+  dcmConfig.put("sampling_time", 0.01);
+
+  yarp::os::Property zmpConfig;
+  zmpConfig.put("kCoM_walking", 6.0);
+  zmpConfig.put("kZMP_walking", 1.0);
+  zmpConfig.put("kCoM_stance", 4.0);
+  zmpConfig.put("kZMP_stance", 0.5);
+  zmpConfig.put("useGainScheduling", true);
+  zmpConfig.put("smoothingTime", 0.5);
+  zmpConfig.put("com_height", 0.53);
+  zmpConfig.put("sampling_time", 0.01);
+
+  WalkingDCMReactiveController dcmController;
+  WalkingZMPController zmpController;
+  StableDCMModel lipm;
+  REQUIRE(dcmController.initialize(dcmConfig));
+  REQUIRE(zmpController.initialize(zmpConfig));
+  REQUIRE(lipm.initialize(dcmConfig));
+
+  SimplifiedModel::SimplifiedModelPipeline<> pipeline;
+  REQUIRE(pipeline.initialize(dcmConfig, zmpConfig));
+
+  iDynTree::Vector2 initialCoM;
+  initialCoM(0) = 0.01;
+  initialCoM(1) = -0.02;
+  REQUIRE(zmpController.reset(initialCoM));
+  REQUIRE(lipm.reset(initialCoM));
+  pipeline.reset(iDynTree::toEigen(initialCoM));
+
+  for (int i = 0; i < 200; i++) {
+    const double t = i * 0.01;
+    const bool isStancePhase = (i / 50) % 2 == 0;
+
+    iDynTree::Vector2 dcmDesired, dcmVelocityDesired, dcmFeedback, zmpFeedback;
+    dcmDesired(0) = 0.05 * t;
+    dcmDesired(1) = 0.03 * std::sin(t);
+    dcmVelocityDesired(0) = 0.05;
+    dcmVelocityDesired(1) = 0.03 * std::cos(t);
+    dcmFeedback(0) = dcmDesired(0) + 0.002;
+    dcmFeedback(1) = dcmDesired(1) - 0.001;
+    zmpFeedback(0) = 0.04 * t;
+    zmpFeedback(1) = 0.01;
+    iDynTree::Position comFeedback(0.045 * t, 0.02 * std::sin(t), 0.53);
+
+    lipm.setInput(dcmDesired);
+    REQUIRE(lipm.integrateModel());
+    dcmController.setFeedback(dcmFeedback);
+    dcmController.setReferenceSignal(dcmDesired, dcmVelocityDesired);
+    REQUIRE(dcmController.evaluateControl());
+    zmpController.setPhase(isStancePhase);
+    zmpController.setFeedback(zmpFeedback, comFeedback);
+    zmpController.setReferenceSignal(dcmController.getControllerOutput(),
+                                     lipm.getCoMPosition(), lipm.getCoMVelocity());
+    REQUIRE(zmpController.evaluateControl());
+
+    iDynTree::Vector2 comPosition, comVelocity;
+    REQUIRE(zmpController.getControllerOutput(comPosition, comVelocity));
+
+    pipeline.advance(iDynTree::toEigen(dcmDesired), iDynTree::toEigen(dcmVelocityDesired),
+                     iDynTree::toEigen(dcmFeedback), iDynTree::toEigen(zmpFeedback),
+                     iDynTree::toEigen(comFeedback), isStancePhase);
+
+    REQUIRE((pipeline.getDesiredZMP() - iDynTree::toEigen(dcmController.getControllerOutput())).norm() < 1e-10);
+    REQUIRE((pipeline.getLIPMCoMPosition() - iDynTree::toEigen(lipm.getCoMPosition())).norm() < 1e-10);
+    REQUIRE((pipeline.getDesiredCoMPosition() - iDynTree::toEigen(comPosition)).norm() < 1e-10);
+    REQUIRE((pipeline.getDesiredCoMVelocity() - iDynTree::toEigen(comVelocity)).norm() < 1e-10);
+  }
+}
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <chrono>
+#include <cmath>
+
+#include <WalkingControllers/StdUtilities/StageProfiler.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace WalkingControllers::StdUtilities;
+
+TEST_CASE("Check StageProfiler", "[StageProfiler]") {
+  StageProfiler profiler;
+  const size_t fast = profiler.addStage("fast");
+  const size_t slow = profiler.addStage("slow");
+  REQUIRE(profiler.numberOfStages() == 2);
+
+  // 1000 samples from 1us to 1ms
+  for (int i = 1; i <= 1000; i++) {
+    profiler.addSample(fast, std::chrono::microseconds(i));
+  }
+  profiler.addSample(slow, std::chrono::milliseconds(5));
+
+  StageProfiler::Statistics statistics = profiler.getStatistics(fast);
+  REQUIRE(statistics.name == "fast");
+  REQUIRE(statistics.count == 1000);
+  REQUIRE(std::abs(statistics.mean - 500.5e-6) < 1e-9);
+  REQUIRE(statistics.max == 1e-3);
+
+  // the relative error of the histogram is lower than 1 / 64
+  REQUIRE(std::abs(statistics.p50 - 500e-6) < 500e-6 / 64);
+  REQUIRE(std::abs(statistics.p99 - 990e-6) < 990e-6 / 64);
+  REQUIRE(std::abs(statistics.p999 - 999e-6) < 999e-6 / 64);
+
+  statistics = profiler.getStatistics(slow);
+  REQUIRE(statistics.count == 1);
+  REQUIRE(std::abs(statistics.p50 - 5e-3) < 5e-3 / 64);
+
+  // the timer adds a sample when it is destroyed or stopped
+  {
+    auto timer = profiler.scopedTimer(slow);
+    timer.stop();
+  }
+  REQUIRE(profiler.getStatistics(slow).count == 2);
+
+  profiler.reset();
+  REQUIRE(profiler.getStatistics(fast).count == 0);
+  REQUIRE(profiler.getStatistics(fast).max == 0);
+}
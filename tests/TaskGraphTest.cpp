@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <atomic>
+
+#include <WalkingControllers/StdUtilities/TaskGraph.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace WalkingControllers::StdUtilities;
+
+TEST_CASE("Check TaskGraph", "[TaskGraph]") {
+  for (size_t workers : {0, 2}) {
+    TaskGraph graph;
+    std::atomic<int> first{0}, second{0};
+    std::atomic<bool> dependenciesCompleted{false};
+
+    REQUIRE(graph.addTask("first", [&] { first++; return true; }));
+    REQUIRE(graph.addTask("second", [&] { second++; return true; }));
+    REQUIRE(graph.addTask("third", [&] {
+      dependenciesCompleted = first == second;
+      return true;
+    }, {"first", "second"}));
+    REQUIRE_FALSE(graph.addTask("fourth", [] { return true; }, {"missing"}));
+    REQUIRE(graph.initialize(workers));
+
+    for (int i = 1; i <= 100; i++) {
+      dependenciesCompleted = false;
+      REQUIRE(graph.run());
+      REQUIRE(first == i);
+      REQUIRE(second == i);
+      REQUIRE(dependenciesCompleted);
+    }
+  }
+
+  TaskGraph failingGraph;
+  REQUIRE(failingGraph.addTask("failing", [] { return false; }));
+  REQUIRE(failingGraph.initialize(1));
+  REQUIRE_FALSE(failingGraph.run());
+}
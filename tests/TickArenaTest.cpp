@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Fondazione Istituto Italiano di Tecnologia (IIT)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <WalkingControllers/StdUtilities/TickArena.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace WalkingControllers::StdUtilities;
+
+TEST_CASE("Check TickArena", "[TickArena]") {
+  TickArena arena(1024);
+  REQUIRE(arena.getCapacity() == 1024);
+
+  // the arrays are value initialized and aligned
+  double* doubles = arena.allocateArray<double>(10);
+  for (int i = 0; i < 10; i++) {
+    REQUIRE(doubles[i] == 0.0);
+  }
+  char* chars = arena.allocateArray<char>(3);
+  std::int64_t* integers = arena.allocateArray<std::int64_t>(4);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(integers) % alignof(std::int64_t) == 0);
+  REQUIRE(chars + 3 <= reinterpret_cast<char*>(integers));
+  REQUIRE(arena.getUsedBytes() == 10 * sizeof(double) + 3 + 4 * sizeof(std::int64_t));
+  REQUIRE(arena.getOverflows() == 0);
+
+  // the memory is reused after a reset
+  arena.reset();
+  REQUIRE(arena.getUsedBytes() == 0);
+  REQUIRE(arena.allocateArray<double>(10) == doubles);
+
+  // the std::pmr containers can use the arena, the allocations exceeding the capacity are
+  // taken from the heap
+  {
+    std::pmr::vector<double> vector(&arena);
+    vector.resize(100);
+    vector.resize(200);
+    REQUIRE(arena.getOverflows() == 1);
+    vector.back() = 1.0;
+  }
+  REQUIRE(arena.getPeakBytes() >= 10 * sizeof(double) + 300 * sizeof(double));
+
+  arena.reset();
+  REQUIRE(arena.getUsedBytes() == 0);
+  arena.resetStatistics();
+  REQUIRE(arena.getPeakBytes() == 0);
+  REQUIRE(arena.getOverflows() == 0);
+
+  // aligned allocations in the heap
+  TickArena empty;
+  void* aligned = empty.allocate(8, 64);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+  REQUIRE(empty.getOverflows() == 1);
+}